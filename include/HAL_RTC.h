@@ -51,6 +51,11 @@ extern void HAL_RTC_Initialize(void);
  */
 extern void HAL_RTC_Wakeup(void);
 
+/** \brief Returns RTC time in ticks of HAL_RTC_XTAL_FREQ.
+ *
+ * Interrupt mask of the caller is preserved, so time can be also read inside
+ * of a critical section.
+ */
 extern uint32_t HAL_RTC_GetTime(void * hint);
 
 extern void HAL_RTC_SetAlarmS(uint32_t sec);
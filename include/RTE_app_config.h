@@ -47,6 +47,84 @@
 #define RTE_APP_BTN_CHECK_TIMEOUT  1500
 #endif
 
+// <o> Application Timer Slack [ms] <0-10000>
+// <i> How late advertising, button check and report timers may expire so
+// <i> that their deadlines share a single RTC wake up. 0 - exact deadlines.
+// <i> Default: 100 ms
+#ifndef RTE_APP_TIMER_SLACK
+#define RTE_APP_TIMER_SLACK  100
+#endif
+
+// <e> Adaptive Advertising
+// <i> Advertise with short interval right after disconnect or button wake up
+// <i> and slow down in steps until BLE Advertising Interval is reached.
+// <i> Default: Enabled
+#ifndef RTE_APP_ADV_ADAPTIVE_ENABLED
+#define RTE_APP_ADV_ADAPTIVE_ENABLED  1
+#endif
+
+// <o> Fast Phase Minimum Interval [ms] <20-10240>
+// <i> Default: 20 ms
+#ifndef RTE_APP_ADV_FAST_INT_MIN
+#define RTE_APP_ADV_FAST_INT_MIN  20
+#endif
+
+// <o> Fast Phase Maximum Interval [ms] <20-10240>
+// <i> Default: 40 ms
+#ifndef RTE_APP_ADV_FAST_INT_MAX
+#define RTE_APP_ADV_FAST_INT_MAX  40
+#endif
+
+// <o> Fast Phase Duration [s] <1-1000>
+// <i> Default: 5 s
+#ifndef RTE_APP_ADV_FAST_DURATION
+#define RTE_APP_ADV_FAST_DURATION  5
+#endif
+
+// <o> Medium Phase Interval [ms] <20-10240>
+// <i> Default: 320 ms
+#ifndef RTE_APP_ADV_MEDIUM_INT
+#define RTE_APP_ADV_MEDIUM_INT  320
+#endif
+
+// <o> Medium Phase Duration [s] <1-1000>
+// <i> Slow phase with BLE Advertising Interval follows until Advertising
+// <i> Stop Timeout elapses.
+// <i> Default: 15 s
+#ifndef RTE_APP_ADV_MEDIUM_DURATION
+#define RTE_APP_ADV_MEDIUM_DURATION  15
+#endif
+
+// </e>
+
+// <e> Bonding
+// <i> Bond with central device so it can reconnect without discovery.
+// <i> Default: Enabled
+#ifndef RTE_APP_BLE_BOND_ENABLED
+#define RTE_APP_BLE_BOND_ENABLED  1
+#endif
+
+// <o> Reconnect Advertising
+// <i> Advertising used after bonded device disconnects.
+// <i> Whitelist mode accepts only bonded device during fast advertising phase.
+// <i> Default: Directed
+// <0=> None
+// <1=> Directed
+// <2=> Whitelist
+#ifndef RTE_APP_BLE_RECONNECT_MODE
+#define RTE_APP_BLE_RECONNECT_MODE  1
+#endif
+
+// <q> Auto-resume Streams
+// <i> Restart streams that were active on disconnect once bonded device
+// <i> reconnects and encrypts the link.
+// <i> Default: Enabled
+#ifndef RTE_APP_BLE_AUTO_RESUME_ENABLED
+#define RTE_APP_BLE_AUTO_RESUME_ENABLED  1
+#endif
+
+// </e>
+
 // <o> I2C Bus Speed
 // <i> Default: Fast+
 // <0=> Standard
@@ -56,6 +134,69 @@
 #define RTE_APP_I2C_BUS_SPEED  2
 #endif
 
+// <h> Energy Model
+// <i> Currents of the whole board used to estimate average current from
+// <i> residency in power states. Measure them on the target board.
+
+// <o> Run current [uA] <0-100000>
+// <i> Core running from flash with peripherals of active streams.
+// <i> Default: 1100
+#ifndef RTE_APP_ENERGY_RUN_CURRENT
+#define RTE_APP_ENERGY_RUN_CURRENT  1100
+#endif
+
+// <o> Wait for interrupt current [uA] <0-100000>
+// <i> Default: 600
+#ifndef RTE_APP_ENERGY_WFI_CURRENT
+#define RTE_APP_ENERGY_WFI_CURRENT  600
+#endif
+
+// <o> Deep sleep current [uA] <0-100000>
+// <i> Default: 3
+#ifndef RTE_APP_ENERGY_SLEEP_CURRENT
+#define RTE_APP_ENERGY_SLEEP_CURRENT  3
+#endif
+
+// <o> Wake-up charge [nC] <0-1000000>
+// <i> Charge of every wake up from deep sleep not covered by the run
+// <i> current, i.e. wake-up delay, state restore and radio event.
+// <i> Default: 2000
+#ifndef RTE_APP_ENERGY_WAKEUP_CHARGE
+#define RTE_APP_ENERGY_WAKEUP_CHARGE  2000
+#endif
+
+// </h>
+
+// <h> Main Loop Budgets
+// <i> Longest expected run of main loop tasks. Tasks are not interrupted,
+// <i> longer runs are counted and logged.
+
+// <o> Audio providers [us] <100-100000>
+// <i> Default: 500
+#ifndef RTE_APP_SCHED_AUDIO_BUDGET
+#define RTE_APP_SCHED_AUDIO_BUDGET  500
+#endif
+
+// <o> BLE kernel [us] <100-100000>
+// <i> Default: 2000
+#ifndef RTE_APP_SCHED_BLE_BUDGET
+#define RTE_APP_SCHED_BLE_BUDGET  2000
+#endif
+
+// <o> Application control [us] <100-100000>
+// <i> Default: 1000
+#ifndef RTE_APP_SCHED_CONTROL_BUDGET
+#define RTE_APP_SCHED_CONTROL_BUDGET  1000
+#endif
+
+// <o> Log flush [us] <100-100000>
+// <i> Default: 1000
+#ifndef RTE_APP_SCHED_LOG_BUDGET
+#define RTE_APP_SCHED_LOG_BUDGET  1000
+#endif
+
+// </h>
+
 // <h> CESLA Custom Service
 
 
@@ -115,6 +256,62 @@
 
 // </e>
 
+// <e> LE Credit Based Channel Transport (LECB)
+// <i> Send stream data over L2CAP LE credit based channel once it is opened
+// <i> by central device. CCS characteristics are used otherwise.
+// <i> Default: Disabled
+#ifndef RTE_APP_CCS_LECB_ENABLED
+#define RTE_APP_CCS_LECB_ENABLED  0
+#endif
+
+// <o> LE_PSM <0x80-0xFF>
+// <i> LE Protocol/Service Multiplexer on which the channel is accepted.
+// <i> Default: 0x81
+#ifndef RTE_APP_CCS_LECB_PSM
+#define RTE_APP_CCS_LECB_PSM  0x81
+#endif
+
+// </e>
+
+// <o> Cycle profile report interval (s) <0-3600>
+// <i> Period of printing BDK_Prof statistics to the trace output when
+// <i> RTE_BDK_PROF_ENABLED is set. 0 - only on request.
+// <i> Default: 10
+#ifndef RTE_APP_DIAG_PROF_REPORT_INTERVAL
+#define RTE_APP_DIAG_PROF_REPORT_INTERVAL  10
+#endif
+
+// <e> RTT Raw Stream Capture
+// <i> Copy stream packets of all providers to SEGGER RTT up channel for
+// <i> lab recording with tools/rtt_wav_capture.py.
+// <i> Default: Disabled
+#ifndef RTE_APP_CCS_RTT_ENABLED
+#define RTE_APP_CCS_RTT_ENABLED  0
+#endif
+
+// <q> RTT only
+// <i> Do not send stream packets over BLE so that capture is not limited by
+// <i> radio throughput.
+// <i> Default: Disabled
+#ifndef RTE_APP_CCS_RTT_ONLY
+#define RTE_APP_CCS_RTT_ONLY  0
+#endif
+
+// <o> RTT up channel <1-2>
+// <i> Channel 1 is used by tokenized log when it is sent over RTT.
+// <i> Default: 2
+#ifndef RTE_APP_CCS_RTT_CHANNEL
+#define RTE_APP_CCS_RTT_CHANNEL  2
+#endif
+
+// <o> RTT up channel buffer size in bytes <1024-16384>
+// <i> Default: 4096
+#ifndef RTE_APP_CCS_RTT_BUFFER_SIZE
+#define RTE_APP_CCS_RTT_BUFFER_SIZE  4096
+#endif
+
+// </e>
+
 // </h>
 
 
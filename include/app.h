@@ -25,6 +25,7 @@ extern "C"
 #include <HAL.h>
 #include <HAL_RTC.h>
 #include <BDK_Task.h>
+#include <BDK_Prof.h>
 #include <BSP_Components.h>
 #include <BLE_Components.h>
 #include <ccs/CS.h>
@@ -32,6 +33,11 @@ extern "C"
 
 #include "app_trace.h"
 #include "app_timer.h"
+#include "app_adv.h"
+#include "app_diag.h"
+#include "app_energy.h"
+#include "app_led.h"
+#include "app_sched.h"
 #include "app_ble_hooks.h"
 #include "app_sleep.h"
 
@@ -101,6 +107,9 @@ enum App_StateStruct
     APP_STATE_CONNECTED
 };
 
+/* Number of application states, not a state so that switches stay complete. */
+#define APP_STATE_NB                   (APP_STATE_CONNECTED + 1)
+
 extern enum App_StateStruct app_state;
 
 extern struct sleep_mode_env_tag sleep_mode_env;
@@ -114,6 +123,8 @@ extern void BLE_Initialize(void);
 
 extern void App_Env_Initialize(void);
 
+extern void App_StateMachine(void);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+#ifndef APP_ADV_H_
+#define APP_ADV_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/** \brief Advertising phases of one advertising session. */
+enum App_AdvPhase
+{
+    APP_ADV_PHASE_FAST = 0, /**< Short interval burst after wake up. */
+    APP_ADV_PHASE_MEDIUM, /**< Intermediate interval. */
+    APP_ADV_PHASE_SLOW, /**< RTE_APP_BLE_ADV_INT until advertising stops. */
+    APP_ADV_PHASE_NB
+};
+
+/** \brief Advertising session statistics used to tune the phase settings. */
+struct App_AdvStats
+{
+    /** \brief Number of started advertising sessions. */
+    uint32_t sessions;
+
+    /** \brief Number of sessions that ended with connection, per phase. */
+    uint32_t connections[APP_ADV_PHASE_NB];
+
+    /** \brief Time to connect of the last connected session in ms. */
+    uint32_t last_ttc_ms;
+
+    /** \brief Shortest time to connect in ms. */
+    uint32_t min_ttc_ms;
+
+    /** \brief Longest time to connect in ms. */
+    uint32_t max_ttc_ms;
+};
+
+/** \brief Initializes advertising phase timers. */
+extern void App_AdvInitialize(void);
+
+/** \brief Starts new advertising session with the fast phase. */
+extern void App_AdvStart(void);
+
+/** \brief Switches to the next phase once the current one has elapsed.
+ *
+ * Called from the main loop while advertising or connected. Advertising for
+ * remaining connection slot is stopped after RTE_APP_ADV_DISABLE_TIMEOUT.
+ */
+extern void App_AdvUpdate(void);
+
+/** \brief Stops advertising session that timed out without connection. */
+extern void App_AdvStop(void);
+
+/** \brief Ends advertising session and records its time to connect.
+ *
+ * Advertising for remaining connection slot continues with the slow phase
+ * until App_AdvUpdate stops it.
+ */
+extern void App_AdvConnected(void);
+
+/** \brief Restarts the remaining slot window after one of the connected
+ *         peers disconnected.
+ *
+ * Stack advertises the freed slot again, App_AdvUpdate stops it after
+ * RTE_APP_ADV_DISABLE_TIMEOUT like after App_AdvConnected.
+ */
+extern void App_AdvSlotReleased(void);
+
+extern const struct App_AdvStats * App_AdvGetStats(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ADV_H_ */
@@ -24,6 +24,10 @@ extern void App_PeerDeviceConnected(void);
 
 extern void App_PeerDeviceDisconnected(void);
 
+extern void App_PeerDeviceSlotReleased(void);
+
+extern void App_BondedPeerReconnected(void);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+#ifndef APP_DIAG_H_
+#define APP_DIAG_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/** \brief Version of counter page layouts, first byte of every page. */
+#define APP_DIAG_COUNTERS_VERSION      (2)
+
+/** \brief DIAG characteristic page with system and link counters.
+ *
+ *     [version][connections][uptime s][wdt refreshes][wakeups]
+ *     [sleep entries][sleep refused][sleep ms]
+ *     [log high water][log dropped][lecb pending max][lecb dropped]
+ *     [link 0] ... [link BDK_BLE_MASTER_MAX-1]
+ *
+ * Sleep entries count every deep sleep attempt including the ones refused by
+ * the BLE stack, sleep ms is total time spent in deep sleep.
+ * Version and connections are single bytes, log high water is number of
+ * 32-bit words as 16-bit value, lecb pending max is single byte and other
+ * counters are 32-bit values.
+ * Every link block is 15 bytes long and is all zero for free slots:
+ *
+ *     [interval][latency][sup_to][tx_phy][rx_phy][mtu][ccs pending max]
+ *     [ccs dropped]
+ *
+ * Interval, latency, timeout and MTU are 16-bit values, PHYs and pending max
+ * single bytes and dropped count is 32-bit value. All values are little
+ * endian.
+ */
+#define APP_DIAG_PAGE_SYSTEM           (0x00)
+
+/** \brief DIAG characteristic page with counters of audio streams.
+ *
+ *     [version][streams][stream 0] ... [stream n-1]
+ *
+ * Every stream block consists of provider ID byte followed by 32-bit
+ * counters:
+ *
+ *     [provider][samples][overruns][sent][dropped][failed]
+ *
+ * Samples are captured by the interrupt handler, overruns count buffer
+ * halves overwritten before the poll handler could send them.
+ */
+#define APP_DIAG_PAGE_STREAMS          (0x01)
+
+/** \brief DIAG characteristic page with energy accounting.
+ *
+ *     [version][app states][power states][average current nA]
+ *     [wakeups src 0] ... [wakeups src 7][wakeups avoided]
+ *     [state 0 run ms][state 0 wfi ms][state 0 sleep ms] ...
+ *
+ * Version and state counts are single bytes, other values 32-bit.
+ * Wake ups are counted per bit of WAKEUP_SRC_BYTE, wake ups avoided by timer
+ * slack are given by Timer_GetWakeupsAvoided. Residency is given for every
+ * App_StateStruct state and App_PowerState.
+ */
+#define APP_DIAG_PAGE_ENERGY           (0x02)
+
+/** \brief DIAG characteristic page with main loop task counters.
+ *
+ *     [version][tasks][task 0] ... [task n-1]
+ *
+ * Every task block holds 32-bit counters in App_SchedTask order:
+ *
+ *     [overruns][max ticks]
+ *
+ * Overruns count runs longer than the task budget, max ticks is the longest
+ * run in RTC ticks. Version and tasks are single bytes, all values are
+ * little endian.
+ */
+#define APP_DIAG_PAGE_SCHED            (0x03)
+
+/** \brief First DIAG characteristic page with cycle profile of a probe.
+ *
+ * Page APP_DIAG_PAGE_PROF + n contains statistics of BDK_Prof probe n:
+ *
+ *     [probe][bins][count][min][max][mean][hist 0] ... [hist bins-1]
+ *
+ * Probe and bins are single bytes, count, min, max and mean are 32-bit and
+ * histogram bins 16-bit saturated values, all little endian.
+ */
+#define APP_DIAG_PAGE_PROF             (0x10)
+
+/** \brief Registers DIAG characteristic handler. */
+extern void App_DiagInitialize(void);
+
+/** \brief Periodically prints cycle profile to the trace output.
+ *
+ * Called from the main loop. Does nothing unless RTE_BDK_PROF_ENABLED is set.
+ */
+extern void App_DiagUpdate(void);
+
+/** \brief Prints cycle profile of all probes to the trace output. */
+extern void App_DiagReportProfile(void);
+
+/** \brief Counts watchdog refresh done by the main loop. */
+extern void App_DiagWatchdogRefresh(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_DIAG_H_ */
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+#ifndef APP_ENERGY_H_
+#define APP_ENERGY_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/** \brief Number of wake-up sources, bits of WAKEUP_SRC_BYTE. */
+#define APP_ENERGY_WAKEUP_SRC_NB       (8)
+
+/** \brief Selects all application states in \ref App_EnergyGetResidency. */
+#define APP_ENERGY_ALL_STATES          (0xFF)
+
+/** \brief Power states of the main loop. */
+enum App_PowerState
+{
+    APP_POWER_RUN = 0, /**< Core is running */
+    APP_POWER_WFI, /**< Core waits for interrupt */
+    APP_POWER_SLEEP, /**< Deep sleep mode */
+    APP_POWER_STATE_NB
+};
+
+/** \brief Starts residency accounting.
+ *
+ * Must be called once RTC is running.
+ */
+extern void App_EnergyInitialize(void);
+
+/** \brief Marks transition of the main loop into given power state.
+ *
+ * Time since the previous transition is accounted to the previous power state
+ * and to the application state that was active at the previous transition.
+ * Can be called with interrupts masked.
+ */
+extern void App_EnergyEnter(enum App_PowerState state);
+
+/** \brief Returns to run state after deep sleep attempt was refused. */
+extern void App_EnergySleepRefused(void);
+
+/** \brief Ends deep sleep residency after wake up.
+ *
+ * \param wakeup_src
+ * Value of ACS_WAKEUP_STATE->WAKEUP_SRC_BYTE, every set bit is counted.
+ */
+extern void App_EnergyWakeUp(uint8_t wakeup_src);
+
+/** \brief Returns RTC ticks spent in power state.
+ *
+ * \param power
+ * Power state.
+ *
+ * \param state
+ * Application state or APP_ENERGY_ALL_STATES for sum of all states.
+ */
+extern uint64_t App_EnergyGetResidency(enum App_PowerState power,
+        uint8_t state);
+
+/** \brief Returns RTC ticks since power up. */
+extern uint64_t App_EnergyGetUptime(void);
+
+/** \brief Returns number of deep sleep entries, refused attempts are not
+ * counted. */
+extern uint32_t App_EnergyGetSleepEntries(void);
+
+/** \brief Returns number of deep sleep attempts refused by the BLE stack. */
+extern uint32_t App_EnergyGetSleepRefused(void);
+
+/** \brief Returns number of wake ups from deep sleep.
+ *
+ * \param source
+ * Bit of WAKEUP_SRC_BYTE or APP_ENERGY_WAKEUP_SRC_NB for all wake ups.
+ */
+extern uint32_t App_EnergyGetWakeups(uint8_t source);
+
+/** \brief Estimates average current since power up in nA.
+ *
+ * Residency of every power state is weighted by current configured in
+ * RTE_app_config.h and every wake up adds configured charge.
+ */
+extern uint32_t App_EnergyGetAverageCurrent(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ENERGY_H_ */
@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+#ifndef APP_LED_H_
+#define APP_LED_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <api/led_api.h>
+
+/** \brief Number of blink patterns that can wait for playback. */
+#define APP_LED_QUEUE_SIZE             (4)
+
+/** \brief Starts the LED pattern sequencer.
+ *
+ * Application timer and LED pads have to be initialized.
+ */
+extern void App_LedInitialize(void);
+
+/** \brief Queues blink pattern without blocking.
+ *
+ * Patterns are played one after another in the order they were queued. Every
+ * repetition turns the LED on for on_ms and then off for off_ms.
+ *
+ * Must not be called from interrupt handlers.
+ *
+ * \param led
+ * LED to blink.
+ *
+ * \param on_ms
+ * Time the LED is on in every repetition.
+ *
+ * \param off_ms
+ * Time the LED is off after every repetition.
+ *
+ * \param count
+ * Number of repetitions.
+ *
+ * \returns
+ * false if the queue is full and the pattern was dropped.
+ */
+extern bool App_LedBlink(LedName led, uint16_t on_ms, uint16_t off_ms,
+        uint8_t count);
+
+/** \brief Returns true while a pattern is playing or waiting. */
+extern bool App_LedIsBusy(void);
+
+/** \brief Advances playing pattern once its step elapses.
+ *
+ * Called from the main loop. Steps are timed by application timer, so the
+ * device can enter deep sleep in between.
+ */
+extern void App_LedUpdate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_LED_H_ */
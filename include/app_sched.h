@@ -0,0 +1,65 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+#ifndef APP_SCHED_H_
+#define APP_SCHED_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief Work of the main loop in order of priority. */
+enum App_SchedTask
+{
+    APP_SCHED_AUDIO = 0, /**< Stream providers signalled by interrupts */
+    APP_SCHED_BLE, /**< Event kernel and scheduled callbacks */
+    APP_SCHED_CONTROL, /**< State machine, LED and diagnostics */
+    APP_SCHED_LOG, /**< Log flush */
+    APP_SCHED_TASK_NB
+};
+
+/** \brief Executes one pass of main loop work.
+ *
+ * Every task runs once per pass in order of priority. Before each task the
+ * tasks of higher priority that have pending work run again, so audio is
+ * served between any two pieces of background work.
+ *
+ * Tasks are cooperative. A task running longer than its budget from
+ * RTE_app_config.h is not interrupted, the overrun is counted and reported
+ * on DIAG page APP_DIAG_PAGE_SCHED.
+ */
+extern void App_SchedRun(void);
+
+/** \brief Returns true if any task has pending work.
+ *
+ * Can be called with interrupts masked before entering sleep.
+ */
+extern bool App_SchedIsPending(void);
+
+/** \brief Returns number of runs of task that exceeded its budget. */
+extern uint32_t App_SchedGetOverruns(enum App_SchedTask task);
+
+/** \brief Returns longest run of task in RTC ticks. */
+extern uint32_t App_SchedGetMaxTicks(enum App_SchedTask task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_SCHED_H_ */
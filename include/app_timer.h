@@ -33,6 +33,31 @@ extern "C"
 /** \brief Number of nanoseconds elapsed per single RTC clock tick. */
 #define APP_TIMER_NS_PER_RTC_TICK      (1000000000U / HAL_RTC_XTAL_FREQ)
 
+/** \brief Time source of the application timer context.
+ *
+ * Application timers run from RTC. The time source can be replaced at build
+ * time by any \ref stimer_get_time_fn, e.g. by a simulated clock that jumps or
+ * wraps around at APP_TIMER_MAX_TICK_VALUE, to exercise the timer code without
+ * hardware. Wake up alarms are still programmed in RTC ticks.
+ */
+#ifndef APP_TIMER_GET_TIME
+#define APP_TIMER_GET_TIME             HAL_RTC_GetTime
+#endif
+
+/** \brief Maximum value returned by APP_TIMER_GET_TIME before it wraps. */
+#ifndef APP_TIMER_MAX_TICK_VALUE
+#define APP_TIMER_MAX_TICK_VALUE       HAL_RTC_MAX_TICK_VALUE
+#endif
+
+/** \brief Longest RTC alarm in ticks.
+ *
+ * Timer context has to read its time source at least 4 times per wrap around
+ * of APP_TIMER_MAX_TICK_VALUE, longer sleeps are split into several alarms.
+ */
+#define APP_TIMER_MAX_ALARM_TICKS                                            \
+        ((APP_TIMER_MAX_TICK_VALUE / 4 < HAL_RTC_RELOAD_VALUE) ?             \
+                APP_TIMER_MAX_TICK_VALUE / 4 : HAL_RTC_RELOAD_VALUE)
+
 /** If number of ticks remaining till next timer event is below this threshold
  * the \ref Timer_SetWakeupAtNextEvent will treat the timer as expired and
  * return APP_TIMER_ALARM_NOW.
@@ -46,6 +71,13 @@ extern void Timer_Initialize(void);
 
 extern void Timer_Wakeup(void);
 
+/** \brief Returns number of deep sleep wake ups saved by timer slack.
+ *
+ * Every RTC wake up that serves n timers thanks to their slack counts as
+ * n - 1 wake ups avoided.
+ */
+extern uint32_t Timer_GetWakeupsAvoided(void);
+
 static inline struct stimer_ctx * Timer_GetContext(void)
 {
     return &app_timer_ctx;
@@ -26,13 +26,30 @@ extern "C"
 
 #include <stdio.h>
 
+#include "RTE_BDK.h"
+
+#if RTE_BDK_LOG_TOKENIZED == 1
+#include "BDK_Log.h"
+
+#define TRACE_PRINTF(...) BDK_LOG_PRINTF(__VA_ARGS__)
+#define TRACE_FLUSH() BDK_LogFlush()
+#define TRACE_FLUSH_ALL() BDK_LogFlushAll()
+#define TRACE_IS_BUSY() BDK_LogIsBusy()
+#else
 #define TRACE_PRINTF(...) printf(__VA_ARGS__)
+#define TRACE_FLUSH()
+#define TRACE_FLUSH_ALL()
+#define TRACE_IS_BUSY() (false)
+#endif
 #define TRACE_VPRINTF(fmt, va_args) vprintf(fmt, va_args)
 
 #else
 
 #define TRACE_PRINTF(...)
 #define TRACE_VPRINTF(fmt, va_args)
+#define TRACE_FLUSH()
+#define TRACE_FLUSH_ALL()
+#define TRACE_IS_BUSY() (false)
 
 #endif
 
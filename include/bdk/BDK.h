@@ -80,6 +80,7 @@ __STATIC_INLINE void BDK_Initialize(void)
  * \code
  *     BDK_TaskStart();
  *     Kernel_Schedule();
+ *     BDK_TaskRunScheduled();
  *     Sys_Watchdog_Refresh();
  * \endcode
  */
@@ -95,6 +96,7 @@ extern void BDK_Schedule(void);
  * \code
  *     BDK_TaskStart();
  *     Kernel_Schedule();
+ *     BDK_TaskRunScheduled();
  * \endcode
  */
 extern void BDK_ScheduleNoWdt(void);
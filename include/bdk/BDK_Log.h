@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BDK_Log.h
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup LOG_GRP Tokenized Log
+//!
+//! \brief Low overhead logging of printf style messages.
+//!
+//! Format strings are never formatted nor transmitted by the firmware.
+//! Each format string literal is placed into dedicated \c bdk_log_fmt linker
+//! section and its offset in this section is used as 16-bit message ID.
+//! Logging a message only stores the ID and raw 32-bit arguments into a RAM
+//! ring buffer.
+//! This is safe to do from interrupt context.
+//!
+//! Ring buffer is drained by BDK_LogFlush from the main loop when the device
+//! is idle.
+//! Records are sent in binary form over SEGGER RTT up channel or UART as
+//! selected in RTE_BDK.h.
+//! UART output is not readable text, it has to be captured as raw bytes and
+//! decoded.
+//! Host tool \c tools/tlog_decode.py reads format strings from the firmware
+//! ELF file and prints the original messages.
+//!
+//! Record format (little endian 32-bit words):
+//! \code
+//! [0xA5][NARGS][ID (16 bit)] [ARG 0] ... [ARG NARGS-1]
+//! \endcode
+//!
+//! Restrictions:
+//! * Format must be a string literal.
+//! * Every argument is transferred as 32-bit word.
+//!   Floating point and 64-bit arguments are rejected at compile time, convert
+//!   them to 32-bit integers (e.g. ms instead of seconds) before logging.
+//!   \c %s arguments must point to constant strings located in the ELF file
+//!   (literals, __FUNCTION__, __FILE__).
+//! * At most BDK_LOG_MAX_ARGS arguments per message.
+//! * Requires GNU C dialect (-std=gnu99 or later) for argument counting with
+//!   \c ,\#\#__VA_ARGS__ and linker section attributes.
+//!
+//! \{
+//-----------------------------------------------------------------------------
+
+#ifndef BDK_LOG_H_
+#define BDK_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "RTE_BDK.h"
+
+#if defined(__STRICT_ANSI__)
+#error "BDK_Log requires GNU C extensions, compile with -std=gnu99 or later."
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** \brief Maximum number of arguments of single log message. */
+#define BDK_LOG_MAX_ARGS               (8)
+
+/** \brief Marker in the most significant byte of record header. */
+#define BDK_LOG_HDR_MARKER             (0xA5000000)
+
+/** \brief Message ID of record that reports number of dropped records. */
+#define BDK_LOG_ID_DROPPED             (0xFFFF)
+
+/** \brief Logs printf style message as format ID and raw arguments.
+ *
+ * \param fmt
+ * String literal with printf format.
+ */
+#define BDK_LOG_PRINTF(fmt, ...)                                              \
+    do                                                                        \
+    {                                                                         \
+        static const char bdk_log_fmt[]                                       \
+                __attribute__((section("bdk_log_fmt"))) = fmt;                \
+        const uint32_t bdk_log_args[] = { 0 BDK_LOG_ARGS(__VA_ARGS__) };      \
+        BDK_LogWrite(bdk_log_fmt, &bdk_log_args[1],                           \
+                BDK_LOG_NARG(__VA_ARGS__));                                   \
+    } while (0)
+
+/* Internal helpers that count arguments and convert them into list of
+ * 32-bit words prefixed with comma.
+ * Argument that does not fit into 32-bit word or is floating point makes the
+ * array size negative. Arrays are decayed to pointers by adding 0. */
+#define BDK_LOG_NARG(...)                                                     \
+    BDK_LOG_NARG_(_0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define BDK_LOG_NARG_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+#define BDK_LOG_CAT(a, b)              BDK_LOG_CAT_(a, b)
+#define BDK_LOG_CAT_(a, b)             a ## b
+
+#define BDK_LOG_ARGS(...)                                                     \
+    BDK_LOG_CAT(BDK_LOG_ARGS_, BDK_LOG_NARG(__VA_ARGS__))(__VA_ARGS__)
+#define BDK_LOG_WORD(a)                                                       \
+    (uint32_t)(a) + 0U * sizeof(char[(sizeof((a) + 0) <= sizeof(uint32_t)     \
+            && __builtin_classify_type((a) + 0) != 8) ? 1 : -1])
+
+#define BDK_LOG_ARGS_0(...)
+#define BDK_LOG_ARGS_1(a)              , BDK_LOG_WORD(a)
+#define BDK_LOG_ARGS_2(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_1(__VA_ARGS__)
+#define BDK_LOG_ARGS_3(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_2(__VA_ARGS__)
+#define BDK_LOG_ARGS_4(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_3(__VA_ARGS__)
+#define BDK_LOG_ARGS_5(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_4(__VA_ARGS__)
+#define BDK_LOG_ARGS_6(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_5(__VA_ARGS__)
+#define BDK_LOG_ARGS_7(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_6(__VA_ARGS__)
+#define BDK_LOG_ARGS_8(a, ...)         , BDK_LOG_WORD(a) BDK_LOG_ARGS_7(__VA_ARGS__)
+
+/** \brief Configures log output channel.
+ *
+ * Records already stored in the ring buffer are kept.
+ */
+extern void BDK_LogInit(void);
+
+/** \brief Stores log record into ring buffer.
+ *
+ * Lock-free and safe to call from interrupt context.
+ * Record is dropped and counted if there is not enough space in the buffer.
+ *
+ * \param fmt
+ * Pointer to format string in bdk_log_fmt section.
+ *
+ * \param args
+ * Message arguments.
+ *
+ * \param nargs
+ * Number of message arguments.
+ */
+extern void BDK_LogWrite(const char *fmt, const uint32_t *args, uint32_t nargs);
+
+/** \brief Sends committed records from ring buffer to the output channel.
+ *
+ * At most RTE_BDK_LOG_FLUSH_WORDS words are taken per call.
+ * UART transfer runs in background, nothing is sent while previous transfer
+ * is in progress.
+ * Must be called only from the main loop.
+ */
+extern void BDK_LogFlush(void);
+
+/** \brief Sends all committed records and waits until they are out.
+ *
+ * Blocking, intended for fatal error handlers only.
+ */
+extern void BDK_LogFlushAll(void);
+
+/** \brief Checks whether UART transfer started by \ref BDK_LogFlush is in
+ * progress.
+ *
+ * UART must not be de-initialized while busy.
+ */
+extern bool BDK_LogIsBusy(void);
+
+/** \brief Returns number of records dropped due to full ring buffer. */
+extern uint32_t BDK_LogGetDropped(void);
+
+/** \brief Returns highest ring buffer usage in words seen by
+ * \ref BDK_LogFlush.
+ */
+extern uint32_t BDK_LogGetHighWater(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BDK_LOG_H_ */
+
+//! \}
+//! \}
@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BDK_Prof.h
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup PROF_GRP Cycle Profiler
+//!
+//! \brief Measures execution time of hot code paths in CPU cycles.
+//!
+//! Cycles are counted by DWT CYCCNT register of Cortex-M3 core.
+//! Every probe accumulates number of samples, min / max / mean duration and
+//! histogram with log2 sized bins.
+//! Bin \c i counts durations in range <2^i, 2^(i+1)) cycles, bin 0 includes
+//! also zero and the last bin all longer durations.
+//!
+//! Probes are compiled out unless RTE_BDK_PROF_ENABLED is set in RTE_BDK.h.
+//!
+//! Example:
+//! \code
+//! void ADC_BATMON_IRQHandler(void)
+//! {
+//!     BDK_PROF_START(BDK_PROF_ADC_IRQ);
+//!     ...
+//!     BDK_PROF_STOP(BDK_PROF_ADC_IRQ);
+//! }
+//! \endcode
+//!
+//! \{
+//-----------------------------------------------------------------------------
+
+#ifndef BDK_PROF_H_
+#define BDK_PROF_H_
+
+#include <stdint.h>
+
+#include <rsl10.h>
+
+#include "RTE_BDK.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** \brief Number of histogram bins of every probe. */
+#define BDK_PROF_HIST_BINS             (16)
+
+/** \brief Probe points. */
+enum BDK_ProfProbe
+{
+    BDK_PROF_ADC_IRQ = 0, /**< ADC_BATMON_IRQHandler */
+    BDK_PROF_DMIC_DMA_IRQ, /**< DMIC DMA channel interrupt handler */
+    BDK_PROF_PACK_AUDIO, /**< Pack_Audio_Packet of all audio providers */
+    BDK_PROF_CCS_NOTIFY, /**< BLE_CCS_Notify */
+    BDK_PROF_KERNEL_SCHEDULE, /**< Kernel_Schedule in main loop */
+    BDK_PROF_TIMER_WAKEUP, /**< Timer_SetWakeupAtNextEvent in main loop */
+    BDK_PROF_PROBE_NB
+};
+
+/** \brief Accumulated statistics of one probe. */
+struct BDK_ProfStats
+{
+    /** \brief Number of recorded durations. */
+    uint32_t count;
+
+    /** \brief Shortest duration in cycles, valid only if count is not 0. */
+    uint32_t min;
+
+    /** \brief Longest duration in cycles. */
+    uint32_t max;
+
+    /** \brief Sum of all durations in cycles. */
+    uint64_t sum;
+
+    /** \brief Log2 histogram of durations. */
+    uint32_t hist[BDK_PROF_HIST_BINS];
+};
+
+#if RTE_BDK_PROF_ENABLED == 1
+
+/** \brief Marks start of measured code section.
+ *
+ * Declares local variable, so it has to be used in the same block as the
+ * matching BDK_PROF_STOP.
+ */
+#define BDK_PROF_START(probe) \
+    uint32_t bdk_prof_start_##probe = DWT->CYCCNT
+
+/** \brief Records duration since matching BDK_PROF_START. */
+#define BDK_PROF_STOP(probe) \
+    BDK_ProfRecord(probe, DWT->CYCCNT - bdk_prof_start_##probe)
+
+#else
+
+#define BDK_PROF_START(probe)
+#define BDK_PROF_STOP(probe)
+
+#endif /* RTE_BDK_PROF_ENABLED == 1 */
+
+/** \brief Enables DWT cycle counter.
+ *
+ * Has to be called also after wake up from deep sleep as the debug
+ * components are not retained.
+ */
+extern void BDK_ProfInit(void);
+
+/** \brief Adds duration to statistics of given probe.
+ *
+ * A probe must be recorded always from the same execution context.
+ */
+extern void BDK_ProfRecord(enum BDK_ProfProbe probe, uint32_t cycles);
+
+/** \brief Returns statistics of given probe. */
+extern const struct BDK_ProfStats* BDK_ProfGetStats(enum BDK_ProfProbe probe);
+
+/** \brief Returns short name of given probe. */
+extern const char* BDK_ProfGetName(enum BDK_ProfProbe probe);
+
+/** \brief Clears statistics of all probes. */
+extern void BDK_ProfReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BDK_PROF_H_ */
+
+//! \}
+//! \}
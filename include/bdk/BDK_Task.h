@@ -35,6 +35,11 @@
 //! \see BLE Profile documentation for messages defined by respective BLE
 //! profiles.
 //!
+//! Callbacks deferred by BDK_TaskSchedule do not use kernel messages.
+//! They are stored in a fixed size queue that interrupts can fill without
+//! locking or allocation, and the main loop executes them by calling
+//! BDK_TaskRunScheduled.
+//!
 //! \{
 //-----------------------------------------------------------------------------
 
@@ -66,7 +71,7 @@ enum BDK_MSG_IDX
 {
     BDK_DUMMY_MSG = TASK_FIRST_MSG(TASK_ID_APP),
 
-    /** \see BDK_TaskSchedule */
+    /** Reserved, BDK_TaskSchedule no longer sends kernel messages. */
     BDK_SCHEDULE_MSG,
 
     /** First message id value that can be used by application if it wants to
@@ -119,7 +124,14 @@ extern void BDK_TaskStart(void);
  */
 extern ke_msg_id_t BDK_TaskAllocateMsgId(void);
 
-/** \brief Allows for an callback to be executed by Event Kernel.
+/** \brief Allows for an callback to be executed from the main loop.
+ *
+ * Callback is stored in a queue of RTE_BDK_TASK_QUEUE_SIZE entries and
+ * executed by \ref BDK_TaskRunScheduled.
+ * This is safe to call from any interrupt priority and never allocates
+ * memory.
+ * Callback is dropped and counted by \ref BDK_TaskGetDropped if the queue is
+ * full.
  *
  * <b>Example:</b><br>
  * This example waits for an interrupt to be generated by pressing BDK button.
@@ -135,6 +147,25 @@ extern ke_msg_id_t BDK_TaskAllocateMsgId(void);
  */
 extern void BDK_TaskSchedule(BDK_TaskCallback cb, void *arg);
 
+/** \brief Executes callbacks queued by BDK_TaskSchedule in the order they were
+ * scheduled.
+ *
+ * Must be called from the main loop only.
+ * Called by BDK_Schedule and BDK_ScheduleNoWdt.
+ */
+extern void BDK_TaskRunScheduled(void);
+
+/** \brief Returns true if there are queued callbacks to be executed. */
+extern bool BDK_TaskIsSchedulePending(void);
+
+/** \brief Returns number of callbacks dropped because the queue was full. */
+extern uint32_t BDK_TaskGetDropped(void);
+
+/** \brief Returns highest number of queued callbacks seen by
+ * \ref BDK_TaskRunScheduled.
+ */
+extern uint32_t BDK_TaskGetHighWater(void);
+
 #ifdef __cplusplus
 }
 #endif
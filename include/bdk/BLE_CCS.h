@@ -43,6 +43,21 @@
 //!     * GATTC_WRITE_REQ_IND
 //!     * GATTC_ATT_INFO_REQ_IND
 //!     * GATTC_CMP_EVT
+//!     * GATTC_MTU_CHANGED_IND
+//!
+//! Stream Multiplexer (MUX) characteristic carries frames of all stream
+//! providers in one notification flow. Central device selects it by enabling
+//! its notifications, stream data are then no longer notified over per
+//! provider characteristics of that connection. Each notification fills up
+//! negotiated ATT MTU and has the same layout as SDU of \ref LECB transport:
+//!
+//!     +--------+--------+--------+-- ... --+--------+--------+-- ... --+
+//!     |  SEQ   |  PID   |  LEN   | payload |  PID   |  LEN   | payload |
+//!     +--------+--------+--------+-- ... --+--------+--------+-- ... --+
+//!
+//! Diagnostics (DIAG) characteristic returns runtime statistics generated by
+//! application on every read. Value is split into pages selected by write of
+//! page number, see \ref BLE_CCS_SetDiagHandler.
 //!
 //! \b Example: \n
 //! Minimal code example which uses Custom Service.
@@ -102,6 +117,16 @@ extern "C"
 											0xca, 0x9e, 0xe5, 0xa9, 0xa3, 0x00, \
 											0xbc, 0xf3, 0x93, 0xe0 }
 
+/** \brief CESLA RMFE Service Stream Multiplexer Characteristic UUID */
+#define CCS_MUX_CHARACTERISTIC_UUID      	{ 0x24, 0xdc, 0x0e, 0x6e, 0x04, 0x40, \
+											0xca, 0x9e, 0xe5, 0xa9, 0xa3, 0x00, \
+											0xbd, 0xf3, 0x93, 0xe0 }
+
+/** \brief CESLA RMFE Service Diagnostics Characteristic UUID */
+#define CCS_DIAG_CHARACTERISTIC_UUID      	{ 0x24, 0xdc, 0x0e, 0x6e, 0x05, 0x40, \
+											0xca, 0x9e, 0xe5, 0xa9, 0xa3, 0x00, \
+											0xbe, 0xf3, 0x93, 0xe0 }
+
 /** \brief Human readable Stream Control Point characteristic description.
  *
  * Can be read from <i>Characteristic User Description</i> of SCP
@@ -152,6 +177,20 @@ extern "C"
  */
 #define CCS_ASCP_CHARACTERISTIC_NAME	 "Request to ALERT user of direction"
 
+/** \brief Human readable Stream Multiplexer characteristic description.
+ *
+ * Can be read from <i>Characteristic User Description</i> of MUX
+ * characteristic.
+ */
+#define CCS_MUX_CHARACTERISTIC_NAME	     "STREAM_MUX - Notification - All Streams"
+
+/** \brief Human readable Diagnostics characteristic description.
+ *
+ * Can be read from <i>Characteristic User Description</i> of DIAG
+ * characteristic.
+ */
+#define CCS_DIAG_CHARACTERISTIC_NAME	 "DIAGNOSTICS - Write page - Read"
+
 #define CCS_SCP_CHARACTERISTIC_NAME_LEN  (sizeof(CCS_SCP_CHARACTERISTIC_NAME) - 1)
 
 #define CCS_RCF_CHARACTERISTIC_NAME_LEN  (sizeof(CCS_RCF_CHARACTERISTIC_NAME) - 1)
@@ -166,6 +205,10 @@ extern "C"
 
 #define CCS_ASCP_CHARACTERISTIC_NAME_LEN (sizeof(CCS_ASCP_CHARACTERISTIC_NAME) - 1)
 
+#define CCS_MUX_CHARACTERISTIC_NAME_LEN  (sizeof(CCS_MUX_CHARACTERISTIC_NAME) - 1)
+
+#define CCS_DIAG_CHARACTERISTIC_NAME_LEN (sizeof(CCS_DIAG_CHARACTERISTIC_NAME) - 1)
+
 /** \brief Maximum amount of data that can be either received from RX
  * characteristic or send over TX characteristic.
  *
@@ -174,6 +217,49 @@ extern "C"
  */
 #define CCS_CHARACTERISTIC_VALUE_LENGTH (20)
 
+/** \brief Maximum length of MUX characteristic value.
+ *
+ * Effective length is limited by ATT MTU of subscribed connections.
+ */
+#define CCS_MUX_VALUE_MAX_LENGTH        (244)
+
+/** \brief Maximum length of DIAG characteristic value.
+ *
+ * Values longer than ATT MTU are read by client with Read Blob requests.
+ */
+#define CCS_DIAG_VALUE_MAX_LENGTH       (128)
+
+/** \brief Length of MUX value header preceding the first frame. */
+#define CCS_MUX_HEADER_LENGTH           (1)
+
+/** \brief Length of header preceding payload of every MUX frame. */
+#define CCS_MUX_FRAME_HEADER_LENGTH     (2)
+
+/** \brief Shortest MUX value able to carry a frame of maximal length.
+ *
+ * Connections with ATT MTU too small for this value receive stream data on
+ * characteristics assigned to the providers instead.
+ */
+#define CCS_MUX_MIN_VALUE_LENGTH        (CCS_MUX_HEADER_LENGTH \
+                                         + CCS_MUX_FRAME_HEADER_LENGTH \
+                                         + CCS_CHARACTERISTIC_VALUE_LENGTH)
+
+/** \brief Time after first frame is appended when partially filled MUX value
+ * is notified, in units of 10 ms.
+ */
+#define CCS_MUX_FLUSH_TIMEOUT           (2)
+
+/** \brief Maximum number of notifications queued for a single connection that
+ * were not yet confirmed by GATTC_CMP_EVT.
+ *
+ * Further notifications for that connection are dropped so that a congested
+ * link does not exhaust kernel heap shared with other connections.
+ */
+#define CCS_NOTIFY_QUEUE_MAX            (24)
+
+/** \brief Number of attributes forming every CCS characteristic. */
+#define CCS_ATT_PER_CHAR                (4)
+
 /** \brief Attribute database indexes of CCS characteristics. */
 typedef enum
 {
@@ -219,10 +305,40 @@ typedef enum
     CCS_IDX_ASCP_VALUE_CCC,
     CCS_IDX_ASCP_VALUE_USR_DSCP,
 
+    /* MUX Characteristic */
+    CCS_IDX_MUX_VALUE_CHAR,
+    CCS_IDX_MUX_VALUE_VAL,
+    CCS_IDX_MUX_VALUE_CCC,
+    CCS_IDX_MUX_VALUE_USR_DSCP,
+
+    /* DIAG Characteristic */
+    CCS_IDX_DIAG_VALUE_CHAR,
+    CCS_IDX_DIAG_VALUE_VAL,
+    CCS_IDX_DIAG_VALUE_CCC,
+    CCS_IDX_DIAG_VALUE_USR_DSCP,
+
     /* Max number of characteristics */
     CCS_IDX_NB,
 } BLE_CCS_AttributeIndex;
 
+/** \brief Number of CCS characteristics. */
+#define CCS_CHAR_NB                     (CCS_IDX_NB / CCS_ATT_PER_CHAR)
+
+/** \brief Returns characteristic number of given attribute index. */
+#define CCS_CHAR_IDX(att_idx)           ((att_idx) / CCS_ATT_PER_CHAR)
+
+/** \brief Returns role of given attribute index within its characteristic. */
+#define CCS_ATT_ROLE(att_idx)           ((att_idx) % CCS_ATT_PER_CHAR)
+
+/** \brief Role of attribute within CCS characteristic. */
+enum BLE_CCS_AttributeRole
+{
+    CCS_ATT_CHAR = 0, /**< Characteristic declaration. */
+    CCS_ATT_VAL, /**< Characteristic value. */
+    CCS_ATT_CCC, /**< Client Characteristic Configuration descriptor. */
+    CCS_ATT_USR_DSCP /**< Characteristic User Description descriptor. */
+};
+
 /** \brief Initialization state of CCS library. */
 enum BLE_CCS_State
 {
@@ -232,6 +348,16 @@ enum BLE_CCS_State
     BLE_CCS_CONNECTED /**< Client device connected. Notifications can be send. */
 };
 
+/** \brief Status codes of CCS notification functions. */
+enum BLE_CCS_Status
+{
+    BLE_CCS_STATUS_OK = 0, /**< Sent or nobody has notifications enabled. */
+    BLE_CCS_STATUS_NO_CLIENT = 1, /**< No connected or subscribed device. */
+    BLE_CCS_STATUS_LENGTH = 2, /**< Data longer than allowed maximum. */
+    BLE_CCS_STATUS_DROPPED = 3 /**< Dropped for every subscribed device
+                                    because of full notification queue. */
+};
+
 /** \brief Data structure passed to application specific Write Indication
  * callback handler.
  */
@@ -247,6 +373,51 @@ struct BLE_CCS_RxIndData
 /** \brief Callback type for handling of RX Write indication events. */
 typedef void (*BLE_CCS_RxIndHandler)(struct BLE_CCS_RxIndData *ind);
 
+/** \brief Callback type that provides value of DIAG characteristic.
+ *
+ * \param page
+ * Page selected by the last write of reading device, 0 by default.
+ * \param value
+ * Buffer of \ref CCS_DIAG_VALUE_MAX_LENGTH bytes to be filled.
+ * \returns
+ * Length of the value, 0 for unknown page.
+ */
+typedef uint8_t (*BLE_CCS_DiagReadHandler)(uint8_t page, uint8_t *value);
+
+/** \brief Last value written to or notified over a characteristic. */
+struct BLE_CCS_Value
+{
+    uint8_t value[CCS_CHARACTERISTIC_VALUE_LENGTH];
+    uint8_t length;
+
+    /** \brief Buffer of the last stream packet, read in place of
+     * \ref value when not NULL.
+     */
+    const uint8_t *ref;
+};
+
+/** \brief Stores state of CCS Profile specific to one connected device. */
+struct BLE_CCS_Connection
+{
+    /** \brief Client Characteristic Configuration of every characteristic. */
+    uint16_t cccd_value[CCS_CHAR_NB];
+
+    /** \brief Number of notifications waiting for GATTC_CMP_EVT. */
+    uint8_t tx_pending;
+
+    /** \brief Highest number of notifications waiting at once. */
+    uint8_t tx_pending_max;
+
+    /** \brief Number of notifications dropped because of full queue. */
+    uint32_t tx_dropped;
+
+    /** \brief Negotiated ATT MTU. */
+    uint16_t mtu;
+
+    /** \brief Page of DIAG characteristic returned on read. */
+    uint8_t diag_page;
+};
+
 /** \brief Stores internal state CCS Profile. */
 struct BLE_CCS_Resources
 {
@@ -261,33 +432,26 @@ struct BLE_CCS_Resources
      */
     BLE_CCS_RxIndHandler rx_write_handler;
 
-    uint8_t scp_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t scp_value_length;
-    uint16_t scp_cccd_value;
-
-    uint8_t ascp_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t ascp_value_length;
-    uint16_t ascp_cccd_value;
+    /** \brief Application handler providing DIAG characteristic value. */
+    BLE_CCS_DiagReadHandler diag_read_handler;
 
-    uint8_t dmic_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t dmic_value_length;
-    uint16_t dmic_cccd_value;
+    /** \brief Values of readable characteristics indexed by
+     * characteristic number.
+     */
+    struct BLE_CCS_Value value[CCS_CHAR_NB];
 
-    uint8_t lca_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t lca_value_length;
-    uint16_t lca_cccd_value;
+    /** \brief MUX value that is being assembled. */
+    uint8_t mux_value[CCS_MUX_VALUE_MAX_LENGTH];
+    uint16_t mux_value_length;
 
-    uint8_t rca_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t rca_value_length;
-    uint16_t rca_cccd_value;
+    /** \brief Sequence number of the next MUX notification. */
+    uint8_t mux_seq;
 
-    uint8_t lcf_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t lcf_value_length;
-    uint16_t lcf_cccd_value;
+    /** \brief Kernel timer message notifying partially filled MUX value. */
+    ke_msg_id_t mux_flush_msg_id;
 
-    uint8_t rcf_value[CCS_CHARACTERISTIC_VALUE_LENGTH];
-    uint8_t rcf_value_length;
-    uint16_t rcf_cccd_value;
+    /** \brief Per-connection state indexed by BDK BLE connection slot. */
+    struct BLE_CCS_Connection con[BDK_BLE_MASTER_MAX];
 };
 
 /** \brief Adds CESLA Custom Service into BDK BLE stack.
@@ -311,8 +475,9 @@ extern void BLE_CCS_Initialize(BLE_CCS_RxIndHandler rx_ind_handler);
 
 /** \brief Send out a notification over corresponding characteristic.
  *
- * TX characteristic will be updated with new data and connected device will
- * receive notification of this change.
+ * TX characteristic will be updated with new data and every connected device
+ * with enabled notifications will receive notification of this change.
+ * Data are copied once into read cache and once per notified connection.
  *
  * \param data
  * Data that will be sent in notification packet and stored in the caller's
@@ -321,22 +486,112 @@ extern void BLE_CCS_Initialize(BLE_CCS_RxIndHandler rx_ind_handler);
  * \param data_len
  * Length of given data.
  *
- * \returns Operation status code.
- * | Code | Description                                              |
- * | ---- | -------------------------------------------------------- |
- * | 0    | On success.                                              |
- * | 1    | If there is no BLE client device connected.              |
- * | 2    | If length of data is bigger than allowed maximum length. |
+ * \returns Operation status code, \ref BLE_CCS_Status.
+ * | Code                     | Description                                 |
+ * | ------------------------ | ------------------------------------------- |
+ * | BLE_CCS_STATUS_OK        | On success.                                 |
+ * | BLE_CCS_STATUS_NO_CLIENT | If there is no BLE client device connected. |
+ * | BLE_CCS_STATUS_LENGTH    | If length of data is bigger than allowed    |
+ * |                          | maximum length.                             |
+ * | BLE_CCS_STATUS_DROPPED   | If notification was dropped for every       |
+ * |                          | subscribed device because of full           |
+ * |                          | notification queue.                         |
  *
  */
 extern uint32_t BLE_CCS_Notify(uint8_t *data, uint8_t data_len, BLE_CCS_AttributeIndex idx);
 
+/** \brief Send out stream packet over corresponding characteristic.
+ *
+ * Same as \ref BLE_CCS_Notify except that the packet is not copied for later
+ * read requests. Characteristic read returns current content of the given
+ * buffer instead.
+ *
+ * \param data
+ * Packet buffer that remains valid until the next call for the same
+ * characteristic, e.g. static transmit buffer of stream provider.
+ *
+ * \param data_len
+ * Length of given data.
+ *
+ * \returns Operation status code same as \ref BLE_CCS_Notify.
+ */
+extern uint32_t BLE_CCS_NotifyStream(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx);
+
+/** \brief Sets stream packet returned by characteristic read without
+ * notifying it.
+ *
+ * Used when the packet is sent over another transport, so that reads do not
+ * return a stale packet length.
+ *
+ * \param data
+ * Packet buffer with the same lifetime as for \ref BLE_CCS_NotifyStream.
+ *
+ * \param data_len
+ * Length of given data.
+ */
+extern void BLE_CCS_SetStreamValue(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx);
+
 /*
  * Write more than 20 bytes to a characteristic.
- * Notifies first 20 bytes only however stores all bytes in caller's characteristic.
+ * Notifies and stores first 20 bytes only.
  */
 extern uint32_t BLE_CCS_WriteNotify(uint8_t *data, uint16_t data_len, BLE_CCS_AttributeIndex idx);
 
+/** \brief Appends a stream frame to the MUX characteristic value.
+ *
+ * Value is notified once it can not fit another frame of maximal length
+ * within ATT MTU of all connections subscribed to MUX characteristic, or
+ * CCS_MUX_FLUSH_TIMEOUT after its first frame was appended.
+ *
+ * Connections whose ATT MTU can not fit CCS_MUX_MIN_VALUE_LENGTH are not
+ * served by MUX and receive frames over BLE_CCS_NotifyStream.
+ *
+ * \param provider_id
+ * CS provider ID stored in the frame header.
+ *
+ * \param data
+ * Frame payload.
+ *
+ * \param data_len
+ * Length of frame payload.
+ *
+ * \returns Operation status code, \ref BLE_CCS_Status.
+ * | Code                     | Description                                 |
+ * | ------------------------ | ------------------------------------------- |
+ * | BLE_CCS_STATUS_OK        | On success.                                 |
+ * | BLE_CCS_STATUS_NO_CLIENT | If no connected device is subscribed to MUX |
+ * |                          | or ATT MTU of subscribed devices can not    |
+ * |                          | fit the frame.                              |
+ * | BLE_CCS_STATUS_LENGTH    | If length of data is bigger than allowed    |
+ * |                          | maximum length.                             |
+ * | BLE_CCS_STATUS_DROPPED   | If full MUX value was dropped for every     |
+ * |                          | subscribed device because of full           |
+ * |                          | notification queue.                         |
+ */
+extern uint32_t BLE_CCS_MuxWrite(uint8_t provider_id, const uint8_t *data, uint8_t data_len);
+
+/** \brief Assigns application handler that provides DIAG characteristic
+ * value.
+ *
+ * Connected device selects page by writing single byte into the DIAG
+ * characteristic, every following read returns current value of that page.
+ * Reads return empty value if no handler is assigned.
+ */
+extern void BLE_CCS_SetDiagHandler(BLE_CCS_DiagReadHandler handler);
+
+/** \brief Returns CCS state of connection in given slot.
+ *
+ * Counters are cleared when a peer device connects into the slot.
+ *
+ * \param slot
+ * Connection slot in range 0 to BDK_BLE_MASTER_MAX - 1.
+ *
+ * \returns Connection state or NULL if the slot is free.
+ */
+extern const struct BLE_CCS_Connection* BLE_CCS_GetConnection(uint8_t slot);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,5 +26,6 @@
 #include <BLE_PeripheralServer.h>
 #include <BLE_BASS.h>
 #include <BLE_CCS.h>
+#include <BLE_LECB.h>
 
 #endif /* BLE_COMPONENTS_H_ */
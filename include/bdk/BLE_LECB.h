@@ -0,0 +1,204 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BLE_LECB.h
+//! \version v1.0.0
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup BLE_GRP
+//! \{
+//! \addtogroup LECB LE Credit Based Channel Transport
+//!
+//! \brief Bulk stream transport over a single L2CAP LE credit based channel.
+//!
+//! Central device opens the channel on \ref BLE_LECB_Initialize registered
+//! LE_PSM. While the channel is open, stream frames are packed into SDUs that
+//! can be much larger than ATT MTU and are sent as soon as the SDU buffer
+//! fills up and peer device has granted enough credits.<br>
+//! GATT based CCS service stays available for stream control and for central
+//! devices without LE CoC support.
+//!
+//! SDU layout (little-endian):
+//!
+//!     +--------+--------+--------+-- ... --+--------+--------+-- ... --+
+//!     |  SEQ   |  PID   |  LEN   | payload |  PID   |  LEN   | payload |
+//!     +--------+--------+--------+-- ... --+--------+--------+-- ... --+
+//!
+//! * SEQ - SDU sequence number, incremented with every sent SDU.
+//! * PID - CS provider ID of the following frame.
+//! * LEN - Payload length of the following frame in bytes.
+//!
+//! \warning LECB uses message handlers registered under application task
+//! (TASK_APP). Following message handlers will be added to application task:
+//!     * L2CC_LECB_CONNECT_REQ_IND
+//!     * L2CC_LECB_CONNECT_IND
+//!     * L2CC_LECB_DISCONNECT_IND
+//!     * L2CC_LECB_ADD_IND
+//!     * L2CC_LECB_SDU_RECV_IND
+//!     * L2CC_CMP_EVT
+//! \{
+//-----------------------------------------------------------------------------
+
+#ifndef BLE_LECB_H
+#define BLE_LECB_H
+
+#include "BLE_PeripheralServer.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** \brief Maximum length of SDU assembled by the transport.
+ *
+ * Effective SDU length is limited also by MTU advertised by peer device when
+ * the channel is opened.
+ */
+#define BLE_LECB_SDU_MAX_LENGTH        (240)
+
+/** \brief Length of SDU header preceding the first frame. */
+#define BLE_LECB_SDU_HEADER_LENGTH     (1)
+
+/** \brief Length of header preceding payload of every frame. */
+#define BLE_LECB_FRAME_HEADER_LENGTH   (2)
+
+/** \brief Maximum payload length of a single frame. */
+#define BLE_LECB_FRAME_MAX_LENGTH      (20)
+
+/** \brief Maximum number of SDUs handed over to L2CC task that were not yet
+ * confirmed by L2CC_CMP_EVT.
+ */
+#define BLE_LECB_TX_QUEUE_MAX          (2)
+
+/** \brief Number of credits given back to peer device for every received SDU
+ * fragment.
+ */
+#define BLE_LECB_LOCAL_CREDIT          (1)
+
+/** \brief Initialization and connection state of the LECB transport. */
+enum BLE_LECB_State
+{
+    BLE_LECB_OFF = 0, /**< Initial state after device power up. */
+    BLE_LECB_REGISTER, /**< Waiting for LE_PSM registration confirmation. */
+    BLE_LECB_READY, /**< Waiting for central device to open the channel. */
+    BLE_LECB_OPEN /**< Channel is open. Frames can be sent. */
+};
+
+/** \brief Stores internal state of the LECB transport. */
+struct BLE_LECB_Resources
+{
+    /** \brief Stores current initialization and connection state. */
+    uint8_t state;
+
+    /** \brief LE Protocol/Service Multiplexer the channel is accepted on. */
+    uint16_t le_psm;
+
+    /** \brief Connection index of central device that opened the channel. */
+    uint8_t conidx;
+
+    /** \brief Local channel identifier of the open channel. */
+    uint16_t local_cid;
+
+    /** \brief Number of K-frames peer device is still able to receive. */
+    uint16_t peer_credit;
+
+    /** \brief Maximum SDU length accepted by peer device. */
+    uint16_t peer_mtu;
+
+    /** \brief Maximum K-frame payload length accepted by peer device. */
+    uint16_t peer_mps;
+
+    /** \brief Number of SDUs waiting for L2CC_CMP_EVT. */
+    uint8_t tx_pending;
+
+    /** \brief Highest number of SDUs waiting at once. */
+    uint8_t tx_pending_max;
+
+    /** \brief Sequence number of the next SDU. */
+    uint8_t tx_seq;
+
+    /** \brief SDU that is being assembled. */
+    uint8_t sdu[BLE_LECB_SDU_MAX_LENGTH];
+
+    /** \brief Number of valid bytes in \ref sdu. */
+    uint16_t sdu_length;
+
+    /** \brief Effective SDU length limit of the open channel. */
+    uint16_t sdu_max_length;
+
+    /** \brief Number of frames rejected because of missing credits. */
+    uint32_t frames_dropped;
+};
+
+/** \brief Registers LE_PSM and adds LECB message handlers to BDK BLE stack.
+ *
+ * \pre This functions must be called before Application task is started and
+ * before Event Kernel messaging is started, e.g. before entering main loop
+ * and calling \ref BDK_Schedule .
+ *
+ * \param le_psm
+ * LE Protocol/Service Multiplexer on which the channel will be accepted.
+ * Dynamic range 0x0080 - 0x00FF should be used.
+ */
+extern void BLE_LECB_Initialize(uint16_t le_psm);
+
+/** \brief Checks whether central device has opened the channel.
+ *
+ * Channel of a central device that is no longer connected is closed here,
+ * even if L2CC_LECB_DISCONNECT_IND was not received.
+ *
+ * \returns true if frames can be sent using \ref BLE_LECB_Write .
+ */
+extern bool BLE_LECB_IsOpen(void);
+
+/** \brief Appends a stream frame to the SDU that is being assembled.
+ *
+ * SDU is handed over to L2CC task once it can not fit another frame of
+ * maximal length.
+ *
+ * \param provider_id
+ * CS provider ID stored in the frame header.
+ *
+ * \param data
+ * Frame payload.
+ *
+ * \param data_len
+ * Length of frame payload.
+ *
+ * \returns Operation status code, values match \ref BLE_CCS_Status.
+ * | Code | Description                                               |
+ * | ---- | --------------------------------------------------------- |
+ * | 0    | On success.                                               |
+ * | 1    | If the channel is not open.                               |
+ * | 2    | If length of data is bigger than allowed maximum length.  |
+ * | 3    | If peer device has not granted enough credits. Frame was  |
+ * |      | dropped.                                                  |
+ */
+extern uint32_t BLE_LECB_Write(uint8_t provider_id, const uint8_t *data, uint8_t data_len);
+
+/** \brief Returns channel state and transmit counters.
+ *
+ * Counters are cleared when the channel is registered.
+ */
+extern const struct BLE_LECB_Resources* BLE_LECB_GetResources(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLE_LECB_H */
+
+//! \}
+//! \}
+//! \}
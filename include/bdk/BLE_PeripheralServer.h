@@ -46,9 +46,18 @@ extern "C"
 
 /** \brief Maximum number of connected devices.
  *
- * BDK BLE stack does not support multiple connections at the same time.
+ * Advertising is kept running while less than this number of central
+ * devices is connected. Set to 1 to allow a single connection only.
  */
-#define BDK_BLE_MASTER_MAX             (1)
+#ifndef BDK_BLE_MASTER_MAX
+#define BDK_BLE_MASTER_MAX             (2)
+#endif
+
+/** \brief Maximum number of LE credit based connections.
+ *
+ * Only one channel is used by BLE_LECB transport.
+ */
+#define BDK_BLE_LECB_MAX               (1)
 
 /** \brief Maximum length of device <i>Complete Local Name</i>.
  *
@@ -123,6 +132,75 @@ extern "C"
 
 #define INVALID_DEV_IDX                (-1)
 
+/** \brief Advertising used to reconnect the bonded central device after it
+ * disconnects.
+ */
+enum BDK_BLE_ReconnectMode
+{
+    /** \brief Undirected advertising only. */
+    BDK_BLE_RECONNECT_NONE = 0,
+
+    /** \brief High duty cycle directed advertising to the address of bonded
+     * device. Stack ends it after 1.28 s, undirected advertising follows.
+     *
+     * Falls back to undirected advertising if bonded device connects with
+     * resolvable private addresses.
+     */
+    BDK_BLE_RECONNECT_DIRECTED,
+
+    /** \brief Undirected advertising that accepts connection requests only
+     * from white listed bonded device until \ref BDK_BLE_EndReconnect is
+     * called.
+     *
+     * Any central device may connect if bonded device connects with
+     * resolvable private addresses.
+     */
+    BDK_BLE_RECONNECT_WHITELIST
+};
+
+/** \brief Stores keys and identity of the bonded central device. */
+struct BDK_BLE_Bond
+{
+    /** \brief Bond information is valid. */
+    bool valid;
+
+    /** \brief Authentication level of the bond. */
+    uint8_t auth;
+
+    /** \brief Address used by the central device when bonding. */
+    struct gap_bdaddr peer_addr;
+
+    /** \brief Identity address distributed by the central device, equal to
+     * peer_addr if the central device did not distribute its identity.
+     */
+    struct gap_bdaddr id_addr;
+
+    /** \brief Long term key distributed to the central device. */
+    struct gapc_ltk ltk;
+
+    /** \brief Identity resolving key received from the central device. */
+    struct gap_sec_key irk;
+};
+
+/** \brief Link parameters of a connection. */
+struct BDK_BLE_ConParam
+{
+    /** \brief Connection interval in units of 1.25 ms. */
+    uint16_t interval;
+
+    /** \brief Slave latency in number of connection events. */
+    uint16_t latency;
+
+    /** \brief Supervision timeout in units of 10 ms. */
+    uint16_t sup_to;
+
+    /** \brief Transmit PHY, one of GAP_PHY_LE_* values. */
+    uint8_t tx_phy;
+
+    /** \brief Receive PHY, one of GAP_PHY_LE_* values. */
+    uint8_t rx_phy;
+};
+
 typedef void (*BDK_BLE_SVC_AddFunc)(void);
 typedef void (*BDK_BLE_SVC_EnableFunc)(uint8_t);
 
@@ -159,6 +237,9 @@ extern void BDK_BLE_SetLocalName(const char* name);
 extern void BDK_BLE_SetManufSpecificData(const uint8_t* data, uint32_t len);
 
 /** \brief Set custom advertising interval.
+ *
+ * If the device is currently advertising, advertising is cancelled and
+ * started again with the new interval.
  *
  * \param interval_min
  * Minimum interval N for advertising.<br>
@@ -172,8 +253,45 @@ extern void BDK_BLE_SetManufSpecificData(const uint8_t* data, uint32_t len);
  */
 extern void BDK_BLE_SetAdvertisementInterval(uint16_t interval_min, uint16_t interval_max);
 
+/** \brief Returns connection index of the first connected peer device.
+ *
+ * \returns Connection index or INVALID_DEV_IDX if no device is connected.
+ */
 extern signed int BDK_BLE_GetConIdx(void);
 
+/** \brief Returns connection index of peer device stored in given slot.
+ *
+ * \param slot
+ * Connection slot in range 0 to BDK_BLE_MASTER_MAX - 1.
+ *
+ * \returns Connection index or INVALID_DEV_IDX if the slot is free.
+ */
+extern signed int BDK_BLE_GetConIdxBySlot(uint8_t slot);
+
+/** \brief Returns slot in which connection with given index is stored.
+ *
+ * Slots can be used by services to keep per-connection state in arrays of
+ * BDK_BLE_MASTER_MAX elements.
+ *
+ * \param conidx
+ * Connection index of peer device.
+ *
+ * \returns Slot number or INVALID_DEV_IDX if device is not connected.
+ */
+extern signed int BDK_BLE_GetConnectionSlot(uint8_t conidx);
+
+/** \brief Returns number of connected peer devices. */
+extern uint8_t BDK_BLE_GetConnectionCount(void);
+
+/** \brief Returns current link parameters of connection in given slot.
+ *
+ * \param slot
+ * Connection slot in range 0 to BDK_BLE_MASTER_MAX - 1.
+ *
+ * \returns Link parameters or NULL if the slot is free.
+ */
+extern const struct BDK_BLE_ConParam* BDK_BLE_GetConParam(uint8_t slot);
+
 extern bool BDK_BLE_IsConnected(void);
 
 extern void BDK_BLE_AddService(void (*svc_add_func)(void), void (*svc_enable_func)(uint8_t));
@@ -185,6 +303,42 @@ extern void BDK_BLE_AdvertisingStart(void);
 
 extern void BDK_BLE_AdvertisingStop(void);
 
+/** \brief Enables legacy pairing with bonding of one central device.
+ *
+ * Bonded central device is recognized when it encrypts the link with stored
+ * LTK. If the same device disconnects, the next advertising session starts
+ * with reconnect advertising selected by \p mode.
+ *
+ * Following message handlers will be added to application task:
+ *     * GAPC_BOND_REQ_IND
+ *     * GAPC_BOND_IND
+ *     * GAPC_ENCRYPT_REQ_IND
+ *     * GAPC_ENCRYPT_IND
+ *
+ * \pre Must be called after \ref BDK_BLE_Initialize and before Event Kernel
+ * messaging is started.
+ *
+ * \param mode
+ * Reconnect advertising used after bonded device disconnects.
+ */
+extern void BDK_BLE_EnableBonding(enum BDK_BLE_ReconnectMode mode);
+
+/** \brief Checks whether a central device is bonded. */
+extern bool BDK_BLE_IsBonded(void);
+
+/** \brief Returns stored bond information. */
+extern const struct BDK_BLE_Bond* BDK_BLE_GetBond(void);
+
+/** \brief Forgets bonded device and removes it from white list. */
+extern void BDK_BLE_ClearBond(void);
+
+/** \brief Ends reconnect advertising to bonded device.
+ *
+ * Advertising that is running is restarted as undirected advertising
+ * accepting any central device.
+ */
+extern void BDK_BLE_EndReconnect(void);
+
 
 #ifdef __cplusplus
 }
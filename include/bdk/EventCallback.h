@@ -23,8 +23,11 @@
 //! This simple library allows to attach multiple callback functions to single
 //! or multiple event sources.
 //!
-//! The event callbacks are stored in a linked list in the same order they were
-//! registered.
+//! The event callbacks are stored in linked lists in the same order they were
+//! registered, one list for each bucket of event IDs.
+//! Bucket is given by the lowest bits of event ID, so that registration and
+//! dispatch only touch callbacks whose event IDs share the bucket.
+//! Number of buckets is set by RTE_BDK_EVENT_CALLBACK_BUCKETS in RTE_BDK.h.
 //! Each event callback contains information about event ID it belongs to, the
 //! callback itself and an optional parameter to pass to the callback.
 //!
@@ -54,6 +57,8 @@
 
 #include <HAL.h>
 
+#include "RTE_BDK.h"
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -112,8 +117,10 @@ typedef struct _EventCallback_Struct EventCallback_Type;
 extern void EventCallback_Init(EventCallback_Type *handle, uint16_t event_id,
         EventCallback_Prototype callback, void *arg);
 
-/** \brief Inserts given event handle to the end of linked list composed of all
- * registered event handles.
+/** \brief Inserts given event handle to the end of linked list composed of
+ * registered event handles with the same event ID bucket.
+ *
+ * Takes constant time regardless of the number of registered handles.
  *
  * Caller is responsible for memory management of given event handle and
  * ensures that it wont be deallocated while handle is registered.
@@ -121,6 +128,8 @@ extern void EventCallback_Init(EventCallback_Type *handle, uint16_t event_id,
 extern void EventCallback_Register(EventCallback_Type *handle);
 
 /** \brief Removes given handle from list of registered event handlers.
+ *
+ * Only handles of the same event ID bucket are searched.
  *
  * Caller is responsible for memory management of given handle.
  */
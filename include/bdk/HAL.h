@@ -98,13 +98,31 @@ extern "C"
  */
 extern void HAL_Init(enum HAL_ClockConfiguration clk_conf);
 
+/** \brief Configures TIMER0 as 1 ms wake up tick.
+ *
+ * The tick does not run on its own, it is started only while there is an
+ * outstanding \ref HAL_TICK_Request. Has to be called again after wake up
+ * from deep sleep.
+ */
 extern void HAL_TICK_Init(void);
 
-/** \brief Delays program execution for defined period of time.
+/** \brief Starts the 1 ms tick for code that waits for time with WFI.
+ *
+ * Every call has to be paired with \ref HAL_TICK_Release.
+ */
+extern void HAL_TICK_Request(void);
+
+/** \brief Stops the 1 ms tick once there are no more requests. */
+extern void HAL_TICK_Release(void);
+
+/** \brief Returns platform time in milliseconds.
  *
- * This function is meant to be used for short delays.
+ * Platform time is computed on demand from RTC time, so it needs no periodic
+ * interrupt and continues across deep sleep. RTC has to be initialized and
+ * this function must be called at least once per RTC counter overflow
+ * (approx. 36 hours) to keep time continuous.
  *
- * Platform time uses 32 bit counter incremented 1000x per second.
+ * Platform time uses 32 bit counter of milliseconds.
  * This means that the counter will overflow approximately every 49 days.
  *
  * \returns Current platform time in ms.
@@ -42,9 +42,71 @@
 // <o> APP Task Event Kernel message handler count. <2-64>
 // <i> Maximum number of message handlers that can be assigned to application task.
 // <i> Depends mainly on number of used BLE profiles.
-// <i> Default: 24
+// <i> Default: 32
 #ifndef RTE_APP_TASK_HANDLER_COUNT
-#define RTE_APP_TASK_HANDLER_COUNT       24
+#define RTE_APP_TASK_HANDLER_COUNT       32
+#endif
+
+// <o> Scheduled callback queue size <2-256>
+// <i> Number of callbacks that can wait in BDK_TaskSchedule queue.
+// <i> Must be power of two.
+// <i> Default: 16
+#ifndef RTE_BDK_TASK_QUEUE_SIZE
+#define RTE_BDK_TASK_QUEUE_SIZE          16
+#endif
+
+// <o> Event Callback bucket count <1-256>
+// <i> Registered event callbacks are split into lists by lowest bits of event ID.
+// <i> Must be power of two.
+// <i> Default: 16
+#ifndef RTE_BDK_EVENT_CALLBACK_BUCKETS
+#define RTE_BDK_EVENT_CALLBACK_BUCKETS   16
+#endif
+
+// <e> Tokenized Logging
+// <i> TRACE_PRINTF and CS log messages are stored as format string ID and
+// <i> raw arguments and decoded on host by tools/tlog_decode.py.
+// <i> When disabled messages are formatted by printf.
+#ifndef RTE_BDK_LOG_TOKENIZED
+#define RTE_BDK_LOG_TOKENIZED            1
+#endif
+//   <o> Ring buffer size in 32-bit words
+//   <i> Must be power of two.
+//   <i> Default: 256
+#ifndef RTE_BDK_LOG_BUFFER_WORDS
+#define RTE_BDK_LOG_BUFFER_WORDS         256
+#endif
+//   <o> Output
+//   <i> UART carries binary records, not text. Capture raw bytes and
+//   <i> decode them with tools/tlog_decode.py.
+//   <0=> SEGGER RTT
+//   <1=> UART
+#ifndef RTE_BDK_LOG_OUTPUT
+#define RTE_BDK_LOG_OUTPUT               1
+#endif
+//   <o> Words sent per flush
+//   <i> Bounds the work done by one main loop pass. UART transfer of
+//   <i> these words runs in background.
+//   <i> Default: 32
+#ifndef RTE_BDK_LOG_FLUSH_WORDS
+#define RTE_BDK_LOG_FLUSH_WORDS          32
+#endif
+//   <o> RTT up channel <1-2>
+#ifndef RTE_BDK_LOG_RTT_CHANNEL
+#define RTE_BDK_LOG_RTT_CHANNEL          1
+#endif
+//   <o> RTT up channel buffer size in bytes
+#ifndef RTE_BDK_LOG_RTT_BUFFER_SIZE
+#define RTE_BDK_LOG_RTT_BUFFER_SIZE      512
+#endif
+// </e>
+
+// <q> Cycle Profiler
+// <i> Measure duration of interrupt handlers and other hot code paths with
+// <i> DWT cycle counter. Probes are compiled out when disabled.
+// <i> Default: Disabled
+#ifndef RTE_BDK_PROF_ENABLED
+#define RTE_BDK_PROF_ENABLED             0
 #endif
 
 
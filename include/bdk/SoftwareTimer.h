@@ -48,7 +48,7 @@
  *
  * This corresponds to single TIMERx tick.
  *
- * Resolution determines how often to check active timers expiration.
+ * Resolution determines the shortest time between two timer interrupts.
  */
 #define SW_TIMER_MAX_RESOLUTION        (2)
 
@@ -57,7 +57,7 @@
  * Computed as time elapsed between two timer ticks times size of timer
  * counter.
  *
- * Resolution determines how often to check active timers expiration.
+ * Resolution determines the shortest time between two timer interrupts.
  */
 #define SW_TIMER_MIN_RESOLUTION        (SW_TIMER_TIM1_US_PER_TICK * SW_TIMER_TIM1_MAX_TICKS)
 
@@ -115,8 +115,15 @@ struct SwTimer_Duration {
  * If this function is not called before first timer initialization it will use
  * the default tick resolution.
  *
+ * The hardware timer is programmed as one-shot to the earliest expiration of
+ * timers with attached callbacks, or to SW_TIMER_TIM1_MAX_TICKS if there is
+ * none.
+ * The interrupt executes only the callbacks that are due.
+ *
  * \param resolution_us
  * The minimum time interval that software timers will be able to detect.
+ * Timers expiring sooner than this after the previous interrupt are handled
+ * one resolution later.
  * Minimum value is 2us.
  *
  * \pre
@@ -125,7 +132,7 @@ struct SwTimer_Duration {
  *
  * \note
  * Selecting a high resolution may require higher SYSCLK frequencies to have
- * enough time to check all timers in the interrupt routine.
+ * enough time to execute callbacks of closely spaced timers.
  * See BDK_InitializeFreq on how to set higher SYSCLK frequencies.
  */
 extern void SwTimer_CTX_Initialize(uint32_t resolution_us);
@@ -212,8 +219,7 @@ extern void SwTimer_Remove(struct SwTimer *tim);
  *
  * Callback must execute either of Advance, ExpireIn or Stop functions to clear
  * the timer expiration flag.
- * Failing to do so will result in timer callback being called on every timer
- * tick.
+ * Failing to do so will result in timer callback not being called again.
  *
  * Timers cannot be removed directly from callback function.
  * This operation should be off loaded to application.
@@ -283,9 +289,9 @@ extern void SwTimer_AttachInt(struct SwTimer *tim, SwTimer_Callback callback,
  *
  *
  * \warning
- * Callback functions are executed executed from Event Kernels message queue.
- * This means it will get executed when application calls either Kernel_Schedule
- * or BDK_Schedule functions.
+ * Callback functions are executed from BDK_TaskSchedule queue.
+ * This means it will get executed when application calls either
+ * BDK_TaskRunScheduled or BDK_Schedule functions.
  *
  * Slight delay may be experienced between timer expiring and callback
  * execution. SwTimer_Advance can be used to set next expiration time precisely
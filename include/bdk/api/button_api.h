@@ -121,9 +121,10 @@ extern int32_t BTN_AttachInt(enum BTN_Edge edge, BTN_Callback cb, void *arg,
         ButtonName btn);
 
 /** \brief Attaches and interrupt handler to given button that will be executed
- * by Event Kernel.
+ * from the main loop.
  *
- * Event Kernel events are executed from main loop when BDK_Schedule is called.
+ * Scheduled callbacks are executed from main loop when BDK_Schedule or
+ * BDK_TaskRunScheduled is called.
  *
  * \param edge
  * Determines what kind of event will trigger the attaches callback.
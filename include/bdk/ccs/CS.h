@@ -25,6 +25,7 @@
 
 #include <ccs/CS_Log.h>
 #include <ccs/CS_Providers.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -46,6 +47,29 @@ extern "C"
 /** Maximum number of half words that can be fit inside of a response packet. */
 #define MAX_DATA_LEN_HW 				( CS_MAX_RESPONSE_LENGTH/sizeof(uint16_t) )
 
+/** Number of bits in provider ID, each provider owns one of them. */
+#define CS_PROVIDER_ID_BITS             ( sizeof(CS_Provider) * 8 )
+
+/** Bit of the first byte that marks extended request message.
+ * It is the reserved (configure) bit of the legacy one byte request.
+ */
+#define CS_EXT_FLAG                     (0x80)
+
+/** Version of extended request message format. */
+#define CS_EXT_VERSION                  (1)
+
+/** Length of extended message header, [FLAG | VERSION][SEQ]. */
+#define CS_EXT_HEADER_LENGTH            (2)
+
+/** Length of configuration TLV header, [TYPE][LEN][PID]. */
+#define CS_EXT_TLV_HEADER_LENGTH        (3)
+
+/** Maximum number of configuration TLVs in one extended request. */
+#define CS_EXT_MAX_TLV_COUNT            (6)
+
+/** Length of extended response, [FLAG | VERSION][SEQ][STATUS][TLV INDEX]. */
+#define CS_EXT_RESPONSE_LENGTH          (4)
+
 
 //-----------------------------------------------------------------------------
 // EXPORTED DATA TYPES DEFINITION
@@ -93,7 +117,6 @@ enum CS_PowerMode
  * Bit [0-4]  : Provider ID		        (1 = DMIC, 2 = LCA, 4 = RCA, 8 = LCF, 16 = RCF)
  *
  */
-// TODO: Make provision for changing sampling rate remotely over BLE
 struct CS_Request_Struct
 {
 	/** \brief Bits containing provider ID bit mask.
@@ -162,6 +185,56 @@ enum CS_Reserved
 	N_A = 1
 };
 
+/** \brief Types of configuration TLVs carried by extended request.
+ *
+ * Value of every TLV starts with provider ID bit mask, followed by type
+ * specific parameters in little-endian byte order.
+ */
+enum CS_ConfigType
+{
+	/** Start or stop streams, 1 byte op code (\ref CS_OpCode). */
+	CS_CFG_STREAM      = 1,
+
+	/** Sample rate in Hz, 4 bytes.
+	 * Not supported by any built-in provider yet, reported as
+	 * \ref CS_EXT_ERR_UNSUPPORTED. */
+	CS_CFG_SAMPLE_RATE = 2,
+
+	/** Number of samples per stream packet, 1 byte. */
+	CS_CFG_BLOCK_SIZE  = 3,
+
+	/** Codec identifier, 1 byte. */
+	CS_CFG_CODEC       = 4,
+
+	/** Provider specific gain register value, 2 bytes. */
+	CS_CFG_GAIN        = 5,
+};
+
+/** \brief Status codes of extended response. */
+enum CS_ExtStatus
+{
+	CS_EXT_OK              = 0, /**< All TLVs applied. */
+	CS_EXT_ERR_VERSION     = 1, /**< Unsupported message version. */
+	CS_EXT_ERR_FORMAT      = 2, /**< Malformed message or TLV. */
+	CS_EXT_ERR_PROVIDER    = 3, /**< TLV addresses unknown provider. */
+	CS_EXT_ERR_UNSUPPORTED = 4, /**< Provider does not support TLV type. */
+	CS_EXT_ERR_VALUE       = 5, /**< Provider rejected TLV value. */
+	CS_EXT_ERR_APPLY       = 6, /**< Provider failed to apply validated TLV. */
+};
+
+/** \brief Configuration TLV passed to provider config handler. */
+struct CS_Config_Struct
+{
+	/** \brief Type of configuration, \ref CS_ConfigType. */
+	uint8_t type;
+
+	/** \brief Number of parameter bytes. */
+	uint8_t length;
+
+	/** \brief Type specific parameters. */
+	const uint8_t* value;
+};
+
 
 /** Bitmask encoding for stream provider.
  *
@@ -221,6 +294,22 @@ typedef int (*CS_PowerModeHandler)(enum CS_PowerMode dev_mode);
  */
 typedef void (*CS_PollHandler)(void);
 
+/** \brief Function prototype for provider configuration handler.
+ *
+ * Extended request is applied in two passes. All TLVs are first validated
+ * with apply set to false and applied only if every provider accepted them.
+ *
+ * \param[in] config
+ * Configuration TLV addressed to the provider.
+ *
+ * \param[in] apply
+ * false to only validate the configuration, true to apply it.
+ *
+ * \returns CS_OK when configuration is valid or was applied.
+ * \returns CS_UNSUPPORTED when provider does not support the TLV type.
+ */
+typedef int (*CS_ConfigHandler)(const struct CS_Config_Struct* config, bool apply);
+
 struct CS_Provider_Struct
 {
 	CS_Provider id;
@@ -241,9 +330,18 @@ struct CS_Provider_Struct
 	/** \brief Polling function that is called from main loop to handle internal
 	 * processes of the provider.
 	 *
+	 * It is called only while the provider is streaming and after it signalled
+	 * new data by \ref CS_SignalProvider .
 	 * This function is optional and can be set to NULL if not required.
 	 */
 	CS_PollHandler poll_handler;
+
+	/** \brief Handler of configuration TLVs of extended requests.
+	 *
+	 * This function is optional, configuration TLVs addressed to provider
+	 * without handler are rejected.
+	 */
+	CS_ConfigHandler config_handler;
 };
 
 struct CS_Handle_Struct
@@ -251,9 +349,21 @@ struct CS_Handle_Struct
 	int provider_cnt;
 	struct CS_Provider_Struct* provider[CS_MAX_PROVIDER_COUNT];
 
+	/** \brief Registered providers indexed by bit position of their ID. */
+	struct CS_Provider_Struct* provider_by_bit[CS_PROVIDER_ID_BITS];
+
+	/** \brief Bit mask of IDs of all registered providers. */
+	CS_Provider provider_mask;
+
+	/** \brief Bit mask of IDs of providers that are streaming. */
+	CS_Provider active_mask;
+
 	const char* conf_content;
 	int conf_content_len;
 	int conf_page_cnt;
+
+	/** \brief Request tokens of providers streaming when state was saved. */
+	uint32_t resume_token[CS_MAX_PROVIDER_COUNT];
 };
 
 enum CS_ErrorCodes
@@ -261,7 +371,8 @@ enum CS_ErrorCodes
 	CS_OK          = 0, /* \brief Generic success return value. */
 	CS_ERROR       = 1, /* \brief Generic error return value. */
 	CS_TIMEOUT     = 2,
-	CS_NO_RESPONSE = 3
+	CS_NO_RESPONSE = 3,
+	CS_UNSUPPORTED = 4  /* \brief Configuration type is not supported. */
 };
 
 
@@ -280,9 +391,44 @@ extern int CS_RegisterProvider(struct CS_Provider_Struct* provider);
  */
 extern int CS_ProcessRequest(const struct CS_Request_Struct *request);
 
-/** */
+/** \brief Processes extended request with batch of configuration TLVs.
+ *
+ * Message layout:
+ *
+ *     [CS_EXT_FLAG | version][SEQ] { [TYPE][LEN][PID][parameters] } ...
+ *
+ * LEN covers PID and parameters. TLVs are applied in order only after all of
+ * them were validated. Single response [CS_EXT_FLAG | version][SEQ][STATUS]
+ * [TLV INDEX] is sent back, where TLV INDEX points to TLV that failed.
+ *
+ * \param[in] data
+ * Extended request message.
+ *
+ * \param[in] data_len
+ * Length of the message.
+ */
+extern int CS_ProcessExtRequest(const uint8_t *data, uint8_t data_len);
+
+/** \brief Calls poll handler of every streaming provider that signalled new
+ * data since the last call.
+ */
 extern int CS_PollProviders(void);
 
+/** \brief Requests call of provider poll handler from main loop.
+ *
+ * Can be called from interrupt handlers.
+ *
+ * \param id
+ * ID of the provider that has new data.
+ */
+extern void CS_SignalProvider(CS_Provider id);
+
+/** \brief Checks if any streaming provider waits for its poll handler.
+ *
+ * Main loop must not enter sleep mode while this returns true.
+ */
+extern bool CS_IsPollPending(void);
+
 /**
  *
  * \param response
@@ -294,6 +440,18 @@ extern int CS_InjectResponse(uint16_t response[MAX_DATA_LEN_HW], uint8_t provide
 
 extern int CS_SetPowerMode(enum CS_PowerMode mode);
 
+/** \brief Remembers which providers are streaming and with which op code.
+ *
+ * Called before providers are put to sleep on disconnect.
+ */
+extern int CS_SaveStreamState(void);
+
+/** \brief Restarts streams remembered by \ref CS_SaveStreamState .
+ *
+ * Saved state is consumed, streams are restarted only once.
+ */
+extern int CS_ResumeStreamState(void);
+
 //extern void CS_SetAppConfig(const char* content);
 
 #ifdef __cplusplus
@@ -21,6 +21,11 @@
 //-----------------------------------------------------------------------------
 
 #include "RTE_CS_Feature.h"
+#include "RTE_BDK.h"
+
+#if RTE_BDK_LOG_TOKENIZED == 1
+#include "BDK_Log.h"
+#endif
 
 
 #ifdef __cplusplus
@@ -32,29 +37,42 @@ extern "C" {
 // DEFINES / CONSTANTS
 //-----------------------------------------------------------------------------
 
+// Tokenized messages are prefixed at compile time as format has to be single
+// string literal.
+#define CS_LogTokenized(level, node, fmt, ...) \
+	BDK_LOG_PRINTF("[CS " level "][" node "] " fmt "\r\n", ##__VA_ARGS__)
+
 // Prototype for Node error logging macros
-#ifdef CS_LOG_ERROR_ENABLE
+#if defined CS_LOG_ERROR_ENABLE && RTE_BDK_LOG_TOKENIZED == 1
+#define CS_LogError(node, ...) CS_LogTokenized("ERROR", node, __VA_ARGS__)
+#elif defined CS_LOG_ERROR_ENABLE
 #define CS_LogError(node, ...) CS_Log(CS_LOG_LEVEL_ERROR, node, __VA_ARGS__)
 #else
 #define CS_LogError(node, ...)
 #endif /* CS_LOG_ERROR_ENABLE */
 
 // Prototype for Node warning logging macros
-#ifdef CS_LOG_WARNING_ENABLE
+#if defined CS_LOG_WARNING_ENABLE && RTE_BDK_LOG_TOKENIZED == 1
+#define CS_LogWarning(node, ...) CS_LogTokenized("WARN", node, __VA_ARGS__)
+#elif defined CS_LOG_WARNING_ENABLE
 #define CS_LogWarning(node, ...) CS_Log(CS_LOG_LEVEL_WARNING, node, __VA_ARGS__)
 #else
 #define CS_LogWarning(node, ...)
 #endif /* CS_LOG_WARNING_ENABLE */
 
 // Prototype for Node info logging macros
-#ifdef CS_LOG_INFO_ENABLE
+#if defined CS_LOG_INFO_ENABLE && RTE_BDK_LOG_TOKENIZED == 1
+#define CS_LogInfo(node, ...) CS_LogTokenized("INFO", node, __VA_ARGS__)
+#elif defined CS_LOG_INFO_ENABLE
 #define CS_LogInfo(node, ...) CS_Log(CS_LOG_LEVEL_INFO, node, __VA_ARGS__)
 #else
 #define CS_LogInfo(node, ...)
 #endif /* CS_LOG_INFO_ENABLE */
 
 // Prototype for Node verbose logging macros
-#ifdef CS_LOG_VERBOSE_ENABLE
+#if defined CS_LOG_VERBOSE_ENABLE && RTE_BDK_LOG_TOKENIZED == 1
+#define CS_LogVerbose(node, ...) CS_LogTokenized("VERBOSE", node, __VA_ARGS__)
+#elif defined CS_LOG_VERBOSE_ENABLE
 #define CS_LogVerbose(node, ...) CS_Log(CS_LOG_LEVEL_VERBOSE, node, __VA_ARGS__)
 #else
 #define CS_LogVerbose(node, ...)
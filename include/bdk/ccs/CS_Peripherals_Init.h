@@ -29,6 +29,7 @@
 // Note: initially disabled until required by application
 //-----------------------------------------------------------------------------
 #define AUDIO_DMIC0_GAIN                0x800
+#define AUDIO_DMIC0_GAIN_MAX            0xFFF
 #define AUDIO_CONFIG		             OD_AUDIOSLOWCLK            | \
                                          DMIC_AUDIOCLK              | \
                                          DECIMATE_BY_64             | \
@@ -177,6 +178,9 @@ bool rca_enabled;
 // Status Variables
 bool dmic_buffer_1_full;
 bool dmic_buffer_2_full;
+// Statistics (filled halves, halves overwritten before being sent)
+uint32_t dmic_buffers_captured;
+uint32_t dmic_overruns;
 // Data
 uint32_t* dmic_buffer_1;
 uint32_t* dmic_buffer_2;
@@ -188,6 +192,9 @@ uint8_t dmic_buffer_len;
 // Status Variables
 bool lca_buffer_1_full;
 bool lca_buffer_2_full;
+// Statistics (filled halves, halves overwritten before being sent)
+uint32_t lca_buffers_captured;
+uint32_t lca_overruns;
 // Data
 int16_t* lca_buffer_1;
 int16_t* lca_buffer_2;
@@ -199,6 +206,9 @@ uint8_t lca_buffer_len;
 // Status Variables
 bool rca_buffer_1_full;
 bool rca_buffer_2_full;
+// Statistics (filled halves, halves overwritten before being sent)
+uint32_t rca_buffers_captured;
+uint32_t rca_overruns;
 // Data
 int16_t* rca_buffer_1;
 int16_t* rca_buffer_2;
@@ -36,6 +36,25 @@ extern "C" {
 struct CS_Handle_Struct;
 
 
+//-----------------------------------------------------------------------------
+// EXPORTED TYPES
+//-----------------------------------------------------------------------------
+
+/** \brief Transmit counters of one stream provider. */
+struct CS_PlatformStreamStats
+{
+    /** \brief Packets accepted by the transport. */
+    uint32_t sent;
+
+    /** \brief Packets dropped because of full transmit queue or missing
+     * credits. */
+    uint32_t dropped;
+
+    /** \brief Packets rejected for any other reason, e.g. no connection. */
+    uint32_t failed;
+};
+
+
 //-----------------------------------------------------------------------------
 // EXPORTED FUNCTION DECLARATIONS
 //-----------------------------------------------------------------------------
@@ -67,10 +86,52 @@ extern int CS_PlatformWriteBytes(const uint16_t* tx_data_buf, int tx_data_buf_le
  */
 extern int CS_PlatformWriteString(const char* tx_data, int tx_data_len, uint8_t provider_id);
 
+/** \brief Platform specific callback for sending of stream data.
+ *
+ * Stream data are sent over bulk transport when it is available, otherwise
+ * over CCS characteristic assigned to the provider. Centrals subscribed to
+ * the MUX characteristic receive data of all providers packed into MTU sized
+ * notifications instead.
+ * With RTE_APP_CCS_RTT_ENABLED every packet is also written into SEGGER RTT
+ * capture channel, or only there if RTE_APP_CCS_RTT_ONLY is set.
+ *
+ * \param tx_data
+ * Data buffer which will be sent over BLE. Buffer is referenced by the read
+ * cache of provider characteristic and has to remain valid until the next
+ * packet of the same provider.
+ * \param tx_data_len
+ * Number of bytes to be sent. Max 20 bytes are allowed.
+ * \returns
+ * 0 on success.
+ * -1 on failure.
+ */
+extern int CS_PlatformWriteStream(const uint8_t* tx_data, int tx_data_len, uint8_t provider_id);
+
+/** \brief Returns transmit counters of stream packets of given provider.
+ *
+ * Counters are updated by \ref CS_PlatformWriteStream and never cleared.
+ */
+extern const struct CS_PlatformStreamStats* CS_PlatformGetStreamStats(uint8_t provider_id);
+
 
-/** \brief Returns current platform time in milliseconds. */
+/** \brief Returns current platform time in milliseconds.
+ *
+ * Time continues across deep sleep.
+ */
 extern uint32_t CS_PlatformTime();
 
+/** \brief Lights board LED for given time without blocking.
+ *
+ * Used by providers to acknowledge requests. Indications are queued and
+ * played one after another.
+ *
+ * \param led
+ * LedName of the board.
+ * \param duration_ms
+ * Time the LED is on.
+ */
+extern void CS_PlatformIndicate(uint8_t led, uint16_t duration_ms);
+
 /** \brief Provides printf like functionality for logging purposes. */
 extern void CS_PlatformLogPrintf(const char* fmt, ...);
 
@@ -35,6 +35,20 @@ extern "C" {
 
 // ----------------------------------------------------------- Timer structures
 
+/**
+ * Number of expiring timers a context keeps ordered by deadline. Timers
+ * scheduled above this count are still handled, but found by a linear search.
+ */
+#ifndef STIMER_HEAP_SIZE
+#define STIMER_HEAP_SIZE                16
+#endif
+
+/** Heap index of a timer that has no deadline scheduled */
+#define STIMER_HEAP_NONE                (-1)
+
+/** Heap index of a timer with deadline that did not fit into the heap */
+#define STIMER_HEAP_OVERFLOW            (-2)
+
 /**
  * @brief Function pointer prototype for getting the current time
  * @details The returned time must be an incrementing type, starting at 0,
@@ -76,6 +90,17 @@ struct stimer_ctx {
     // Time function
     stimer_get_time_fn                  get_time_fn;
     void *                              hint;
+
+
+    // Monotonic time in get_time_fn ticks extended from get_time_fn values
+    uint64_t                            now;
+    uint32_t                            last_time;
+
+
+    // Binary min-heap of expiring timers ordered by deadline
+    struct stimer *                     heap[STIMER_HEAP_SIZE];
+    uint16_t                            heap_size;
+    uint16_t                            heap_overflow;
 };
 
 
@@ -89,17 +114,26 @@ struct stimer {
     struct stimer *                     next;
 
 
-    // Last get_time_fn checkpoint
-    uint32_t                            checkpoint;
+    // Context time of the last checkpoint
+    uint64_t                            checkpoint;
 
 
-    // Expire period
-    struct stimer_duration              expire_interval;
+    // Expire period in get_time_fn ticks
+    uint64_t                            expire_interval;
 
 
-    // Elapsed time
-    struct stimer_duration              elapsed;
+    // Elapsed time in get_time_fn ticks
+    uint64_t                            elapsed;
     bool                                is_running;
+
+
+    // Expiration in monotonic context time and position in deadline heap
+    uint64_t                            deadline;
+    int16_t                             heap_index;
+
+
+    // Tolerated expiration delay in get_time_fn ticks
+    uint64_t                            slack;
 };
 
 
@@ -154,11 +188,13 @@ stimer_free_context(struct stimer_ctx * ctx);
 
 /**
  * @brief Periodic call to drive all of the timers
- * @details This must be called periodically to increment the timers. This must
- *          be called at a rate at least 4 times faster than the get_time_fn
- *          value rollover. Optionally, this can be skipped if you know that
- *          all timers in use are periodically checked at least 4 times faster
- *          the get_time_fn value rollover
+ * @details This must be called periodically to extend the get_time_fn value
+ *          into the 64 bit context time that all timers are measured in. This
+ *          must be called at a rate at least 4 times faster than the
+ *          get_time_fn value rollover. Optionally, this can be skipped if you
+ *          know that any timer of the context is periodically checked at
+ *          least 4 times faster the get_time_fn value rollover.
+ *          The call takes constant time regardless of the number of timers.
  *
  * @param ctx Timer context to execute
  */
@@ -166,6 +202,39 @@ void
 stimer_execute_context(struct stimer_ctx * ctx);
 
 
+/**
+ * @brief Gets the running timer that expires first
+ * @details Only timers with a non-zero expiration period are considered.
+ *          Calling this periodically replaces stimer_execute_context.
+ *
+ * @param ctx Timer context
+ * @param counts Optional, receives number of get_time_fn ticks until the
+ *          timer expires, or 0 if it has expired already
+ * @return Timer handle, or NULL if no timer is set to expire
+ */
+struct stimer *
+stimer_get_next_expiry(struct stimer_ctx * ctx, uint64_t * counts);
+
+
+/**
+ * @brief Gets the latest wake up that serves the first expiring timer
+ * @details Every timer tolerates expiring up to its slack late. The wake up
+ *          is the earliest deadline plus slack over all timers, so that every
+ *          timer with deadline before it is served by a single wake up. Cost
+ *          is proportional to the number of served timers.
+ *
+ * @param ctx Timer context
+ * @param counts Receives number of get_time_fn ticks until the wake up, or 0
+ *          if it is due already
+ * @param timers Optional, receives number of timers that expire by the wake up
+ * @return true if any timer is set to expire, else false
+ */
+bool
+stimer_get_coalesced_wakeup(struct stimer_ctx * ctx,
+                            uint64_t * counts,
+                            uint16_t * timers);
+
+
 // --------------------------------------------------------------- Timer handle
 
 /**
@@ -203,6 +272,51 @@ stimer_free(struct stimer * ts);
 void
 stimer_remove(struct stimer * ts);
 
+/**
+ * @brief Sets how late the timer may expire to share a wake up
+ * @details Slack only affects stimer_get_coalesced_wakeup, the timer still
+ *          reports expired at its exact deadline. Slack is kept when the timer
+ *          is started again.
+ *
+ * @param ts Timer handle
+ * @param t Tolerated expiration delay
+ */
+void
+stimer_set_slack(struct stimer * ts, struct stimer_duration * t);
+
+
+/**
+ * @brief Sets how late the timer may expire to share a wake up
+ *
+ * @param ts Timer handle
+ * @param ms Tolerated expiration delay in milliseconds
+ */
+void
+stimer_set_slack_ms(struct stimer * ts, uint32_t ms);
+
+
+/**
+ * @brief Stops reporting an expired timer by stimer_get_next_expiry
+ * @details The timer keeps running and stimer_is_expired still reports it
+ *          expired. This lets a driver that is woken up at the next expiry
+ *          handle every expired timer just once. The timer is reported again
+ *          once its expiration is set, or by calling stimer_arm.
+ *
+ * @param ts Timer handle
+ */
+void
+stimer_disarm(struct stimer * ts);
+
+
+/**
+ * @brief Reports the timer by stimer_get_next_expiry again
+ * @details Undoes stimer_disarm without changing the expiration time.
+ *
+ * @param ts Timer handle
+ */
+void
+stimer_arm(struct stimer * ts);
+
 // ---------------------------------------------------- Elapsed timer functions
 
 /**
@@ -238,6 +352,18 @@ void
 stimer_get_elapsed_time(struct stimer * ts, struct stimer_duration * t);
 
 
+/**
+ * @brief Gets the amount of time elapsed on a timer in get_time_fn ticks
+ * @details Same as stimer_get_elapsed_time without conversion to seconds and
+ *          nanoseconds
+ *
+ * @param ts Timer handle
+ * @return Elapsed get_time_fn ticks
+ */
+uint64_t
+stimer_get_elapsed_counts(struct stimer * ts);
+
+
 // ----------------------------------------------------- Expire timer functions
 
 /**
@@ -290,6 +416,16 @@ void
 stimer_expire_from_now_ns(struct stimer * ts, uint32_t ns);
 
 
+/**
+ * @brief Sets the timer up to expire at a point in time from now
+ *
+ * @param ts Timer handle
+ * @param counts get_time_fn ticks until expiration
+ */
+void
+stimer_expire_from_now_counts(struct stimer * ts, uint64_t counts);
+
+
 /**
  * @brief Checks if a timer has expired
  *
@@ -141,10 +141,12 @@ uint32_t HAL_RTC_GetTime(void * hint)
     uint32_t count_check;
     uint32_t count2;
     bool rtc_alarm_pending;
+    uint32_t primask = __get_PRIMASK();
 
     // BEGIN CRITICAL SECTION
 
     // Disable all interrupts to make sure this part of code is not preempted.
+    // Caller may have masked interrupts already, e.g. around WFI.
     __disable_irq();
 
     // Read RTC_COUNT value for counter reload test
@@ -173,8 +175,8 @@ uint32_t HAL_RTC_GetTime(void * hint)
     // Set checkpoint to last read counter value.
     rtc_checkpoint = count2;
 
-    // Reenable interrupts after overflow checks are done.
-    __enable_irq();
+    // Restore interrupt mask after overflow checks are done.
+    __set_PRIMASK(primask);
 
     // END CRITICAL SECTION
 
@@ -216,6 +218,7 @@ void HAL_RTC_SetAlarmTicks(uint32_t ticks)
     uint32_t count_check;
     uint32_t count2;
     bool rtc_alarm_pending;
+    uint32_t primask = __get_PRIMASK();
 
     // BEGIN CRITICAL SECTION
 
@@ -254,7 +257,7 @@ void HAL_RTC_SetAlarmTicks(uint32_t ticks)
 
     // END CRITICAL SECTION
 
-    __enable_irq();
+    __set_PRIMASK(primask);
 
 #ifdef _HAL_RTC_DEBUG
         TRACE_PRINTF("%s:%d: TIME=%lu, CFG=%lu COUNT=%lu\r\n", __FUNCTION__,
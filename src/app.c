@@ -24,14 +24,12 @@ int main(void)
     Device_Initialize();
 
     /* Indication - Initialization complete. */
-    LED_On(LED_GREEN);
-    HAL_Delay(250);
-    LED_Off(LED_GREEN);
+    App_LedBlink(LED_GREEN, 250, 0, 1);
 
     Main_Loop();
 }
 
-static void App_StateMachine(void)
+void App_StateMachine(void)
 {
     switch (app_state)
     {
@@ -39,6 +37,9 @@ static void App_StateMachine(void)
         TRACE_PRINTF("State: Init\r\n");
 
         stimer_init(&app_state_timer, Timer_GetContext());
+        stimer_set_slack_ms(&app_state_timer, RTE_APP_TIMER_SLACK);
+        App_AdvInitialize();
+        App_DiagInitialize();
         /* no break */
     case APP_STATE_START_ADVERTISING:
         TRACE_PRINTF("State: Advertising start\r\n");
@@ -47,13 +48,12 @@ static void App_StateMachine(void)
         // for RTE_APP_ADV_DISABLE_TIMEOUT seconds.
         stimer_expire_from_now_s(&app_state_timer, RTE_APP_ADV_DISABLE_TIMEOUT);
 
-        // Start BLE advertising
+        // Start BLE advertising with fast burst.
+        App_AdvStart();
         BDK_BLE_AdvertisingStart();
 
         // Signal to user.
-        LED_On(LED_GREEN);
-        HAL_Delay(APP_STATE_IND_LED_INTERVAL_MS);
-        LED_Off(LED_GREEN);
+        App_LedBlink(LED_GREEN, APP_STATE_IND_LED_INTERVAL_MS, 0, 1);
 
         app_state = APP_STATE_ADVERTISING;
         break;
@@ -61,6 +61,9 @@ static void App_StateMachine(void)
     case APP_STATE_ADVERTISING:
         TRACE_PRINTF("State: Advertising\r\n");
 
+        // Slow down advertising once the current phase has elapsed.
+        App_AdvUpdate();
+
         // Check if advertisement stop timeout has elapsed.
         if (stimer_is_expired(&app_state_timer) == true)
         {
@@ -70,11 +73,10 @@ static void App_StateMachine(void)
                     RTE_APP_BTN_CHECK_TIMEOUT);
 
             // Stop advertising
+            App_AdvStop();
             BDK_BLE_AdvertisingStop();
 
-            LED_On(LED_RED);
-            HAL_Delay(APP_STATE_IND_LED_INTERVAL_MS);
-            LED_Off(LED_RED);
+            App_LedBlink(LED_RED, APP_STATE_IND_LED_INTERVAL_MS, 0, 1);
 
             // Enter sleep state
             app_state = APP_STATE_SLEEP;
@@ -97,13 +99,12 @@ static void App_StateMachine(void)
             stimer_expire_from_now_s(&app_state_timer,
                     RTE_APP_ADV_DISABLE_TIMEOUT);
 
-            // Start BLE advertising
+            // Start BLE advertising with fast burst.
+            App_AdvStart();
             BDK_BLE_AdvertisingStart();
 
             // Signal wake up event to user.
-            LED_On(LED_GREEN);
-            HAL_Delay(APP_STATE_IND_LED_INTERVAL_MS);
-            LED_Off(LED_GREEN);
+            App_LedBlink(LED_GREEN, APP_STATE_IND_LED_INTERVAL_MS, 0, 1);
 
             app_state = APP_STATE_ADVERTISING;
         }
@@ -121,7 +122,11 @@ static void App_StateMachine(void)
 
     case APP_STATE_CONNECTED:
         TRACE_PRINTF("State: Connected\r\n");
-        // Nothing to do, wait for peer device to disconnect.
+
+        // Stop advertising for remaining connection slot once it times out.
+        App_AdvUpdate();
+
+        // Wait for peer device to disconnect.
         // Next state change will be from peer device disconnect hook.
         break;
     }
@@ -130,6 +135,7 @@ static void App_StateMachine(void)
 void Main_Loop(void)
 {
     bool sleep_allowed = false;
+    int32_t timer_event;
 
     TRACE_PRINTF("Main_Loop: Enter\r\n");
 
@@ -137,17 +143,21 @@ void Main_Loop(void)
     {
         /* Refresh watchdog timer. */
         Sys_Watchdog_Refresh();
+        App_DiagWatchdogRefresh();
 
-        CS_PollProviders();
-
-        /* Execute any events that have occurred. */
-        Kernel_Schedule();
-
-        /* Application stuff follows here. */
-        App_StateMachine();
+        /* Streams, kernel events, application and log flush in order of
+         * priority, streams signalled meanwhile are served first. */
+        App_SchedRun();
 
         /* Set RTC wake up event to nearest timer. */
-        if ( Timer_SetWakeupAtNextEvent() != APP_TIMER_ALARM_NOW)
+        BDK_PROF_START(BDK_PROF_TIMER_WAKEUP);
+        timer_event = Timer_SetWakeupAtNextEvent();
+        BDK_PROF_STOP(BDK_PROF_TIMER_WAKEUP);
+
+        /* Deep sleep waits for the log transfer, UART is de-initialized
+         * below. */
+        if (timer_event != APP_TIMER_ALARM_NOW && App_SchedIsPending() == false
+                && TRACE_IS_BUSY() == false)
         {
             /* Prepare device for entering deep sleep mode. */
             trace_deinit();
@@ -157,6 +167,7 @@ void Main_Loop(void)
              * BLE_Power_Mode_Enter will not return when deep sleep is
              * entered. */
             __disable_irq();
+            App_EnergyEnter(APP_POWER_SLEEP);
             sleep_allowed = BLE_Power_Mode_Enter(&sleep_mode_env,
                     POWER_MODE_SLEEP);
             __enable_irq();
@@ -166,11 +177,21 @@ void Main_Loop(void)
             trace_init();
             if (sleep_allowed == false)
             {
+                App_EnergySleepRefused();
                 TRACE_PRINTF("Main_Loop: sleep not allowed\r\n");
             }
         }
 
-        /* Enter sleep mode until an interrupt occurs. */
-        SYS_WAIT_FOR_INTERRUPT;
+        /* Enter sleep mode until an interrupt occurs.
+         * Interrupts are masked so that stream signalled or callback
+         * scheduled after the check still wakes the core up. */
+        __disable_irq();
+        if (App_SchedIsPending() == false)
+        {
+            App_EnergyEnter(APP_POWER_WFI);
+            SYS_WAIT_FOR_INTERRUPT;
+            App_EnergyEnter(APP_POWER_RUN);
+        }
+        __enable_irq();
     }
 }
@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#include "app.h"
+#include "RTE_app_config.h"
+
+/** Converts interval in ms to advertising interval units of 0.625 ms. */
+#define APP_ADV_MS_TO_INT(ms)          ((uint16_t)(((ms) * 8) / 5))
+
+struct App_AdvPhaseConfig
+{
+    uint16_t int_min_ms;
+    uint16_t int_max_ms;
+    uint32_t duration_s; /**< 0 - phase lasts until advertising stops */
+};
+
+static const struct App_AdvPhaseConfig adv_phase_cfg[APP_ADV_PHASE_NB] = {
+    [APP_ADV_PHASE_FAST] = {
+        RTE_APP_ADV_FAST_INT_MIN, RTE_APP_ADV_FAST_INT_MAX,
+        RTE_APP_ADV_FAST_DURATION
+    },
+    [APP_ADV_PHASE_MEDIUM] = {
+        RTE_APP_ADV_MEDIUM_INT, RTE_APP_ADV_MEDIUM_INT,
+        RTE_APP_ADV_MEDIUM_DURATION
+    },
+    [APP_ADV_PHASE_SLOW] = {
+        RTE_APP_BLE_ADV_INT, RTE_APP_BLE_ADV_INT, 0
+    }
+};
+
+static struct stimer adv_phase_timer;
+static struct stimer adv_session_timer;
+static enum App_AdvPhase adv_phase = APP_ADV_PHASE_SLOW;
+static bool adv_session_active = false;
+static bool adv_slot_open = false; /**< Advertising for remaining slot */
+static struct App_AdvStats adv_stats = { 0 };
+
+static void App_AdvEnterPhase(enum App_AdvPhase phase)
+{
+    const struct App_AdvPhaseConfig *cfg = &adv_phase_cfg[phase];
+
+    adv_phase = phase;
+
+    BDK_BLE_SetAdvertisementInterval(APP_ADV_MS_TO_INT(cfg->int_min_ms),
+            APP_ADV_MS_TO_INT(cfg->int_max_ms));
+
+    if (cfg->duration_s > 0)
+    {
+        stimer_expire_from_now_s(&adv_phase_timer, cfg->duration_s);
+    }
+    else
+    {
+        stimer_stop(&adv_phase_timer);
+    }
+
+    TRACE_PRINTF("Advertising phase %d: %u-%u ms\r\n", phase,
+            cfg->int_min_ms, cfg->int_max_ms);
+}
+
+static void App_AdvOpenSlot(void)
+{
+    /* Remaining connection slots are offered with the slow interval for
+     * RTE_APP_ADV_DISABLE_TIMEOUT. */
+    App_AdvEnterPhase(APP_ADV_PHASE_SLOW);
+    if (BDK_BLE_GetConnectionCount() < BDK_BLE_MASTER_MAX)
+    {
+        stimer_expire_from_now_s(&adv_phase_timer,
+                RTE_APP_ADV_DISABLE_TIMEOUT);
+        adv_slot_open = true;
+    }
+}
+
+void App_AdvInitialize(void)
+{
+    stimer_init(&adv_phase_timer, Timer_GetContext());
+    stimer_set_slack_ms(&adv_phase_timer, RTE_APP_TIMER_SLACK);
+    stimer_init(&adv_session_timer, Timer_GetContext());
+
+    adv_stats.min_ttc_ms = UINT32_MAX;
+}
+
+void App_AdvStart(void)
+{
+    adv_slot_open = false;
+
+#if RTE_APP_ADV_ADAPTIVE_ENABLED == 1
+    App_AdvEnterPhase(APP_ADV_PHASE_FAST);
+#else
+    App_AdvEnterPhase(APP_ADV_PHASE_SLOW);
+#endif
+
+    /* Session timer has no expiration, it only measures time to connect. */
+    stimer_start(&adv_session_timer);
+    adv_session_active = true;
+    adv_stats.sessions += 1;
+}
+
+void App_AdvUpdate(void)
+{
+    /* Remaining connection slot is not offered forever. */
+    if (adv_slot_open == true && stimer_is_expired(&adv_phase_timer) == true)
+    {
+        adv_slot_open = false;
+        stimer_stop(&adv_phase_timer);
+        BDK_BLE_AdvertisingStop();
+
+        TRACE_PRINTF("Advertising for remaining slot timed out\r\n");
+    }
+
+    if (adv_session_active == true && adv_phase < APP_ADV_PHASE_SLOW
+            && stimer_is_expired(&adv_phase_timer) == true)
+    {
+        /* Reconnect window for bonded device ends with the fast phase. */
+        if (adv_phase == APP_ADV_PHASE_FAST)
+        {
+            BDK_BLE_EndReconnect();
+        }
+
+        App_AdvEnterPhase(adv_phase + 1);
+    }
+}
+
+void App_AdvStop(void)
+{
+    adv_slot_open = false;
+    BDK_BLE_EndReconnect();
+    stimer_stop(&adv_phase_timer);
+    stimer_stop(&adv_session_timer);
+    adv_session_active = false;
+}
+
+void App_AdvConnected(void)
+{
+    struct stimer_duration ttc;
+    uint32_t ttc_ms;
+
+    /* Central connected to the remaining slot, stack stops advertising. */
+    adv_slot_open = false;
+
+    if (adv_session_active == false)
+    {
+        return;
+    }
+
+    stimer_get_elapsed_time(&adv_session_timer, &ttc);
+    ttc_ms = ttc.seconds * 1000 + ttc.nanoseconds / 1000000;
+
+    adv_stats.connections[adv_phase] += 1;
+    adv_stats.last_ttc_ms = ttc_ms;
+    if (ttc_ms < adv_stats.min_ttc_ms)
+    {
+        adv_stats.min_ttc_ms = ttc_ms;
+    }
+    if (ttc_ms > adv_stats.max_ttc_ms)
+    {
+        adv_stats.max_ttc_ms = ttc_ms;
+    }
+
+    TRACE_PRINTF("Time to connect: %lu ms (phase %d, session %lu)\r\n",
+            ttc_ms, adv_phase, adv_stats.sessions);
+
+    App_AdvStop();
+    App_AdvOpenSlot();
+}
+
+void App_AdvSlotReleased(void)
+{
+    /* Session of the last wake up has already ended, only the slot window
+     * is restarted. */
+    App_AdvOpenSlot();
+}
+
+const struct App_AdvStats * App_AdvGetStats(void)
+{
+    return &adv_stats;
+}
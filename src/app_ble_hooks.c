@@ -14,20 +14,46 @@
 #include <stdio.h>
 
 #include "app.h"
+#include "RTE_app_config.h"
 
 
 void App_PeerDeviceConnected(void)
 {
     TRACE_PRINTF("PEER DEVICE CONNECTED\r\n");
 
-    app_state = APP_STATE_CONNECTED;
+    App_AdvConnected();
+
+    // Advertising timeout timer is stopped in the start connection state.
+    app_state = APP_STATE_START_CONNECTION;
 }
 
 void App_PeerDeviceDisconnected(void)
 {
     TRACE_PRINTF("PEER DEVICE DISCONNECTED\r\n");
 
+#if RTE_APP_BLE_AUTO_RESUME_ENABLED == 1
+    // Remember active streams for bonded device that reconnects.
+    CS_SaveStreamState();
+#endif
+
     CS_SetPowerMode(CS_POWER_MODE_SLEEP);
 
     app_state = APP_STATE_START_ADVERTISING;
 }
+
+void App_PeerDeviceSlotReleased(void)
+{
+    TRACE_PRINTF("PEER DEVICE DISCONNECTED, SLOT RELEASED\r\n");
+
+    // Other peer device stays connected, stack advertises the freed slot.
+    App_AdvSlotReleased();
+}
+
+void App_BondedPeerReconnected(void)
+{
+    TRACE_PRINTF("BONDED PEER DEVICE RECONNECTED\r\n");
+
+#if RTE_APP_BLE_AUTO_RESUME_ENABLED == 1
+    CS_ResumeStreamState();
+#endif
+}
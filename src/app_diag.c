@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <BDK_Log.h>
+#include <ccs/CS_Platform.h>
+#include <ccs/CS_Peripherals_Init.h>
+
+#include "app.h"
+#include "RTE_app_config.h"
+
+/** Number of histogram bins printed in one trace message. */
+#define APP_DIAG_HIST_PER_LINE         (4)
+
+/** Length of per connection block of system page. */
+#define APP_DIAG_LINK_LENGTH           (15)
+
+/** Audio stream counters maintained by interrupt handlers. */
+struct App_DiagStream
+{
+    uint8_t provider;
+    const uint32_t *captured;
+    const uint32_t *overruns;
+    const uint8_t *buffer_len;
+};
+
+static const struct App_DiagStream diag_streams[] = {
+    { CSP_DMIC_ID, &dmic_buffers_captured, &dmic_overruns, &dmic_buffer_len },
+    { CSP_LCA_ID, &lca_buffers_captured, &lca_overruns, &lca_buffer_len },
+    { CSP_RCA_ID, &rca_buffers_captured, &rca_overruns, &rca_buffer_len }
+};
+
+/* Kept in retained RAM over deep sleep. */
+static uint32_t diag_wdt_refreshes = 0;
+
+#if RTE_BDK_PROF_ENABLED == 1 && RTE_APP_DIAG_PROF_REPORT_INTERVAL > 0
+static struct stimer diag_report_timer;
+#endif
+
+static uint8_t App_DiagPut16(uint8_t *value, uint16_t data)
+{
+    memcpy(value, &data, sizeof(data));
+    return sizeof(data);
+}
+
+static uint8_t App_DiagPut32(uint8_t *value, uint32_t data)
+{
+    memcpy(value, &data, sizeof(data));
+    return sizeof(data);
+}
+
+/** Converts RTC ticks to milliseconds. */
+static uint32_t App_DiagTicksToMs(uint64_t ticks)
+{
+    return (uint32_t)(ticks * 1000 / HAL_RTC_XTAL_FREQ);
+}
+
+static uint8_t App_DiagReadSystem(uint8_t *value)
+{
+    const struct BLE_LECB_Resources *lecb = BLE_LECB_GetResources();
+    uint32_t log_high_water = BDK_LogGetHighWater();
+    uint8_t len = 0;
+
+    value[len++] = APP_DIAG_COUNTERS_VERSION;
+    value[len++] = BDK_BLE_GetConnectionCount();
+    len += App_DiagPut32(&value[len],
+            (uint32_t)(App_EnergyGetUptime() / HAL_RTC_XTAL_FREQ));
+    len += App_DiagPut32(&value[len], diag_wdt_refreshes);
+    len += App_DiagPut32(&value[len],
+            App_EnergyGetWakeups(APP_ENERGY_WAKEUP_SRC_NB));
+    len += App_DiagPut32(&value[len], App_EnergyGetSleepEntries());
+    len += App_DiagPut32(&value[len], App_EnergyGetSleepRefused());
+    len += App_DiagPut32(&value[len], App_DiagTicksToMs(
+            App_EnergyGetResidency(APP_POWER_SLEEP, APP_ENERGY_ALL_STATES)));
+    len += App_DiagPut16(&value[len],
+            (log_high_water > UINT16_MAX) ? UINT16_MAX : log_high_water);
+    len += App_DiagPut32(&value[len], BDK_LogGetDropped());
+    value[len++] = lecb->tx_pending_max;
+    len += App_DiagPut32(&value[len], lecb->frames_dropped);
+
+    for (uint8_t slot = 0; slot < BDK_BLE_MASTER_MAX; ++slot)
+    {
+        const struct BDK_BLE_ConParam *param = BDK_BLE_GetConParam(slot);
+        const struct BLE_CCS_Connection *con = BLE_CCS_GetConnection(slot);
+
+        if (param == NULL || con == NULL)
+        {
+            memset(&value[len], 0, APP_DIAG_LINK_LENGTH);
+            len += APP_DIAG_LINK_LENGTH;
+            continue;
+        }
+
+        len += App_DiagPut16(&value[len], param->interval);
+        len += App_DiagPut16(&value[len], param->latency);
+        len += App_DiagPut16(&value[len], param->sup_to);
+        value[len++] = param->tx_phy;
+        value[len++] = param->rx_phy;
+        len += App_DiagPut16(&value[len], con->mtu);
+        value[len++] = con->tx_pending_max;
+        len += App_DiagPut32(&value[len], con->tx_dropped);
+    }
+
+    return len;
+}
+
+static uint8_t App_DiagReadStreams(uint8_t *value)
+{
+    const struct App_DiagStream *stream;
+    const struct CS_PlatformStreamStats *stats;
+    uint8_t len = 0;
+
+    value[len++] = APP_DIAG_COUNTERS_VERSION;
+    value[len++] = sizeof(diag_streams) / sizeof(diag_streams[0]);
+
+    for (uint8_t i = 0; i < sizeof(diag_streams) / sizeof(diag_streams[0]);
+            ++i)
+    {
+        stream = &diag_streams[i];
+        stats = CS_PlatformGetStreamStats(stream->provider);
+
+        value[len++] = stream->provider;
+        len += App_DiagPut32(&value[len],
+                *stream->captured * *stream->buffer_len);
+        len += App_DiagPut32(&value[len], *stream->overruns);
+        len += App_DiagPut32(&value[len], stats->sent);
+        len += App_DiagPut32(&value[len], stats->dropped);
+        len += App_DiagPut32(&value[len], stats->failed);
+    }
+
+    return len;
+}
+
+static uint8_t App_DiagReadEnergy(uint8_t *value)
+{
+    uint8_t len = 0;
+
+    value[len++] = APP_DIAG_COUNTERS_VERSION;
+    value[len++] = APP_STATE_NB;
+    value[len++] = APP_POWER_STATE_NB;
+    len += App_DiagPut32(&value[len], App_EnergyGetAverageCurrent());
+
+    for (uint8_t i = 0; i < APP_ENERGY_WAKEUP_SRC_NB; ++i)
+    {
+        len += App_DiagPut32(&value[len], App_EnergyGetWakeups(i));
+    }
+    len += App_DiagPut32(&value[len], Timer_GetWakeupsAvoided());
+
+    for (uint8_t state = 0; state < APP_STATE_NB; ++state)
+    {
+        for (uint8_t power = 0; power < APP_POWER_STATE_NB; ++power)
+        {
+            len += App_DiagPut32(&value[len], App_DiagTicksToMs(
+                    App_EnergyGetResidency(power, state)));
+        }
+    }
+
+    return len;
+}
+
+static uint8_t App_DiagReadSched(uint8_t *value)
+{
+    uint8_t len = 0;
+
+    value[len++] = APP_DIAG_COUNTERS_VERSION;
+    value[len++] = APP_SCHED_TASK_NB;
+
+    for (uint8_t task = 0; task < APP_SCHED_TASK_NB; ++task)
+    {
+        len += App_DiagPut32(&value[len], App_SchedGetOverruns(task));
+        len += App_DiagPut32(&value[len], App_SchedGetMaxTicks(task));
+    }
+
+    return len;
+}
+
+static uint8_t App_DiagReadProfile(enum BDK_ProfProbe probe, uint8_t *value)
+{
+    const struct BDK_ProfStats *stats = BDK_ProfGetStats(probe);
+    uint8_t len = 0;
+    uint16_t bin;
+
+    value[len++] = probe;
+    value[len++] = BDK_PROF_HIST_BINS;
+    len += App_DiagPut32(&value[len], stats->count);
+    len += App_DiagPut32(&value[len], stats->min);
+    len += App_DiagPut32(&value[len], stats->max);
+    len += App_DiagPut32(&value[len],
+            (stats->count > 0) ? (uint32_t)(stats->sum / stats->count) : 0);
+
+    for (uint8_t i = 0; i < BDK_PROF_HIST_BINS; ++i)
+    {
+        bin = (stats->hist[i] > UINT16_MAX) ? UINT16_MAX : stats->hist[i];
+        memcpy(&value[len], &bin, sizeof(bin));
+        len += sizeof(bin);
+    }
+
+    return len;
+}
+
+static uint8_t App_DiagRead(uint8_t page, uint8_t *value)
+{
+    if (page == APP_DIAG_PAGE_SYSTEM)
+    {
+        return App_DiagReadSystem(value);
+    }
+
+    if (page == APP_DIAG_PAGE_STREAMS)
+    {
+        return App_DiagReadStreams(value);
+    }
+
+    if (page == APP_DIAG_PAGE_ENERGY)
+    {
+        return App_DiagReadEnergy(value);
+    }
+
+    if (page == APP_DIAG_PAGE_SCHED)
+    {
+        return App_DiagReadSched(value);
+    }
+
+    if (page >= APP_DIAG_PAGE_PROF
+            && page < APP_DIAG_PAGE_PROF + BDK_PROF_PROBE_NB)
+    {
+        return App_DiagReadProfile(page - APP_DIAG_PAGE_PROF, value);
+    }
+
+    return 0;
+}
+
+void App_DiagInitialize(void)
+{
+    BLE_CCS_SetDiagHandler(&App_DiagRead);
+
+#if RTE_BDK_PROF_ENABLED == 1 && RTE_APP_DIAG_PROF_REPORT_INTERVAL > 0
+    stimer_init(&diag_report_timer, Timer_GetContext());
+    stimer_set_slack_ms(&diag_report_timer, RTE_APP_TIMER_SLACK);
+    stimer_expire_from_now_s(&diag_report_timer,
+            RTE_APP_DIAG_PROF_REPORT_INTERVAL);
+#endif
+}
+
+void App_DiagUpdate(void)
+{
+#if RTE_BDK_PROF_ENABLED == 1 && RTE_APP_DIAG_PROF_REPORT_INTERVAL > 0
+    if (stimer_is_expired(&diag_report_timer) == true)
+    {
+        App_DiagReportProfile();
+        stimer_expire_from_now_s(&diag_report_timer,
+                RTE_APP_DIAG_PROF_REPORT_INTERVAL);
+    }
+#endif
+}
+
+void App_DiagReportProfile(void)
+{
+    for (uint8_t probe = 0; probe < BDK_PROF_PROBE_NB; ++probe)
+    {
+        const struct BDK_ProfStats *stats = BDK_ProfGetStats(probe);
+        const char *name = BDK_ProfGetName(probe);
+        const uint32_t *h;
+
+        if (stats->count == 0)
+        {
+            continue;
+        }
+
+        TRACE_PRINTF("PROF %s n=%lu min=%lu max=%lu mean=%lu\r\n", name,
+                stats->count, stats->min, stats->max,
+                (uint32_t)(stats->sum / stats->count));
+
+        /* Histogram is split as trace message has limited argument count. */
+        for (uint8_t i = 0; i < BDK_PROF_HIST_BINS;
+                i += APP_DIAG_HIST_PER_LINE)
+        {
+            h = &stats->hist[i];
+            if ((h[0] | h[1] | h[2] | h[3]) != 0)
+            {
+                TRACE_PRINTF("PROF %s h%u %lu %lu %lu %lu\r\n", name, i,
+                        h[0], h[1], h[2], h[3]);
+            }
+        }
+    }
+}
+
+void App_DiagWatchdogRefresh(void)
+{
+    diag_wdt_refreshes += 1;
+}
@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include "app.h"
+#include "RTE_app_config.h"
+
+/* Current of every power state in uA. */
+static const uint32_t energy_current[APP_POWER_STATE_NB] = {
+    [APP_POWER_RUN] = RTE_APP_ENERGY_RUN_CURRENT,
+    [APP_POWER_WFI] = RTE_APP_ENERGY_WFI_CURRENT,
+    [APP_POWER_SLEEP] = RTE_APP_ENERGY_SLEEP_CURRENT
+};
+
+/* Accounting state is kept in retained RAM over deep sleep. */
+
+/** RTC ticks spent in every application and power state. */
+static uint64_t energy_residency[APP_STATE_NB][APP_POWER_STATE_NB];
+
+static uint32_t energy_wakeups[APP_ENERGY_WAKEUP_SRC_NB];
+static uint32_t energy_wakeups_total = 0;
+static uint32_t energy_sleep_entries = 0;
+static uint32_t energy_sleep_refused = 0;
+
+/** State accounted since the last transition. */
+static enum App_PowerState energy_power = APP_POWER_RUN;
+static enum App_StateStruct energy_app_state = APP_STATE_INIT;
+
+/** RTC time of the last transition. */
+static uint32_t energy_checkpoint = 0;
+
+/** Accounts time since the last transition to the current states. */
+static void App_EnergyCheckpoint(void)
+{
+    uint32_t now = HAL_RTC_GetTime(NULL);
+
+    energy_residency[energy_app_state][energy_power] +=
+            now - energy_checkpoint;
+    energy_checkpoint = now;
+    energy_app_state = app_state;
+}
+
+void App_EnergyInitialize(void)
+{
+    /* RTC is started at power up, time so far was spent running. */
+    energy_checkpoint = 0;
+    energy_power = APP_POWER_RUN;
+    energy_app_state = app_state;
+    App_EnergyCheckpoint();
+}
+
+void App_EnergyEnter(enum App_PowerState state)
+{
+    App_EnergyCheckpoint();
+    energy_power = state;
+}
+
+void App_EnergySleepRefused(void)
+{
+    /* Attempt took just a few instructions, keep it in run state. */
+    energy_power = APP_POWER_RUN;
+    energy_sleep_refused += 1;
+}
+
+void App_EnergyWakeUp(uint8_t wakeup_src)
+{
+    /* Deep sleep is confirmed only by waking up from it, refused attempts
+     * returned to run state already. */
+    if (energy_power == APP_POWER_SLEEP)
+    {
+        energy_sleep_entries += 1;
+    }
+
+    App_EnergyEnter(APP_POWER_RUN);
+
+    energy_wakeups_total += 1;
+    for (uint8_t i = 0; i < APP_ENERGY_WAKEUP_SRC_NB; ++i)
+    {
+        if (wakeup_src & (1 << i))
+        {
+            energy_wakeups[i] += 1;
+        }
+    }
+}
+
+uint64_t App_EnergyGetResidency(enum App_PowerState power, uint8_t state)
+{
+    uint64_t ticks = 0;
+
+    App_EnergyCheckpoint();
+
+    if (state != APP_ENERGY_ALL_STATES)
+    {
+        return (state < APP_STATE_NB) ? energy_residency[state][power] : 0;
+    }
+
+    for (uint8_t i = 0; i < APP_STATE_NB; ++i)
+    {
+        ticks += energy_residency[i][power];
+    }
+
+    return ticks;
+}
+
+uint64_t App_EnergyGetUptime(void)
+{
+    uint64_t ticks = 0;
+
+    for (uint8_t power = 0; power < APP_POWER_STATE_NB; ++power)
+    {
+        ticks += App_EnergyGetResidency(power, APP_ENERGY_ALL_STATES);
+    }
+
+    return ticks;
+}
+
+uint32_t App_EnergyGetSleepEntries(void)
+{
+    return energy_sleep_entries;
+}
+
+uint32_t App_EnergyGetSleepRefused(void)
+{
+    return energy_sleep_refused;
+}
+
+uint32_t App_EnergyGetWakeups(uint8_t source)
+{
+    if (source < APP_ENERGY_WAKEUP_SRC_NB)
+    {
+        return energy_wakeups[source];
+    }
+
+    return energy_wakeups_total;
+}
+
+uint32_t App_EnergyGetAverageCurrent(void)
+{
+    uint64_t uptime = App_EnergyGetUptime();
+    uint64_t charge;
+
+    if (uptime == 0)
+    {
+        return 0;
+    }
+
+    /* Charge in uA * RTC ticks. */
+    charge = (uint64_t)energy_wakeups_total * RTE_APP_ENERGY_WAKEUP_CHARGE
+            * HAL_RTC_XTAL_FREQ / 1000;
+    for (uint8_t power = 0; power < APP_POWER_STATE_NB; ++power)
+    {
+        charge += App_EnergyGetResidency(power, APP_ENERGY_ALL_STATES)
+                * energy_current[power];
+    }
+
+    /* Split division so that nA conversion does not overflow. */
+    return (charge / uptime) * 1000 + (charge % uptime) * 1000 / uptime;
+}
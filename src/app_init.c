@@ -143,6 +143,9 @@ void Device_Initialize(void)
     /* RTC has to be enabled after sleep mode and the XTAL32 are configured. */
     Timer_Initialize();
 
+    /* Start residency accounting from RTC time. */
+    App_EnergyInitialize();
+
     /* Initialize environment */
     App_Env_Initialize();
 
@@ -181,15 +184,21 @@ void Device_Initialize_WakeUp(void)
     /* Configure clock dividers after wake-up. */
     ConfigureSystemClocks();
 
-    /* Restart 1ms tick timer. */
+    /* Restore 1ms wake up tick used by HAL_Delay. */
     HAL_TICK_Init();
 
+    /* Cycle counter is not retained in deep sleep. */
+    BDK_ProfInit();
+
     /* Wake-up application timer and the underlying RTC libraries. */
     Timer_Wakeup();
 
     /* Stop masking interrupts. */
     __set_PRIMASK(PRIMASK_ENABLE_INTERRUPTS);
 
+    /* Account time spent in deep sleep. */
+    App_EnergyWakeUp(ACS_WAKEUP_STATE->WAKEUP_SRC_BYTE);
+
     /* Mask all interrupts */
     BBIF_CTRL->WAKEUP_REQ_ALIAS = 1;
     __disable_irq();
@@ -246,8 +255,18 @@ void BLE_Initialize(void)
      */
      BDK_BLE_SetLocalName(RTE_APP_BLE_COMPLETE_LOCAL_NAME);
 
+#if RTE_APP_BLE_BOND_ENABLED == 1
+     /* Bond with central device and advertise to it after link drop. */
+     BDK_BLE_EnableBonding(RTE_APP_BLE_RECONNECT_MODE);
+#endif
+
      /* Initialize IDK Custom Service and associated libraries. */
      CS_Init();
+
+#if RTE_APP_CCS_LECB_ENABLED == 1
+     /* Accept LE credit based channel for bulk stream transport. */
+     BLE_LECB_Initialize(RTE_APP_CCS_LECB_PSM);
+#endif
 }
 
 void App_Env_Initialize(void)
@@ -256,6 +275,9 @@ void App_Env_Initialize(void)
     LED_Initialize(LED_RED);
     LED_Initialize(LED_GREEN);
 
+    /* LED indication is played by application timer without blocking. */
+    App_LedInitialize();
+
     /* Initialize Buttons. */
     BTN_Initialize(BUTTON0);
     BTN_Initialize(BUTTON1);
@@ -269,9 +291,12 @@ void App_Env_Initialize(void)
      */
     HAL_I2C_SetBusSpeed(RTE_APP_I2C_BUS_SPEED);
 
-    /* Initialize 1ms timer for basic timing of application. */
+    /* Configure 1ms wake up tick, platform time itself is read from RTC. */
     HAL_TICK_Init();
 
+    /* Start cycle counter used by profiling probes. */
+    BDK_ProfInit();
+
     /* Initialize peripherals and put on-board sensors to sleep modes. */
     TRACE_PRINTF("Initializing peripherals.\r\n");
 
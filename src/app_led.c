@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include "app.h"
+
+struct App_LedPattern
+{
+    LedName led;
+    uint16_t on_ms;
+    uint16_t off_ms;
+    uint8_t count;
+};
+
+static struct App_LedPattern led_queue[APP_LED_QUEUE_SIZE];
+static uint8_t led_queue_head = 0;
+static uint8_t led_queue_len = 0;
+
+/** Step timer of the pattern at queue head. */
+static struct stimer led_step_timer;
+
+/** Whether the head pattern is in its on step. */
+static bool led_step_on = false;
+
+static void App_LedStartStep(void)
+{
+    struct App_LedPattern *pattern = &led_queue[led_queue_head];
+
+    if (led_step_on == false && pattern->on_ms > 0)
+    {
+        led_step_on = true;
+        LED_On(pattern->led);
+        stimer_expire_from_now_ms(&led_step_timer, pattern->on_ms);
+    }
+    else
+    {
+        led_step_on = false;
+        LED_Off(pattern->led);
+        stimer_expire_from_now_ms(&led_step_timer, pattern->off_ms);
+    }
+}
+
+void App_LedInitialize(void)
+{
+    stimer_init(&led_step_timer, Timer_GetContext());
+    led_queue_head = 0;
+    led_queue_len = 0;
+    led_step_on = false;
+}
+
+bool App_LedBlink(LedName led, uint16_t on_ms, uint16_t off_ms,
+        uint8_t count)
+{
+    struct App_LedPattern *pattern;
+
+    if (led_queue_len >= APP_LED_QUEUE_SIZE || count == 0)
+    {
+        return false;
+    }
+
+    pattern = &led_queue[(led_queue_head + led_queue_len) % APP_LED_QUEUE_SIZE];
+    pattern->led = led;
+    pattern->on_ms = on_ms;
+    pattern->off_ms = off_ms;
+    pattern->count = count;
+
+    led_queue_len += 1;
+    if (led_queue_len == 1)
+    {
+        led_step_on = false;
+        App_LedStartStep();
+    }
+
+    return true;
+}
+
+bool App_LedIsBusy(void)
+{
+    return led_queue_len > 0;
+}
+
+void App_LedUpdate(void)
+{
+    struct App_LedPattern *pattern;
+
+    /* Zero length steps elapse right away, finish them in one pass. */
+    while (led_queue_len > 0 && stimer_is_expired(&led_step_timer) == true)
+    {
+        pattern = &led_queue[led_queue_head];
+
+        /* Off step ends one repetition. */
+        if (led_step_on == false)
+        {
+            pattern->count -= 1;
+            if (pattern->count == 0)
+            {
+                led_queue_head = (led_queue_head + 1) % APP_LED_QUEUE_SIZE;
+                led_queue_len -= 1;
+            }
+        }
+
+        if (led_queue_len > 0)
+        {
+            App_LedStartStep();
+        }
+        else
+        {
+            stimer_stop(&led_step_timer);
+        }
+    }
+
+    /* Pads are reinitialized to low level after deep sleep. */
+    if (led_step_on == true)
+    {
+        LED_On(led_queue[led_queue_head].led);
+    }
+}
@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include "app.h"
+#include "RTE_app_config.h"
+
+struct App_SchedTaskDesc
+{
+    /** Executes the task. */
+    void (*run)(void);
+
+    /** Returns true if task has work that should not wait for the next
+     * pass, NULL if task runs just once per pass. */
+    bool (*is_pending)(void);
+
+    /** Longest expected run in RTC ticks. */
+    uint32_t budget;
+};
+
+struct App_SchedTaskStats
+{
+    uint32_t overruns;
+    uint32_t max_ticks;
+};
+
+static void App_SchedAudio(void);
+static void App_SchedBle(void);
+static void App_SchedControl(void);
+static void App_SchedLog(void);
+
+static const struct App_SchedTaskDesc sched_tasks[APP_SCHED_TASK_NB] = {
+    [APP_SCHED_AUDIO] = {
+        &App_SchedAudio, &CS_IsPollPending,
+        HAL_RTC_US_TO_TICKS(RTE_APP_SCHED_AUDIO_BUDGET)
+    },
+    [APP_SCHED_BLE] = {
+        &App_SchedBle, &BDK_TaskIsSchedulePending,
+        HAL_RTC_US_TO_TICKS(RTE_APP_SCHED_BLE_BUDGET)
+    },
+    [APP_SCHED_CONTROL] = {
+        &App_SchedControl, NULL,
+        HAL_RTC_US_TO_TICKS(RTE_APP_SCHED_CONTROL_BUDGET)
+    },
+    [APP_SCHED_LOG] = {
+        &App_SchedLog, NULL,
+        HAL_RTC_US_TO_TICKS(RTE_APP_SCHED_LOG_BUDGET)
+    }
+};
+
+static struct App_SchedTaskStats sched_stats[APP_SCHED_TASK_NB];
+
+static void App_SchedAudio(void)
+{
+    CS_PollProviders();
+}
+
+static void App_SchedBle(void)
+{
+    BDK_PROF_START(BDK_PROF_KERNEL_SCHEDULE);
+    Kernel_Schedule();
+    BDK_PROF_STOP(BDK_PROF_KERNEL_SCHEDULE);
+
+    /* Execute callbacks deferred by interrupts. */
+    BDK_TaskRunScheduled();
+}
+
+static void App_SchedControl(void)
+{
+    App_StateMachine();
+    App_LedUpdate();
+    App_DiagUpdate();
+}
+
+static void App_SchedLog(void)
+{
+    /* Send log records collected since last pass. */
+    TRACE_FLUSH();
+}
+
+/** Returns the highest priority task that is due in this pass or has
+ * pending work. */
+static uint8_t App_SchedNext(uint32_t due)
+{
+    uint8_t task;
+
+    for (task = 0; task < APP_SCHED_TASK_NB; ++task)
+    {
+        if ((due & (1U << task)) != 0
+            || (sched_tasks[task].is_pending != NULL
+                && sched_tasks[task].is_pending() == true))
+        {
+            break;
+        }
+    }
+
+    return task;
+}
+
+void App_SchedRun(void)
+{
+    uint32_t due = (1U << APP_SCHED_TASK_NB) - 1;
+    uint32_t start;
+    uint32_t ticks;
+    uint8_t task;
+
+    while (due != 0)
+    {
+        task = App_SchedNext(due);
+        due &= ~(1U << task);
+
+        start = HAL_RTC_GetTime(NULL);
+        sched_tasks[task].run();
+        ticks = HAL_RTC_GetTime(NULL) - start;
+
+        if (ticks > sched_stats[task].max_ticks)
+        {
+            sched_stats[task].max_ticks = ticks;
+        }
+        /* Reported by DIAG page APP_DIAG_PAGE_SCHED, a trace message per
+         * overrun would flood the log when a task keeps overrunning. */
+        if (ticks > sched_tasks[task].budget)
+        {
+            sched_stats[task].overruns += 1;
+        }
+    }
+}
+
+bool App_SchedIsPending(void)
+{
+    return App_SchedNext(0) < APP_SCHED_TASK_NB;
+}
+
+uint32_t App_SchedGetOverruns(enum App_SchedTask task)
+{
+    return (task < APP_SCHED_TASK_NB) ? sched_stats[task].overruns : 0;
+}
+
+uint32_t App_SchedGetMaxTicks(enum App_SchedTask task)
+{
+    return (task < APP_SCHED_TASK_NB) ? sched_stats[task].max_ticks : 0;
+}
@@ -24,102 +24,74 @@
 
 struct stimer_ctx app_timer_ctx = { 0 };
 
-static bool is_duration_ge(struct stimer_duration * lhs,
-        struct stimer_duration * rhs)
-{
-    bool is_ge = false;
-    if (lhs->seconds > rhs->seconds)
-    {
-        is_ge = true;
-    }
-    else if (lhs->seconds == rhs->seconds)
-    {
-        if (lhs->nanoseconds >= rhs->nanoseconds)
-        {
-            is_ge = true;
-        }
-    }
-    return is_ge;
-}
+/** Number of timers served by the armed RTC alarm. */
+static uint16_t timer_alarm_timers = 0;
 
-static inline void duration_diff(struct stimer_duration * lhs,
-        struct stimer_duration *rhs, struct stimer_duration *result)
-{
-    result->seconds = rhs->seconds - lhs->seconds;
-
-    if (rhs->nanoseconds >= lhs->nanoseconds)
-    {
-        result->nanoseconds = rhs->nanoseconds - lhs->nanoseconds;
-    }
-    else
-    {
-        result->nanoseconds = 1000000000U + rhs->nanoseconds - lhs->nanoseconds;
-        result->seconds -= 1;
-    }
-}
-
-static inline bool duration_is_zero(struct stimer_duration *dur)
-{
-    return (dur->seconds == 0) && (dur->nanoseconds == 0);
-}
+/** Deep sleep wake ups saved by coalescing timers with slack. */
+static uint32_t timer_wakeups_avoided = 0;
 
 void Timer_Initialize(void)
 {
     HAL_RTC_Initialize();
 
-    stimer_init_context(&app_timer_ctx, NULL, &HAL_RTC_GetTime,
-            HAL_RTC_MAX_TICK_VALUE, APP_TIMER_NS_PER_RTC_TICK);
+    stimer_init_context(&app_timer_ctx, NULL, &APP_TIMER_GET_TIME,
+            APP_TIMER_MAX_TICK_VALUE, APP_TIMER_NS_PER_RTC_TICK);
 }
 
 void Timer_Wakeup(void)
 {
     HAL_RTC_Wakeup();
+
+    // Without slack every other timer served by this alarm would have woken
+    // the device separately.
+    if (ACS_WAKEUP_STATE->WAKEUP_SRC_BYTE == WAKEUP_DUE_TO_RTC_ALARM_BYTE
+            && timer_alarm_timers > 1)
+    {
+        timer_wakeups_avoided += timer_alarm_timers - 1;
+    }
+    timer_alarm_timers = 0;
+}
+
+uint32_t Timer_GetWakeupsAvoided(void)
+{
+    return timer_wakeups_avoided;
 }
 
 int32_t Timer_SetWakeupAtNextEvent(void)
 {
-    struct stimer_duration diff;
     int32_t retval = APP_TIMER_NO_EVENT;
-    struct stimer_duration ts_next_diff = {UINT32_MAX, UINT32_MAX};
-    struct stimer *ts_next = NULL;
+    uint64_t ts_next_ticks;
+    struct stimer *ts_next;
+    uint16_t ts_served = 0;
 
-    // Update timestamps of all registered timers to the same checkpoint.
-    stimer_execute_context(&app_timer_ctx);
+    // Deadline heap of the context gives the timer which will expire next.
+    ts_next = stimer_get_next_expiry(&app_timer_ctx, &ts_next_ticks);
 
-    // Find timer which will expire next.
-    for (struct stimer *ts = app_timer_ctx.root; ts != NULL; ts = ts->next)
+    // Unless a timer is due already, delay the wake up within slack of
+    // pending timers so that it serves as many of them as possible.
+    if (ts_next != NULL && ts_next_ticks > 0)
     {
-        if (ts->is_running && !duration_is_zero(&ts->expire_interval))
-        {
-            if (is_duration_ge(&ts->elapsed, &ts->expire_interval))
-            {
-                // There is timer event that is already expired.
-                retval = APP_TIMER_ALARM_NOW;
-                return retval;
-            }
-            else
-            {
-                duration_diff(&ts->elapsed, &ts->expire_interval, &diff);
-
-                if (!is_duration_ge(&diff, &ts_next_diff))
-                {
-                    ts_next_diff = diff;
-                    ts_next = ts;
-                }
-            }
-        }
+        stimer_get_coalesced_wakeup(&app_timer_ctx, &ts_next_ticks,
+                &ts_served);
     }
 
     // Set RTC wake up event for found timer event.
     if (ts_next != NULL)
     {
-        uint32_t ticks = HAL_RTC_S_TO_TICKS(ts_next_diff.seconds)
-                + HAL_RTC_NS_TO_TICKS(ts_next_diff.nanoseconds) + 1;
+        uint32_t ticks = (ts_next_ticks < APP_TIMER_MAX_ALARM_TICKS) ?
+                (uint32_t)ts_next_ticks + 1 : APP_TIMER_MAX_ALARM_TICKS;
 
         if (ticks <= APP_TIMER_KEEP_AWAKE_THRESH)
         {
             retval = APP_TIMER_ALARM_NOW;
 
+            // There is no periodic tick, RTC alarm has to wake up the core
+            // from WFI once the timer expires.
+            if (ts_next_ticks > 0)
+            {
+                HAL_RTC_SetAlarmTicks(ticks);
+            }
+
 #ifdef _TIMER_DEBUG
             TRACE_PRINTF("%s:%d: Next event below threshold.\r\n", __FUNCTION__,
                     __LINE__);
@@ -128,12 +100,14 @@ int32_t Timer_SetWakeupAtNextEvent(void)
         else
         {
             HAL_RTC_SetAlarmTicks(ticks);
+            timer_alarm_timers = ts_served;
 
 #ifdef _TIMER_DEBUG
             TRACE_PRINTF("%s:%d: Setting RTC alarm to %lu ticks.\r\n",
                     __FUNCTION__, __LINE__, ticks);
 #endif
-            TRACE_PRINTF("Next RTC alarm %.4f sec.\r\n", ticks / 32768.0f);
+            TRACE_PRINTF("Next RTC alarm %lu ms.\r\n",
+                    (uint32_t)(((uint64_t)ticks * 1000U) / HAL_RTC_XTAL_FREQ));
 
             retval = APP_TIMER_ALARM_SET;
         }
@@ -21,6 +21,9 @@ void trace_init(void)
 {
     HAL_UART_Init();
     HAL_UART_SetBaudRate(230400);
+#if RTE_BDK_LOG_TOKENIZED == 1 && !defined APP_TRACE_DISABLED
+    BDK_LogInit();
+#endif
 }
 
 void trace_deinit(void)
@@ -31,6 +34,7 @@ void trace_deinit(void)
 void assert_error(const char *file, const int line, const char *msg)
 {
     TRACE_PRINTF("%s: %d: %s\r\n", file, line, msg);
+    TRACE_FLUSH_ALL();
 
     __disable_irq();
     while (1)
@@ -29,6 +29,7 @@
 #include <BDK_Task.h>
 #include <HAL_error.h>
 #include <BLE_CCS.h>
+#include <BDK_Prof.h>
 
 //-----------------------------------------------------------------------------
 // DEFINES / CONSTANTS
@@ -63,6 +64,42 @@
     { ATT_DESC_CHAR_USER_DESC_128, PERM(RD, ENABLE), max_length, \
       PERM(RI, ENABLE) }
 
+#define CCS_CHAR_NAME(name) \
+    { name, sizeof(name) - 1 }
+
+/** \brief Checks that attributes of a characteristic follow the order of
+ * BLE_CCS_AttributeRole, on which CCS_ATT_ROLE and CCS_CHAR_IDX rely.
+ */
+#define CCS_CHAR_ORDER_CHECK(name)                                            \
+    _Static_assert(CCS_ATT_ROLE(CCS_IDX_ ## name ## _VALUE_CHAR) == CCS_ATT_CHAR \
+            && CCS_IDX_ ## name ## _VALUE_VAL                                 \
+                    == CCS_IDX_ ## name ## _VALUE_CHAR + CCS_ATT_VAL          \
+            && CCS_IDX_ ## name ## _VALUE_CCC                                 \
+                    == CCS_IDX_ ## name ## _VALUE_CHAR + CCS_ATT_CCC          \
+            && CCS_IDX_ ## name ## _VALUE_USR_DSCP                            \
+                    == CCS_IDX_ ## name ## _VALUE_CHAR + CCS_ATT_USR_DSCP,    \
+            #name " attributes out of order")
+
+CCS_CHAR_ORDER_CHECK(SCP);
+CCS_CHAR_ORDER_CHECK(DMIC);
+CCS_CHAR_ORDER_CHECK(LCA);
+CCS_CHAR_ORDER_CHECK(RCA);
+CCS_CHAR_ORDER_CHECK(LCF);
+CCS_CHAR_ORDER_CHECK(RCF);
+CCS_CHAR_ORDER_CHECK(ASCP);
+CCS_CHAR_ORDER_CHECK(MUX);
+CCS_CHAR_ORDER_CHECK(DIAG);
+
+_Static_assert(CCS_IDX_NB == CCS_CHAR_NB * CCS_ATT_PER_CHAR,
+        "CCS characteristic without all of its attributes");
+
+/** \brief Characteristic User Description string. */
+struct BLE_CCS_CharName
+{
+    const char *name;
+    uint8_t length;
+};
+
 //-----------------------------------------------------------------------------
 // EXTERNAL / FORWARD DECLARATIONS
 //-----------------------------------------------------------------------------
@@ -74,6 +111,12 @@ static void BLE_CCS_ServiceAdd(void);
 
 static void BLE_CCS_Enable(uint8_t conidx);
 
+static uint32_t BLE_CCS_SendNotification(const uint8_t *data,
+        uint16_t data_len, uint16_t alloc_len, BLE_CCS_AttributeIndex idx);
+
+static void BLE_CCS_StoreValue(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx);
+
 static int BLE_CCS_GATTM_AddSvcRsp(ke_msg_id_t const msg_id,
         struct gattm_add_svc_rsp const *param, ke_task_id_t const dest_id,
         ke_task_id_t const src_id);
@@ -94,6 +137,20 @@ static int BLE_CCS_GATTC_CmpEvt(ke_msg_id_t const msg_id,
         struct gattc_cmp_evt const *param, ke_task_id_t const dest_id,
         ke_task_id_t const src_id);
 
+static int BLE_CCS_GATTC_MtuChangedInd(ke_msg_id_t const msg_id,
+        struct gattc_mtu_changed_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+static int BLE_CCS_MuxFlushTimeout(ke_msg_id_t const msg_id,
+        void const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+static bool BLE_CCS_IsMuxSubscribed(struct BLE_CCS_Connection *con);
+
+static uint16_t BLE_CCS_GetMuxMaxLength(void);
+
+static uint32_t BLE_CCS_MuxFlush(void);
+
 //! \}
 
 //-----------------------------------------------------------------------------
@@ -102,6 +159,152 @@ static int BLE_CCS_GATTC_CmpEvt(ke_msg_id_t const msg_id,
 
 static struct BLE_CCS_Resources cs_res = { 0 };
 
+/** \brief CCS attribute database indexed by attribute offset from service
+ * start handle.
+ */
+static const struct gattm_att_desc ccs_att_db[CCS_IDX_NB] = {
+    /* SCP Characteristic */
+    [CCS_IDX_SCP_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_SCP_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_SCP_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(WRITE_REQ, ENABLE) | PERM(WRITE_COMMAND, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_SCP_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_SCP_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_SCP_CHARACTERISTIC_NAME_LEN),
+
+    /* DMIC Characteristic */
+    [CCS_IDX_DMIC_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_DMIC_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_DMIC_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(NTF, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_DMIC_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_DMIC_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_DMIC_CHARACTERISTIC_NAME_LEN),
+
+    /* LCA Characteristic */
+    [CCS_IDX_LCA_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_LCA_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_LCA_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(NTF, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_LCA_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_LCA_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_LCA_CHARACTERISTIC_NAME_LEN),
+
+    /* RCA Characteristic */
+    [CCS_IDX_RCA_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_RCA_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_RCA_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(NTF, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_RCA_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_RCA_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_RCA_CHARACTERISTIC_NAME_LEN),
+
+    /* LCF Characteristic */
+    [CCS_IDX_LCF_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_LCF_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_LCF_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(NTF, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_LCF_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_LCF_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_LCF_CHARACTERISTIC_NAME_LEN),
+
+    /* RCF Characteristic */
+    [CCS_IDX_RCF_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_RCF_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_RCF_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(NTF, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_RCF_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_RCF_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_RCF_CHARACTERISTIC_NAME_LEN),
+
+    /* ASCP Characteristic */
+    [CCS_IDX_ASCP_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_ASCP_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_ASCP_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(WRITE_REQ, ENABLE) | PERM(WRITE_COMMAND, ENABLE),
+            CCS_CHARACTERISTIC_VALUE_LENGTH),
+
+    [CCS_IDX_ASCP_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_ASCP_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_ASCP_CHARACTERISTIC_NAME_LEN),
+
+    /* MUX Characteristic */
+    [CCS_IDX_MUX_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_MUX_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_MUX_CHARACTERISTIC_UUID,
+            PERM(NTF, ENABLE),
+            CCS_MUX_VALUE_MAX_LENGTH),
+
+    [CCS_IDX_MUX_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_MUX_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_MUX_CHARACTERISTIC_NAME_LEN),
+
+    /* DIAG Characteristic */
+    [CCS_IDX_DIAG_VALUE_CHAR] = ATT_DECL_CHAR(),
+
+    [CCS_IDX_DIAG_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
+            CCS_DIAG_CHARACTERISTIC_UUID,
+            PERM(RD, ENABLE) | PERM(WRITE_REQ, ENABLE),
+            CCS_DIAG_VALUE_MAX_LENGTH),
+
+    [CCS_IDX_DIAG_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+
+    [CCS_IDX_DIAG_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
+            CCS_DIAG_CHARACTERISTIC_NAME_LEN),
+};
+
+/** \brief User description of every characteristic indexed by characteristic
+ * number.
+ */
+static const struct BLE_CCS_CharName ccs_char_name[CCS_CHAR_NB] = {
+    [CCS_CHAR_IDX(CCS_IDX_SCP_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_SCP_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_DMIC_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_DMIC_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_LCA_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_LCA_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_RCA_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_RCA_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_LCF_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_LCF_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_RCF_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_RCF_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_ASCP_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_ASCP_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_MUX_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_MUX_CHARACTERISTIC_NAME),
+    [CCS_CHAR_IDX(CCS_IDX_DIAG_VALUE_VAL)] =
+            CCS_CHAR_NAME(CCS_DIAG_CHARACTERISTIC_NAME),
+};
+
 //-----------------------------------------------------------------------------
 // FUNCTION DEFINITIONS
 //-----------------------------------------------------------------------------
@@ -115,11 +318,7 @@ void BLE_CCS_Initialize(BLE_CCS_RxIndHandler rx_ind_handler)
         memset(&cs_res, 0, sizeof(cs_res));
         cs_res.state = BLE_CCS_CREATE_DB;
         cs_res.rx_write_handler = rx_ind_handler;
-        cs_res.dmic_cccd_value = ATT_CCC_START_NTF;
-        cs_res.lca_cccd_value = ATT_CCC_START_NTF;
-        cs_res.rca_cccd_value = ATT_CCC_START_NTF;
-        cs_res.lcf_cccd_value = ATT_CCC_START_NTF;
-        cs_res.rcf_cccd_value = ATT_CCC_START_NTF;
+        cs_res.mux_flush_msg_id = BDK_TaskAllocateMsgId();
 
         BDK_TaskAddMsgHandler(GATTM_ADD_SVC_RSP,
                 (ke_msg_func_t) &BLE_CCS_GATTM_AddSvcRsp);
@@ -131,6 +330,10 @@ void BLE_CCS_Initialize(BLE_CCS_RxIndHandler rx_ind_handler)
                 (ke_msg_func_t) &BLE_CCS_GATTC_AttInfoReqInd);
         BDK_TaskAddMsgHandler(GATTC_CMP_EVT,
                 (ke_msg_func_t) &BLE_CCS_GATTC_CmpEvt);
+        BDK_TaskAddMsgHandler(GATTC_MTU_CHANGED_IND,
+                (ke_msg_func_t) &BLE_CCS_GATTC_MtuChangedInd);
+        BDK_TaskAddMsgHandler(cs_res.mux_flush_msg_id,
+                (ke_msg_func_t) &BLE_CCS_MuxFlushTimeout);
 
         BDK_BLE_AddService(&BLE_CCS_ServiceAdd, &BLE_CCS_Enable);
     }
@@ -138,224 +341,359 @@ void BLE_CCS_Initialize(BLE_CCS_RxIndHandler rx_ind_handler)
 
 uint32_t BLE_CCS_Notify(uint8_t *data, uint8_t data_len, BLE_CCS_AttributeIndex idx)
 {
-    int conidx = BDK_BLE_GetConIdx();
-    struct gattc_send_evt_cmd *cmd = NULL;
-
-    if (cs_res.state < BLE_CCS_CONNECTED || conidx == INVALID_DEV_IDX)
+    if (cs_res.state < BLE_CCS_CONNECTED || BDK_BLE_IsConnected() == false)
     {
-        return 1;
+        return BLE_CCS_STATUS_NO_CLIENT;
     }
 
     if (data_len == 0 || data_len > CCS_CHARACTERISTIC_VALUE_LENGTH)
     {
-        return 2;
+        return BLE_CCS_STATUS_LENGTH;
     }
 
     /* Copy data for any later read requests. */
-    switch(idx)
-    {
-    	case CCS_IDX_SCP_VALUE_VAL:
-    	    memcpy(cs_res.scp_value, data, data_len);
-    	    cs_res.scp_value_length = data_len;
-    		break;
-    	case CCS_IDX_ASCP_VALUE_VAL:
-    	    memcpy(cs_res.ascp_value, data, data_len);
-    	    cs_res.ascp_value_length = data_len;
-    		break;
-    	case CCS_IDX_DMIC_VALUE_VAL:
-    	    memcpy(cs_res.dmic_value, data, data_len);
-    	    cs_res.dmic_value_length = data_len;
-    		break;
-    	case CCS_IDX_LCA_VALUE_VAL:
-    	    memcpy(cs_res.lca_value, data, data_len);
-    	    cs_res.lca_value_length = data_len;
-    		break;
-    	case CCS_IDX_RCA_VALUE_VAL:
-    	    memcpy(cs_res.rca_value, data, data_len);
-    	    cs_res.rca_value_length = data_len;
-    		break;
-    	case CCS_IDX_LCF_VALUE_VAL:
-    	    memcpy(cs_res.lcf_value, data, data_len);
-    	    cs_res.lcf_value_length = data_len;
-    		break;
-    	case CCS_IDX_RCF_VALUE_VAL:
-    	    memcpy(cs_res.rcf_value, data, data_len);
-    	    cs_res.rcf_value_length = data_len;
-    		break;
-    	default:
-    		break;
-    }
-
-    /* Send notify command with data. */
-    cmd = KE_MSG_ALLOC_DYN(GATTC_SEND_EVT_CMD, KE_BUILD_ID(TASK_GATTC, conidx),
-            TASK_APP, gattc_send_evt_cmd, data_len * sizeof(uint8_t));
-    cmd->handle = cs_res.start_hdl + idx + 1;
-    cmd->operation = GATTC_NOTIFY;
-    cmd->seq_num = 0;
-    cmd->length = data_len;
-    memcpy(cmd->value, data, data_len);
-
-    ke_msg_send(cmd);
-
-    return 0;
+    BLE_CCS_StoreValue(data, data_len, idx);
+
+    return BLE_CCS_SendNotification(data, data_len, data_len, idx);
+}
+
+uint32_t BLE_CCS_NotifyStream(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx)
+{
+    if (cs_res.state < BLE_CCS_CONNECTED || BDK_BLE_IsConnected() == false)
+    {
+        return BLE_CCS_STATUS_NO_CLIENT;
+    }
+
+    if (data_len == 0 || data_len > CCS_CHARACTERISTIC_VALUE_LENGTH)
+    {
+        return BLE_CCS_STATUS_LENGTH;
+    }
+
+    BLE_CCS_SetStreamValue(data, data_len, idx);
+
+    return BLE_CCS_SendNotification(data, data_len, data_len, idx);
+}
+
+void BLE_CCS_SetStreamValue(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx)
+{
+    /* Value is materialized from the packet buffer on read request only. */
+    if (idx < CCS_IDX_NB && CCS_ATT_ROLE(idx) == CCS_ATT_VAL
+            && data_len <= CCS_CHARACTERISTIC_VALUE_LENGTH)
+    {
+        cs_res.value[CCS_CHAR_IDX(idx)].ref = data;
+        cs_res.value[CCS_CHAR_IDX(idx)].length = data_len;
+    }
 }
 
 uint32_t BLE_CCS_WriteNotify(uint8_t *data, uint16_t data_len, BLE_CCS_AttributeIndex idx)
 {
-    int conidx = BDK_BLE_GetConIdx();
-    struct gattc_send_evt_cmd *cmd = NULL;
+    if (cs_res.state < BLE_CCS_CONNECTED || BDK_BLE_IsConnected() == false)
+    {
+        return BLE_CCS_STATUS_NO_CLIENT;
+    }
 
-    if (cs_res.state < BLE_CCS_CONNECTED || conidx == INVALID_DEV_IDX)
+    if (data_len > CCS_CHARACTERISTIC_VALUE_LENGTH)
     {
-        return 1;
+        data_len = CCS_CHARACTERISTIC_VALUE_LENGTH;
     }
 
     /* Copy data for any later read requests. */
-    switch(idx)
-    {
-    	case CCS_IDX_SCP_VALUE_VAL:
-    	    memcpy(cs_res.scp_value, data, data_len);
-    	    cs_res.scp_value_length = data_len;
-    		break;
-    	case CCS_IDX_ASCP_VALUE_VAL:
-    	    memcpy(cs_res.ascp_value, data, data_len);
-    	    cs_res.ascp_value_length = data_len;
-    		break;
-    	case CCS_IDX_DMIC_VALUE_VAL:
-    	    memcpy(cs_res.dmic_value, data, data_len);
-    	    cs_res.dmic_value_length = data_len;
-    		break;
-    	case CCS_IDX_LCA_VALUE_VAL:
-    	    memcpy(cs_res.lca_value, data, data_len);
-    	    cs_res.lca_value_length = data_len;
-    		break;
-    	case CCS_IDX_RCA_VALUE_VAL:
-    	    memcpy(cs_res.rca_value, data, data_len);
-    	    cs_res.rca_value_length = data_len;
-    		break;
-    	case CCS_IDX_LCF_VALUE_VAL:
-    	    memcpy(cs_res.lcf_value, data, data_len);
-    	    cs_res.lcf_value_length = data_len;
-    		break;
-    	case CCS_IDX_RCF_VALUE_VAL:
-    	    memcpy(cs_res.rcf_value, data, data_len);
-    	    cs_res.rcf_value_length = data_len;
-    		break;
-    	default:
-    		break;
-    }
-
-    /* Send notify command with data. */
-    cmd = KE_MSG_ALLOC_DYN(GATTC_SEND_EVT_CMD, KE_BUILD_ID(TASK_GATTC, conidx),
-            TASK_APP, gattc_send_evt_cmd,
-			CCS_CHARACTERISTIC_VALUE_LENGTH * sizeof(uint8_t));
-    cmd->handle = cs_res.start_hdl + idx + 1;
-    cmd->operation = GATTC_NOTIFY;
-    cmd->seq_num = 0;
-    cmd->length = data_len;
-    memcpy(cmd->value, data, data_len);
-
-    ke_msg_send(cmd);
-
-    return 0;
+    BLE_CCS_StoreValue(data, data_len, idx);
+
+    return BLE_CCS_SendNotification(data, data_len,
+            CCS_CHARACTERISTIC_VALUE_LENGTH, idx);
 }
 
-static void BLE_CCS_ServiceAdd(void)
+/* ----------------------------------------------------------------------------
+ * Function      : void BLE_CCS_StoreValue(const uint8_t *data,
+ *                                         uint8_t data_len,
+ *                                         BLE_CCS_AttributeIndex idx)
+ * ----------------------------------------------------------------------------
+ * Description   : Store characteristic value for later read requests
+ * Inputs        : - data       - Characteristic value
+ *                 - data_len   - Length of the value
+ *                 - idx        - Attribute index of the characteristic value
+ * Outputs       : None
+ * Assumptions   : data_len <= CCS_CHARACTERISTIC_VALUE_LENGTH
+ * ------------------------------------------------------------------------- */
+static void BLE_CCS_StoreValue(const uint8_t *data, uint8_t data_len,
+        BLE_CCS_AttributeIndex idx)
 {
-    struct gattm_add_svc_req * req;
-    const uint8_t service_uuid[ATT_UUID_128_LEN] = CCS_SERVICE_UUID;
-    const struct gattm_att_desc att[CCS_IDX_NB] = {
-            /* SCP Characteristic */
-            [CCS_IDX_SCP_VALUE_CHAR] = ATT_DECL_CHAR(),
+    struct BLE_CCS_Value *val;
 
-            [CCS_IDX_SCP_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-            		CCS_SCP_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(WRITE_REQ, ENABLE) | PERM(WRITE_COMMAND, ENABLE),
-                    CCS_CHARACTERISTIC_VALUE_LENGTH),
+    /* Only readable characteristic values have a read cache. */
+    if (idx >= CCS_IDX_NB || CCS_ATT_ROLE(idx) != CCS_ATT_VAL
+            || (ccs_att_db[idx].perm & PERM(RD, ENABLE)) == 0)
+    {
+        return;
+    }
 
-            [CCS_IDX_SCP_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+    val = &cs_res.value[CCS_CHAR_IDX(idx)];
+    memcpy(val->value, data, data_len);
+    val->length = data_len;
+    val->ref = NULL;
+}
 
-            [CCS_IDX_SCP_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-                    CCS_SCP_CHARACTERISTIC_NAME_LEN),
+/* ----------------------------------------------------------------------------
+ * Function      : uint32_t BLE_CCS_SendNotification(const uint8_t *data,
+ *                                                   uint16_t data_len,
+ *                                                   uint16_t alloc_len,
+ *                                                   BLE_CCS_AttributeIndex idx)
+ * ----------------------------------------------------------------------------
+ * Description   : Notify already encoded characteristic value to every
+ *                 connected device that enabled notifications and whose
+ *                 notification queue is not full
+ * Inputs        : - data       - Encoded characteristic value
+ *                 - data_len   - Length of the value
+ *                 - alloc_len  - Length of value buffer allocated in message
+ *                 - idx        - Attribute index of the characteristic value
+ * Outputs       : return value - BLE_CCS_STATUS_OK if at least one device
+ *                                was notified or no device has
+ *                                notifications enabled,
+ *                                BLE_CCS_STATUS_DROPPED if notification was
+ *                                dropped for all subscribed devices
+ * Assumptions   : alloc_len >= data_len
+ * ------------------------------------------------------------------------- */
+static uint32_t BLE_CCS_SendNotification(const uint8_t *data,
+        uint16_t data_len, uint16_t alloc_len, BLE_CCS_AttributeIndex idx)
+{
+    struct gattc_send_evt_cmd *cmd = NULL;
+    struct BLE_CCS_Connection *con;
+    signed int conidx;
+    uint8_t subscribed = 0;
+    uint8_t sent = 0;
 
-			/* DMIC Characteristic */
-			[CCS_IDX_DMIC_VALUE_CHAR] = ATT_DECL_CHAR(),
+    BDK_PROF_START(BDK_PROF_CCS_NOTIFY);
 
-			[CCS_IDX_DMIC_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-					CCS_DMIC_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(NTF, ENABLE),
-					CCS_CHARACTERISTIC_VALUE_LENGTH),
+    for (uint8_t slot = 0; slot < BDK_BLE_MASTER_MAX; ++slot)
+    {
+        conidx = BDK_BLE_GetConIdxBySlot(slot);
+        con = &cs_res.con[slot];
 
-			[CCS_IDX_DMIC_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+        if (conidx == INVALID_DEV_IDX
+                || (con->cccd_value[CCS_CHAR_IDX(idx)] & ATT_CCC_START_NTF) == 0)
+        {
+            continue;
+        }
 
-			[CCS_IDX_DMIC_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-					CCS_DMIC_CHARACTERISTIC_NAME_LEN),
+        /* Stream data of this connection are carried by MUX characteristic */
+        if (idx != CCS_IDX_SCP_VALUE_VAL && idx != CCS_IDX_ASCP_VALUE_VAL
+                && idx != CCS_IDX_MUX_VALUE_VAL
+                && BLE_CCS_IsMuxSubscribed(con) == true)
+        {
+            continue;
+        }
 
-            /* LCA Characteristic */
-            [CCS_IDX_LCA_VALUE_CHAR] = ATT_DECL_CHAR(),
+        /* MUX value would not fit ATT MTU of this connection. */
+        if (idx == CCS_IDX_MUX_VALUE_VAL
+                && BLE_CCS_IsMuxSubscribed(con) == false)
+        {
+            continue;
+        }
 
-            [CCS_IDX_LCA_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-            		CCS_LCA_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(NTF, ENABLE),
-                    CCS_CHARACTERISTIC_VALUE_LENGTH),
+        subscribed += 1;
 
-            [CCS_IDX_LCA_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+        /* Per-connection flow control */
+        if (con->tx_pending >= CCS_NOTIFY_QUEUE_MAX)
+        {
+            con->tx_dropped += 1;
+            continue;
+        }
 
-            [CCS_IDX_LCA_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-                    CCS_LCA_CHARACTERISTIC_NAME_LEN),
+        /* Send notify command with data. */
+        cmd = KE_MSG_ALLOC_DYN(GATTC_SEND_EVT_CMD,
+                KE_BUILD_ID(TASK_GATTC, conidx), TASK_APP, gattc_send_evt_cmd,
+                alloc_len * sizeof(uint8_t));
+        cmd->handle = cs_res.start_hdl + idx + 1;
+        cmd->operation = GATTC_NOTIFY;
+        cmd->seq_num = 0;
+        cmd->length = data_len;
+        memcpy(cmd->value, data, data_len);
 
-			/* RCA Characteristic */
-			[CCS_IDX_RCA_VALUE_CHAR] = ATT_DECL_CHAR(),
+        ke_msg_send(cmd);
 
-			[CCS_IDX_RCA_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-					CCS_RCA_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(NTF, ENABLE),
-					CCS_CHARACTERISTIC_VALUE_LENGTH),
+        con->tx_pending += 1;
+        if (con->tx_pending > con->tx_pending_max)
+        {
+            con->tx_pending_max = con->tx_pending;
+        }
+        sent += 1;
+    }
 
-			[CCS_IDX_RCA_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+    BDK_PROF_STOP(BDK_PROF_CCS_NOTIFY);
 
-			[CCS_IDX_RCA_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-					CCS_RCA_CHARACTERISTIC_NAME_LEN),
+    return (subscribed > 0 && sent == 0) ?
+            BLE_CCS_STATUS_DROPPED : BLE_CCS_STATUS_OK;
+}
 
-			/* LCF Characteristic */
-			[CCS_IDX_LCF_VALUE_CHAR] = ATT_DECL_CHAR(),
+uint32_t BLE_CCS_MuxWrite(uint8_t provider_id, const uint8_t *data, uint8_t data_len)
+{
+    uint16_t max_length = BLE_CCS_GetMuxMaxLength();
+    uint32_t status = BLE_CCS_STATUS_OK;
 
-			[CCS_IDX_LCF_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-					CCS_LCF_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(NTF, ENABLE),
-					CCS_CHARACTERISTIC_VALUE_LENGTH),
+    if (cs_res.state < BLE_CCS_CONNECTED || max_length == 0)
+    {
+        return BLE_CCS_STATUS_NO_CLIENT;
+    }
 
-			[CCS_IDX_LCF_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+    if (data_len == 0 || data_len > CCS_CHARACTERISTIC_VALUE_LENGTH)
+    {
+        return BLE_CCS_STATUS_LENGTH;
+    }
 
-			[CCS_IDX_LCF_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-					CCS_LCF_CHARACTERISTIC_NAME_LEN),
+    /* Frame is delivered by BLE_CCS_NotifyStream if it can not fit at all. */
+    if (max_length < CCS_MUX_HEADER_LENGTH + CCS_MUX_FRAME_HEADER_LENGTH
+            + data_len)
+    {
+        return BLE_CCS_STATUS_NO_CLIENT;
+    }
+
+    /* MTU of subscribed connections may have dropped since last frame. */
+    if (cs_res.mux_value_length + CCS_MUX_FRAME_HEADER_LENGTH + data_len
+            > max_length)
+    {
+        status = BLE_CCS_MuxFlush();
+    }
+
+    if (cs_res.mux_value_length == 0)
+    {
+        cs_res.mux_value[0] = cs_res.mux_seq++;
+        cs_res.mux_value_length = CCS_MUX_HEADER_LENGTH;
+
+        /* Do not hold frames of slow streams until the value fills up. */
+        ke_timer_set(cs_res.mux_flush_msg_id, TASK_APP,
+                CCS_MUX_FLUSH_TIMEOUT);
+    }
+
+    cs_res.mux_value[cs_res.mux_value_length] = provider_id;
+    cs_res.mux_value[cs_res.mux_value_length + 1] = data_len;
+    memcpy(&cs_res.mux_value[cs_res.mux_value_length
+            + CCS_MUX_FRAME_HEADER_LENGTH], data, data_len);
+    cs_res.mux_value_length += CCS_MUX_FRAME_HEADER_LENGTH + data_len;
+
+    /* Notify once another frame of maximal length does not fit. */
+    if (cs_res.mux_value_length + CCS_MUX_FRAME_HEADER_LENGTH
+            + CCS_CHARACTERISTIC_VALUE_LENGTH > max_length)
+    {
+        status = BLE_CCS_MuxFlush();
+    }
+
+    return status;
+}
+
+void BLE_CCS_SetDiagHandler(BLE_CCS_DiagReadHandler handler)
+{
+    cs_res.diag_read_handler = handler;
+}
 
-			/* RCF Characteristic */
-			[CCS_IDX_RCF_VALUE_CHAR] = ATT_DECL_CHAR(),
+const struct BLE_CCS_Connection* BLE_CCS_GetConnection(uint8_t slot)
+{
+    if (BDK_BLE_GetConIdxBySlot(slot) == INVALID_DEV_IDX)
+    {
+        return NULL;
+    }
 
-			[CCS_IDX_RCF_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-					CCS_RCF_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(NTF, ENABLE),
-					CCS_CHARACTERISTIC_VALUE_LENGTH),
+    return &cs_res.con[slot];
+}
 
-			[CCS_IDX_RCF_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+/* ----------------------------------------------------------------------------
+ * Function      : uint32_t BLE_CCS_MuxFlush(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Notify MUX value assembled so far and start a new one
+ * Inputs        : None
+ * Outputs       : return value - Status of BLE_CCS_SendNotification or
+ *                                BLE_CCS_STATUS_OK if value carries no frame
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static uint32_t BLE_CCS_MuxFlush(void)
+{
+    uint32_t status = BLE_CCS_STATUS_OK;
 
-			[CCS_IDX_RCF_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-					CCS_RCF_CHARACTERISTIC_NAME_LEN),
+    /* Value holding only MUX header is never notified. */
+    if (cs_res.mux_value_length > CCS_MUX_HEADER_LENGTH)
+    {
+        status = BLE_CCS_SendNotification(cs_res.mux_value,
+                cs_res.mux_value_length, cs_res.mux_value_length,
+                CCS_IDX_MUX_VALUE_VAL);
+    }
 
-			/* ASCP Characteristic */
-			[CCS_IDX_ASCP_VALUE_CHAR] = ATT_DECL_CHAR(),
+    cs_res.mux_value_length = 0;
+    ke_timer_clear(cs_res.mux_flush_msg_id, TASK_APP);
 
-			[CCS_IDX_ASCP_VALUE_VAL] = ATT_DECL_CHAR_UUID_128(
-					CCS_ASCP_CHARACTERISTIC_UUID,
-					PERM(RD, ENABLE) | PERM(WRITE_REQ, ENABLE) | PERM(WRITE_COMMAND, ENABLE),
-					CCS_CHARACTERISTIC_VALUE_LENGTH),
+    return status;
+}
 
-			[CCS_IDX_ASCP_VALUE_CCC] = ATT_DECL_CHAR_CCC(),
+static int BLE_CCS_MuxFlushTimeout(ke_msg_id_t const msg_id,
+        void const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    BLE_CCS_MuxFlush();
 
-			[CCS_IDX_ASCP_VALUE_USR_DSCP] = ATT_DECL_CHAR_USER_DESC(
-					CCS_ASCP_CHARACTERISTIC_NAME_LEN),
-    };
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : bool BLE_CCS_IsMuxSubscribed(struct BLE_CCS_Connection *con)
+ * ----------------------------------------------------------------------------
+ * Description   : Check whether connection receives stream data over MUX
+ *                 characteristic
+ * Inputs        : - con        - CCS state of the connection
+ * Outputs       : return value - true if MUX notifications are enabled and
+ *                                ATT MTU fits a frame of maximal length
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static bool BLE_CCS_IsMuxSubscribed(struct BLE_CCS_Connection *con)
+{
+    /* Notification header takes 3 bytes of ATT MTU */
+    return (con->cccd_value[CCS_CHAR_IDX(CCS_IDX_MUX_VALUE_CCC)]
+            & ATT_CCC_START_NTF) != 0
+            && con->mtu >= CCS_MUX_MIN_VALUE_LENGTH + 3;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : uint16_t BLE_CCS_GetMuxMaxLength(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Get MUX value length that fits into ATT MTU of every
+ *                 connection subscribed to MUX characteristic
+ * Inputs        : None
+ * Outputs       : return value - Maximum MUX value length or 0 if no
+ *                                connection is subscribed
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static uint16_t BLE_CCS_GetMuxMaxLength(void)
+{
+    uint16_t max_length = 0;
+
+    for (uint8_t slot = 0; slot < BDK_BLE_MASTER_MAX; ++slot)
+    {
+        struct BLE_CCS_Connection *con = &cs_res.con[slot];
+
+        if (BDK_BLE_GetConIdxBySlot(slot) != INVALID_DEV_IDX
+                && BLE_CCS_IsMuxSubscribed(con) == true)
+        {
+            /* Notification header takes 3 bytes of ATT MTU */
+            uint16_t length = con->mtu - 3;
+
+            if (length > CCS_MUX_VALUE_MAX_LENGTH)
+            {
+                length = CCS_MUX_VALUE_MAX_LENGTH;
+            }
+            if (max_length == 0 || length < max_length)
+            {
+                max_length = length;
+            }
+        }
+    }
+
+    return max_length;
+}
+
+static void BLE_CCS_ServiceAdd(void)
+{
+    struct gattm_add_svc_req * req;
+    const uint8_t service_uuid[ATT_UUID_128_LEN] = CCS_SERVICE_UUID;
 
     if (cs_res.state == BLE_CCS_CREATE_DB)
     {
@@ -366,7 +704,7 @@ static void BLE_CCS_ServiceAdd(void)
         req->svc_desc.perm = PERM(SVC_UUID_LEN, UUID_128);
         req->svc_desc.nb_att = CCS_IDX_NB;
         memcpy(req->svc_desc.uuid, service_uuid, ATT_UUID_128_LEN);
-        memcpy(req->svc_desc.atts, att,
+        memcpy(req->svc_desc.atts, ccs_att_db,
                 CCS_IDX_NB * sizeof(struct gattm_att_desc));
 
         ke_msg_send(req);
@@ -375,10 +713,26 @@ static void BLE_CCS_ServiceAdd(void)
 
 static void BLE_CCS_Enable(uint8_t conidx)
 {
+    signed int slot = BDK_BLE_GetConnectionSlot(conidx);
+
     if (cs_res.state >= BLE_CCS_READY)
     {
-        if (conidx != INVALID_DEV_IDX)
+        if (slot != INVALID_DEV_IDX)
         {
+            struct BLE_CCS_Connection *con = &cs_res.con[slot];
+
+            /* Characteristics notify without explicit subscription until
+             * peer device disables notifications. */
+            memset(con, 0, sizeof(struct BLE_CCS_Connection));
+            for (uint8_t i = 0; i < CCS_CHAR_NB; ++i)
+            {
+                con->cccd_value[i] = ATT_CCC_START_NTF;
+            }
+
+            /* Multiplexed streaming has to be selected by peer device. */
+            con->cccd_value[CCS_CHAR_IDX(CCS_IDX_MUX_VALUE_CCC)] = 0;
+            con->mtu = ATT_DEFAULT_MTU;
+
             cs_res.state = BLE_CCS_CONNECTED;
         }
         else
@@ -417,18 +771,23 @@ static int BLE_CCS_GATTC_ReadReqInd(ke_msg_id_t const msg_id,
     uint8_t status = GAP_ERR_NO_ERROR;
     uint8_t *val_ptr = NULL;
     uint8_t val_len = 0;
+    uint8_t diag_value[CCS_DIAG_VALUE_MAX_LENGTH];
     uint16_t att_num = 0;
     struct gattc_read_cfm *cfm;
+    struct BLE_CCS_Connection *con;
 
-    int conidx = BDK_BLE_GetConIdx();
+    uint8_t conidx = KE_IDX_GET(src_id);
+    signed int slot = BDK_BLE_GetConnectionSlot(conidx);
 
-    if (conidx == INVALID_DEV_IDX)
+    if (slot == INVALID_DEV_IDX)
     {
         return KE_MSG_CONSUMED;
     }
+    con = &cs_res.con[slot];
 
     /* Get index of characteristic which was requested. */
-    if (param->handle > cs_res.start_hdl)
+    if (param->handle > cs_res.start_hdl
+            && param->handle <= cs_res.start_hdl + CCS_IDX_NB)
     {
         att_num = param->handle - cs_res.start_hdl - 1;
     }
@@ -439,111 +798,40 @@ static int BLE_CCS_GATTC_ReadReqInd(ke_msg_id_t const msg_id,
 
     if (status == GAP_ERR_NO_ERROR)
     {
-        switch (att_num)
+        switch (CCS_ATT_ROLE(att_num))
         {
-        case CCS_IDX_SCP_VALUE_VAL:
-            val_len = cs_res.scp_value_length;
-            val_ptr = cs_res.scp_value;
-            break;
-
-        case CCS_IDX_SCP_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.scp_cccd_value;
-            break;
-
-        case CCS_IDX_SCP_VALUE_USR_DSCP:
-            val_len = CCS_SCP_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_SCP_CHARACTERISTIC_NAME;
-            break;
-
-        case CCS_IDX_LCA_VALUE_VAL:
-            val_len = cs_res.lca_value_length;
-            val_ptr = cs_res.lca_value;
-            break;
-
-        case CCS_IDX_LCA_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.lca_cccd_value;
-            break;
-
-        case CCS_IDX_LCA_VALUE_USR_DSCP:
-            val_len = CCS_LCA_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_LCA_CHARACTERISTIC_NAME;
-            break;
-
-        case CCS_IDX_RCA_VALUE_VAL:
-            val_len = cs_res.rca_value_length;
-            val_ptr = cs_res.rca_value;
-            break;
-
-        case CCS_IDX_RCA_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.rca_cccd_value;
-            break;
-
-        case CCS_IDX_RCA_VALUE_USR_DSCP:
-            val_len = CCS_RCA_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_RCA_CHARACTERISTIC_NAME;
-            break;
-
-        case CCS_IDX_DMIC_VALUE_VAL:
-            val_len = cs_res.dmic_value_length;
-            val_ptr = cs_res.dmic_value;
-            break;
-
-        case CCS_IDX_DMIC_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.dmic_cccd_value;
-            break;
-
-        case CCS_IDX_DMIC_VALUE_USR_DSCP:
-            val_len = CCS_DMIC_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_DMIC_CHARACTERISTIC_NAME;
-            break;
-
-        case CCS_IDX_LCF_VALUE_VAL:
-            val_len = cs_res.lcf_value_length;
-            val_ptr = cs_res.lcf_value;
-            break;
-
-        case CCS_IDX_LCF_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.lcf_cccd_value;
-            break;
-
-        case CCS_IDX_LCF_VALUE_USR_DSCP:
-            val_len = CCS_LCF_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_LCF_CHARACTERISTIC_NAME;
-            break;
-
-        case CCS_IDX_RCF_VALUE_VAL:
-            val_len = cs_res.rcf_value_length;
-            val_ptr = cs_res.rcf_value;
-            break;
-
-        case CCS_IDX_RCF_VALUE_CCC:
-            val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.rcf_cccd_value;
-            break;
-
-        case CCS_IDX_RCF_VALUE_USR_DSCP:
-            val_len = CCS_RCF_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_RCF_CHARACTERISTIC_NAME;
-            break;
+        case CCS_ATT_VAL:
+            if (att_num == CCS_IDX_DIAG_VALUE_VAL)
+            {
+                /* Diagnostics are generated at the time of read. */
+                if (cs_res.diag_read_handler != NULL)
+                {
+                    val_len = cs_res.diag_read_handler(con->diag_page,
+                            diag_value);
+                    val_ptr = diag_value;
+                }
+            }
+            else if ((ccs_att_db[att_num].perm & PERM(RD, ENABLE)) != 0)
+            {
+                struct BLE_CCS_Value *val = &cs_res.value[CCS_CHAR_IDX(att_num)];
 
-        case CCS_IDX_ASCP_VALUE_VAL:
-            val_len = cs_res.ascp_value_length;
-            val_ptr = cs_res.ascp_value;
+                val_len = val->length;
+                val_ptr = (val->ref != NULL) ? (uint8_t*) val->ref : val->value;
+            }
+            else
+            {
+                status = ATT_ERR_READ_NOT_PERMITTED;
+            }
             break;
 
-        case CCS_IDX_ASCP_VALUE_CCC:
+        case CCS_ATT_CCC:
             val_len = 2;
-            val_ptr = (uint8_t*) &cs_res.ascp_cccd_value;
+            val_ptr = (uint8_t*) &con->cccd_value[CCS_CHAR_IDX(att_num)];
             break;
 
-        case CCS_IDX_ASCP_VALUE_USR_DSCP:
-            val_len = CCS_ASCP_CHARACTERISTIC_NAME_LEN;
-            val_ptr = (uint8_t*) CCS_ASCP_CHARACTERISTIC_NAME;
+        case CCS_ATT_USR_DSCP:
+            val_len = ccs_char_name[CCS_CHAR_IDX(att_num)].length;
+            val_ptr = (uint8_t*) ccs_char_name[CCS_CHAR_IDX(att_num)].name;
             break;
 
         default:
@@ -575,14 +863,17 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
 {
     uint8_t status = GAP_ERR_NO_ERROR;
     uint16_t att_num = 0;
-    int conidx = BDK_BLE_GetConIdx();
+    uint8_t conidx = KE_IDX_GET(src_id);
+    signed int slot = BDK_BLE_GetConnectionSlot(conidx);
+    struct BLE_CCS_Connection *con;
     struct gattc_write_cfm *cfm;
 
     /* Check if connection is valid. */
-    if (conidx == INVALID_DEV_IDX)
+    if (slot == INVALID_DEV_IDX)
     {
         return KE_MSG_CONSUMED;
     }
+    con = &cs_res.con[slot];
 
     /* Check that offset is valid */
     if (param->offset != 0)
@@ -591,7 +882,8 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
     }
 
     /* Get index of characteristic which was requested. */
-    if (param->handle > cs_res.start_hdl)
+    if (param->handle > cs_res.start_hdl
+            && param->handle <= cs_res.start_hdl + CCS_IDX_NB)
     {
         att_num = param->handle - cs_res.start_hdl - 1;
     }
@@ -602,45 +894,28 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
 
     if (status == GAP_ERR_NO_ERROR)
     {
-        switch (att_num)
+        switch (CCS_ATT_ROLE(att_num))
         {
-        case CCS_IDX_LCA_VALUE_CCC:
-            if (param->length == 2)
-            {
-                memcpy(&cs_res.lca_cccd_value, param->value, 2);
-            }
-            else
-            {
-                status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-            }
-            break;
-
-        case CCS_IDX_RCA_VALUE_CCC:
-            if (param->length == 2)
-            {
-                memcpy(&cs_res.rca_cccd_value, param->value, 2);
-            }
-            else
-            {
-                status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-            }
-            break;
-
-        case CCS_IDX_DMIC_VALUE_CCC:
-            if (param->length == 2)
+        /* New command was written. */
+        case CCS_ATT_VAL:
+            if ((ccs_att_db[att_num].perm & PERM(WRITE_REQ, ENABLE)) == 0)
             {
-                memcpy(&cs_res.dmic_cccd_value, param->value, 2);
+                status = ATT_ERR_WRITE_NOT_PERMITTED;
             }
-            else
+            else if (att_num == CCS_IDX_DIAG_VALUE_VAL)
             {
-                status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
+                if (param->length == 1)
+                {
+                    con->diag_page = param->value[0];
+                }
+                else
+                {
+                    status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
+                }
             }
-            break;
-
-        case CCS_IDX_LCF_VALUE_CCC:
-            if (param->length == 2)
+            else if (param->length <= CCS_CHARACTERISTIC_VALUE_LENGTH)
             {
-                memcpy(&cs_res.lcf_cccd_value, param->value, 2);
+                BLE_CCS_StoreValue(param->value, param->length, att_num);
             }
             else
             {
@@ -648,23 +923,10 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
             }
             break;
 
-        case CCS_IDX_RCF_VALUE_CCC:
+        case CCS_ATT_CCC:
             if (param->length == 2)
             {
-                memcpy(&cs_res.rcf_cccd_value, param->value, 2);
-            }
-            else
-            {
-                status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-            }
-            break;
-
-            /* New command was written. */
-        case CCS_IDX_SCP_VALUE_VAL:
-            if (param->length <= CCS_CHARACTERISTIC_VALUE_LENGTH)
-            {
-                memcpy(&cs_res.scp_value, param->value, param->length);
-                cs_res.scp_value_length = param->length;
+                memcpy(&con->cccd_value[CCS_CHAR_IDX(att_num)], param->value, 2);
             }
             else
             {
@@ -672,44 +934,9 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
             }
             break;
 
-        case CCS_IDX_SCP_VALUE_CCC:
-            if (param->length == 2)
-            {
-                memcpy(&cs_res.scp_cccd_value, param->value, 2);
-            }
-            else
-            {
-                status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-            }
+        default:
+            status = ATT_ERR_WRITE_NOT_PERMITTED;
             break;
-
-		/* New command was written. */
-	   case CCS_IDX_ASCP_VALUE_VAL:
-		   if (param->length <= CCS_CHARACTERISTIC_VALUE_LENGTH)
-		   {
-			   memcpy(&cs_res.ascp_value, param->value, param->length);
-			   cs_res.ascp_value_length = param->length;
-		   }
-		   else
-		   {
-			   status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-		   }
-		   break;
-
-	   case CCS_IDX_ASCP_VALUE_CCC:
-		   if (param->length == 2)
-		   {
-			   memcpy(&cs_res.ascp_cccd_value, param->value, 2);
-		   }
-		   else
-		   {
-			   status = ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN;
-		   }
-		   break;
-
-	   default:
-		 status = ATT_ERR_WRITE_NOT_PERMITTED;
-		 break;
         }
     }
 
@@ -725,9 +952,10 @@ static int BLE_CCS_GATTC_WriteReqInd(ke_msg_id_t const msg_id,
     if (att_num == CCS_IDX_SCP_VALUE_VAL && cs_res.rx_write_handler != NULL
             && status == GAP_ERR_NO_ERROR)
     {
+        struct BLE_CCS_Value *val = &cs_res.value[CCS_CHAR_IDX(att_num)];
         struct BLE_CCS_RxIndData ind;
-        memcpy(ind.data, cs_res.scp_value, cs_res.scp_value_length);
-        ind.data_len = cs_res.scp_value_length;
+        memcpy(ind.data, val->value, val->length);
+        ind.data_len = val->length;
 
         cs_res.rx_write_handler(&ind);
     }
@@ -739,19 +967,20 @@ static int BLE_CCS_GATTC_AttInfoReqInd(ke_msg_id_t const msg_id,
         struct gattc_read_req_ind const *param, ke_task_id_t const dest_id,
         ke_task_id_t const src_id)
 {
-    int conidx = BDK_BLE_GetConIdx();
+    uint8_t conidx = KE_IDX_GET(src_id);
     uint16_t att_num = 0;
     uint8_t status = GAP_ERR_NO_ERROR;
     struct gattc_att_info_cfm *cfm;
 
     /* Check if connection is valid. */
-    if (conidx == INVALID_DEV_IDX)
+    if (BDK_BLE_GetConnectionSlot(conidx) == INVALID_DEV_IDX)
     {
         return KE_MSG_CONSUMED;
     }
 
     /* Get index of characteristic which was requested. */
-    if (param->handle > cs_res.start_hdl)
+    if (param->handle > cs_res.start_hdl
+            && param->handle <= cs_res.start_hdl + CCS_IDX_NB)
     {
         att_num = param->handle - cs_res.start_hdl - 1;
     }
@@ -760,7 +989,8 @@ static int BLE_CCS_GATTC_AttInfoReqInd(ke_msg_id_t const msg_id,
         status = ATT_ERR_INVALID_HANDLE;
     }
 
-    if (att_num == CCS_IDX_SCP_VALUE_VAL)
+    if (status == GAP_ERR_NO_ERROR && CCS_ATT_ROLE(att_num) == CCS_ATT_VAL
+            && (ccs_att_db[att_num].perm & PERM(WRITE_REQ, ENABLE)) != 0)
     {
         cfm = KE_MSG_ALLOC(GATTC_ATT_INFO_CFM, KE_BUILD_ID(TASK_GATTC, conidx),
                 TASK_APP, gattc_att_info_cfm);
@@ -778,6 +1008,29 @@ static int BLE_CCS_GATTC_CmpEvt(ke_msg_id_t const msg_id,
         struct gattc_cmp_evt const *param, ke_task_id_t const dest_id,
         ke_task_id_t const src_id)
 {
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    /* Notification left the queue of this connection. */
+    if (param->operation == GATTC_NOTIFY && slot != INVALID_DEV_IDX
+            && cs_res.con[slot].tx_pending > 0)
+    {
+        cs_res.con[slot].tx_pending -= 1;
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_CCS_GATTC_MtuChangedInd(ke_msg_id_t const msg_id,
+        struct gattc_mtu_changed_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    if (slot != INVALID_DEV_IDX)
+    {
+        cs_res.con[slot].mtu = param->mtu;
+    }
+
     return KE_MSG_CONSUMED;
 }
 
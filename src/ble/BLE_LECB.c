@@ -0,0 +1,426 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BLE_LECB.c
+//! \version v1.0.0
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup BLE_GRP
+//! \{
+//! \addtogroup LECB
+//! \{
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// INCLUDES
+//-----------------------------------------------------------------------------
+
+#include <BDK_Task.h>
+#include <HAL_error.h>
+#include <BLE_LECB.h>
+
+//-----------------------------------------------------------------------------
+// DEFINES / CONSTANTS
+//-----------------------------------------------------------------------------
+
+/** \brief Length of SDU length field carried in the first K-frame of SDU. */
+#define LECB_SDU_LENGTH_FIELD          (2)
+
+/** \brief Shortest SDU that is able to carry a frame of maximal length. */
+#define LECB_SDU_MIN_LENGTH            (BLE_LECB_SDU_HEADER_LENGTH + \
+                                        BLE_LECB_FRAME_HEADER_LENGTH + \
+                                        BLE_LECB_FRAME_MAX_LENGTH)
+
+//-----------------------------------------------------------------------------
+// EXTERNAL / FORWARD DECLARATIONS
+//-----------------------------------------------------------------------------
+
+//! \name Internal Functions
+//! \{
+
+static void BLE_LECB_ServiceAdd(void);
+
+static void BLE_LECB_Enable(uint8_t conidx);
+
+static void BLE_LECB_CheckOwner(void);
+
+static bool BLE_LECB_SendSdu(void);
+
+static void BLE_LECB_SendIfFull(void);
+
+static int BLE_LECB_L2CC_ConnectReqInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_connect_req_ind const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id);
+
+static int BLE_LECB_L2CC_ConnectInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_connect_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+static int BLE_LECB_L2CC_DisconnectInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_disconnect_ind const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id);
+
+static int BLE_LECB_L2CC_AddInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_add_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+static int BLE_LECB_L2CC_SduRecvInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_sdu_recv_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+static int BLE_LECB_L2CC_CmpEvt(ke_msg_id_t const msg_id,
+        struct l2cc_cmp_evt const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id);
+
+//! \}
+
+//-----------------------------------------------------------------------------
+// INTERNAL / STATIC VARIABLES
+//-----------------------------------------------------------------------------
+
+static struct BLE_LECB_Resources lecb_res = { 0 };
+
+//-----------------------------------------------------------------------------
+// FUNCTION DEFINITIONS
+//-----------------------------------------------------------------------------
+
+void BLE_LECB_Initialize(uint16_t le_psm)
+{
+    if (lecb_res.state == BLE_LECB_OFF)
+    {
+        BDK_BLE_Initialize();
+
+        memset(&lecb_res, 0, sizeof(lecb_res));
+        lecb_res.state = BLE_LECB_REGISTER;
+        lecb_res.le_psm = le_psm;
+
+        BDK_TaskAddMsgHandler(L2CC_LECB_CONNECT_REQ_IND,
+                (ke_msg_func_t) &BLE_LECB_L2CC_ConnectReqInd);
+        BDK_TaskAddMsgHandler(L2CC_LECB_CONNECT_IND,
+                (ke_msg_func_t) &BLE_LECB_L2CC_ConnectInd);
+        BDK_TaskAddMsgHandler(L2CC_LECB_DISCONNECT_IND,
+                (ke_msg_func_t) &BLE_LECB_L2CC_DisconnectInd);
+        BDK_TaskAddMsgHandler(L2CC_LECB_ADD_IND,
+                (ke_msg_func_t) &BLE_LECB_L2CC_AddInd);
+        BDK_TaskAddMsgHandler(L2CC_LECB_SDU_RECV_IND,
+                (ke_msg_func_t) &BLE_LECB_L2CC_SduRecvInd);
+        BDK_TaskAddMsgHandler(L2CC_CMP_EVT,
+                (ke_msg_func_t) &BLE_LECB_L2CC_CmpEvt);
+
+        BDK_BLE_AddService(&BLE_LECB_ServiceAdd, &BLE_LECB_Enable);
+    }
+}
+
+bool BLE_LECB_IsOpen(void)
+{
+    BLE_LECB_CheckOwner();
+
+    return (lecb_res.state == BLE_LECB_OPEN);
+}
+
+uint32_t BLE_LECB_Write(uint8_t provider_id, const uint8_t *data, uint8_t data_len)
+{
+    BLE_LECB_CheckOwner();
+
+    if (lecb_res.state != BLE_LECB_OPEN)
+    {
+        return 1;
+    }
+
+    if (data_len == 0 || data_len > BLE_LECB_FRAME_MAX_LENGTH)
+    {
+        return 2;
+    }
+
+    /* Frame does not fit into current SDU -> SDU has to leave first. */
+    if (lecb_res.sdu_length + BLE_LECB_FRAME_HEADER_LENGTH + data_len
+            > lecb_res.sdu_max_length)
+    {
+        if (BLE_LECB_SendSdu() == false)
+        {
+            lecb_res.frames_dropped += 1;
+            return 3;
+        }
+    }
+
+    if (lecb_res.sdu_length == 0)
+    {
+        lecb_res.sdu[0] = lecb_res.tx_seq;
+        lecb_res.sdu_length = BLE_LECB_SDU_HEADER_LENGTH;
+    }
+
+    lecb_res.sdu[lecb_res.sdu_length] = provider_id;
+    lecb_res.sdu[lecb_res.sdu_length + 1] = data_len;
+    memcpy(&lecb_res.sdu[lecb_res.sdu_length + BLE_LECB_FRAME_HEADER_LENGTH],
+            data, data_len);
+    lecb_res.sdu_length += BLE_LECB_FRAME_HEADER_LENGTH + data_len;
+
+    BLE_LECB_SendIfFull();
+
+    return 0;
+}
+
+const struct BLE_LECB_Resources* BLE_LECB_GetResources(void)
+{
+    return &lecb_res;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : bool BLE_LECB_SendSdu(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Hand over assembled SDU to L2CC task if peer device granted
+ *                 enough credits to receive all of its K-frames
+ * Inputs        : None
+ * Outputs       : return value - false if SDU could not be sent and is still
+ *                                pending
+ * Assumptions   : Channel is open.
+ * ------------------------------------------------------------------------- */
+static bool BLE_LECB_SendSdu(void)
+{
+    struct l2cc_lecb_sdu_send_cmd *cmd;
+    uint16_t credit;
+
+    if (lecb_res.sdu_length <= BLE_LECB_SDU_HEADER_LENGTH)
+    {
+        return true;
+    }
+
+    if (BDK_BLE_GetConnectionSlot(lecb_res.conidx) == INVALID_DEV_IDX
+            || lecb_res.tx_pending >= BLE_LECB_TX_QUEUE_MAX)
+    {
+        return false;
+    }
+
+    /* Each K-frame consumes one credit, first one also carries SDU length. */
+    credit = (lecb_res.sdu_length + LECB_SDU_LENGTH_FIELD + lecb_res.peer_mps - 1)
+            / lecb_res.peer_mps;
+    if (credit > lecb_res.peer_credit)
+    {
+        return false;
+    }
+
+    cmd = KE_MSG_ALLOC_DYN(L2CC_LECB_SDU_SEND_CMD,
+            KE_BUILD_ID(TASK_L2CC, lecb_res.conidx), TASK_APP,
+            l2cc_lecb_sdu_send_cmd, lecb_res.sdu_length);
+    cmd->operation = L2CC_LECB_SDU_SEND;
+    cmd->offset = 0;
+    cmd->sdu.cid = lecb_res.local_cid;
+    cmd->sdu.credit = 0;
+    cmd->sdu.length = lecb_res.sdu_length;
+    memcpy(cmd->sdu.data, lecb_res.sdu, lecb_res.sdu_length);
+
+    ke_msg_send(cmd);
+
+    lecb_res.peer_credit -= credit;
+    lecb_res.tx_pending += 1;
+    if (lecb_res.tx_pending > lecb_res.tx_pending_max)
+    {
+        lecb_res.tx_pending_max = lecb_res.tx_pending;
+    }
+    lecb_res.tx_seq += 1;
+    lecb_res.sdu_length = 0;
+
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : void BLE_LECB_SendIfFull(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Send assembled SDU once it can not fit another frame of
+ *                 maximal length
+ * Inputs        : None
+ * Outputs       : None
+ * Assumptions   : Channel is open.
+ * ------------------------------------------------------------------------- */
+static void BLE_LECB_SendIfFull(void)
+{
+    if (lecb_res.sdu_length + BLE_LECB_FRAME_HEADER_LENGTH
+            + BLE_LECB_FRAME_MAX_LENGTH > lecb_res.sdu_max_length)
+    {
+        BLE_LECB_SendSdu();
+    }
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : void BLE_LECB_CheckOwner(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Close the channel once the central device that opened it
+ *                 is disconnected
+ * Inputs        : None
+ * Outputs       : None
+ * Assumptions   : L2CC_LECB_DISCONNECT_IND is not sent when the link itself
+ *                 is lost, so the connection slot is checked instead.
+ * ------------------------------------------------------------------------- */
+static void BLE_LECB_CheckOwner(void)
+{
+    if (lecb_res.state == BLE_LECB_OPEN
+            && BDK_BLE_GetConnectionSlot(lecb_res.conidx) == INVALID_DEV_IDX)
+    {
+        lecb_res.state = BLE_LECB_READY;
+        lecb_res.sdu_length = 0;
+        lecb_res.tx_pending = 0;
+    }
+}
+
+static void BLE_LECB_ServiceAdd(void)
+{
+    struct gapm_lepsm_register_cmd *cmd;
+
+    if (lecb_res.state == BLE_LECB_REGISTER)
+    {
+        cmd = KE_MSG_ALLOC(GAPM_LEPSM_REGISTER_CMD, TASK_GAPM, TASK_APP,
+                gapm_lepsm_register_cmd);
+        cmd->operation = GAPM_LEPSM_REG;
+        cmd->le_psm = lecb_res.le_psm;
+        cmd->app_task = TASK_APP;
+
+        /* No security requirements, same as for CCS characteristics. */
+        cmd->sec_lvl = 0;
+
+        ke_msg_send(cmd);
+    }
+}
+
+static void BLE_LECB_Enable(uint8_t conidx)
+{
+    /* LE_PSM registration is complete once any peer device can connect.
+     * Channel is dropped only if the device that opened it is gone, other
+     * central devices connecting must not reset it. */
+    if (lecb_res.state == BLE_LECB_REGISTER)
+    {
+        lecb_res.state = BLE_LECB_READY;
+        lecb_res.sdu_length = 0;
+        lecb_res.tx_pending = 0;
+    }
+    else
+    {
+        BLE_LECB_CheckOwner();
+    }
+}
+
+static int BLE_LECB_L2CC_ConnectReqInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_connect_req_ind const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct l2cc_lecb_connect_cfm *cfm;
+
+    cfm = KE_MSG_ALLOC(L2CC_LECB_CONNECT_CFM, src_id, TASK_APP,
+            l2cc_lecb_connect_cfm);
+    cfm->peer_cid = param->peer_cid;
+    cfm->accept = (lecb_res.state == BLE_LECB_READY
+            && param->le_psm == lecb_res.le_psm
+            && param->max_sdu >= LECB_SDU_MIN_LENGTH);
+
+    ke_msg_send(cfm);
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_LECB_L2CC_ConnectInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_connect_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    if (param->status == GAP_ERR_NO_ERROR && lecb_res.state == BLE_LECB_READY
+            && param->le_psm == lecb_res.le_psm)
+    {
+        lecb_res.state = BLE_LECB_OPEN;
+        lecb_res.conidx = KE_IDX_GET(src_id);
+        lecb_res.local_cid = param->local_cid;
+        lecb_res.peer_credit = param->peer_credit;
+        lecb_res.peer_mtu = param->peer_mtu;
+        lecb_res.peer_mps = param->peer_mps;
+        lecb_res.sdu_max_length = (param->peer_mtu < BLE_LECB_SDU_MAX_LENGTH) ?
+                param->peer_mtu : BLE_LECB_SDU_MAX_LENGTH;
+        lecb_res.sdu_length = 0;
+        lecb_res.tx_pending = 0;
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_LECB_L2CC_DisconnectInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_disconnect_ind const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    if (lecb_res.state == BLE_LECB_OPEN
+            && KE_IDX_GET(src_id) == lecb_res.conidx
+            && param->local_cid == lecb_res.local_cid)
+    {
+        lecb_res.state = BLE_LECB_READY;
+        lecb_res.sdu_length = 0;
+        lecb_res.tx_pending = 0;
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_LECB_L2CC_AddInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_add_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    if (lecb_res.state == BLE_LECB_OPEN
+            && param->local_cid == lecb_res.local_cid)
+    {
+        lecb_res.peer_credit += param->peer_added_credit;
+
+        /* Release SDU that was held back because of missing credits. */
+        BLE_LECB_SendIfFull();
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_LECB_L2CC_SduRecvInd(ke_msg_id_t const msg_id,
+        struct l2cc_lecb_sdu_recv_ind const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    struct l2cc_lecb_add_cmd *cmd;
+
+    /* Stream control is done over CCS, received data are discarded and
+     * consumed credits are returned to peer device. */
+    if (lecb_res.state == BLE_LECB_OPEN)
+    {
+        cmd = KE_MSG_ALLOC(L2CC_LECB_ADD_CMD, src_id, TASK_APP,
+                l2cc_lecb_add_cmd);
+        cmd->operation = L2CC_LECB_CREDIT_ADD;
+        cmd->local_cid = lecb_res.local_cid;
+        cmd->credit = (param->sdu.credit > 0) ?
+                param->sdu.credit : BLE_LECB_LOCAL_CREDIT;
+
+        ke_msg_send(cmd);
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+static int BLE_LECB_L2CC_CmpEvt(ke_msg_id_t const msg_id,
+        struct l2cc_cmp_evt const *param, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id)
+{
+    if (param->operation == L2CC_LECB_SDU_SEND && lecb_res.tx_pending > 0)
+    {
+        lecb_res.tx_pending -= 1;
+
+        if (lecb_res.state == BLE_LECB_OPEN)
+        {
+            BLE_LECB_SendIfFull();
+        }
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+//! \}
+//! \}
+//! \}
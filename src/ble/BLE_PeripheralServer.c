@@ -52,6 +52,16 @@ enum BLE_State
     BLE_STATE_MAX
 };
 
+struct BLE_Connection
+{
+    uint16_t conhdl; /**< Connection handle */
+    uint8_t conidx; /**< Connection index, GAP_INVALID_CONIDX if slot is free */
+    struct gap_bdaddr peer_addr; /**< Address used by peer device */
+    bool bonded; /**< Peer device is the bonded device */
+    bool resume_pending; /**< Notify application once link is encrypted */
+    struct BDK_BLE_ConParam param; /**< Current link parameters */
+};
+
 struct BLE_Resources
 {
     enum BLE_State state;
@@ -66,9 +76,18 @@ struct BLE_Resources
     uint8_t baddr_type;
     uint16_t adv_int_min;
     uint16_t adv_int_max;
+    bool adv_restart; /**< Restart advertising once cancel completes */
+    bool adv_directed; /**< Running advertising is directed */
 
-    uint16_t conhdl; /**< Connection handle */
-    uint8_t conidx; /**< Connection index */
+    struct BDK_BLE_Bond bond; /**< Bonded central device */
+    struct gapc_ltk bond_ltk; /**< LTK of pairing in progress */
+    struct gapc_irk bond_irk; /**< Identity received in pairing in progress */
+    bool bond_irk_valid; /**< Central device distributed its identity */
+    enum BDK_BLE_ReconnectMode reconnect_mode;
+    bool reconnect_pending; /**< Bonded device disconnected */
+
+    struct BLE_Connection con[BDK_BLE_MASTER_MAX]; /**< Active connections */
+    uint8_t con_count; /**< Number of active connections */
 
     BDK_BLE_SVC_AddFunc svc_add_func[BDK_BLE_SVC_MAX];
     BDK_BLE_SVC_EnableFunc svc_enable_func[BDK_BLE_SVC_MAX];
@@ -89,11 +108,18 @@ static int GAPC_ConnectionReqInd( ke_msg_id_t const msg_id, struct gapc_connecti
 static int GAPC_CmpEvt(           ke_msg_id_t const msg_id, struct gapc_cmp_evt const *param,              ke_task_id_t const dest_id, ke_task_id_t const src_id);
 static int GAPC_DisconnectInd(    ke_msg_id_t const msg_id, struct gapc_disconnect_ind const *param,       ke_task_id_t const dest_id, ke_task_id_t const src_id);
 static int GAPC_ParamUpdatedInd(  ke_msg_id_t const msg_id, struct gapc_param_updated_ind const *param,    ke_task_id_t const dest_id, ke_task_id_t const src_id);
+static int GAPC_LePhyInd(         ke_msg_id_t const msg_id, struct gapc_le_phy_ind const *param,          ke_task_id_t const dest_id, ke_task_id_t const src_id);
 static int GAPC_ParamUpdateReqInd(ke_msg_id_t const msg_id, struct gapc_param_update_req_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id);
+static int GAPC_BondReqInd(       ke_msg_id_t const msg_id, struct gapc_bond_req_ind const *param,         ke_task_id_t const dest_id, ke_task_id_t const src_id);
+static int GAPC_BondInd(          ke_msg_id_t const msg_id, struct gapc_bond_ind const *param,             ke_task_id_t const dest_id, ke_task_id_t const src_id);
+static int GAPC_EncryptReqInd(    ke_msg_id_t const msg_id, struct gapc_encrypt_req_ind const *param,      ke_task_id_t const dest_id, ke_task_id_t const src_id);
+static int GAPC_EncryptInd(       ke_msg_id_t const msg_id, struct gapc_encrypt_ind const *param,          ke_task_id_t const dest_id, ke_task_id_t const src_id);
 
 static bool BDK_BLE_ServiceAdd(void);
-static void BDK_BLE_SendConnectionConfirmation(void);
-static void BDK_BLE_SetServiceState(bool enable);
+static void BDK_BLE_SendConnectionConfirmation(uint8_t conidx);
+static void BDK_BLE_UpdateWhiteList(void);
+static bool BDK_BLE_IsBondAddrStable(void);
+static void BDK_BLE_SetServiceState(bool enable, uint8_t conidx);
 
 //-----------------------------------------------------------------------------
 // INTERNAL / STATIC VARIABLES
@@ -121,6 +147,10 @@ void BDK_BLE_Initialize(void)
 
     memset(&ble_env, 0, sizeof(ble_env));
     ble_env.state = BLE_STATE_INIT;
+    for (uint8_t i = 0; i < BDK_BLE_MASTER_MAX; ++i)
+    {
+        ble_env.con[i].conidx = GAP_INVALID_CONIDX;
+    }
     ble_env.adv_int_min = BDK_BLE_ADV_INT_DEFAULT;
     ble_env.adv_int_max = BDK_BLE_ADV_INT_DEFAULT;
     BDK_BLE_SetLocalName(BDK_BLE_DEFAULT_LOCAL_NAME);
@@ -134,6 +164,7 @@ void BDK_BLE_Initialize(void)
     BDK_TaskAddMsgHandler(GAPC_DISCONNECT_IND, (ke_msg_func_t)GAPC_DisconnectInd);
     BDK_TaskAddMsgHandler(GAPC_GET_DEV_INFO_REQ_IND, (ke_msg_func_t)GAPC_GetDevInfoReqInd);
     BDK_TaskAddMsgHandler(GAPC_PARAM_UPDATED_IND, (ke_msg_func_t)GAPC_ParamUpdatedInd);
+    BDK_TaskAddMsgHandler(GAPC_LE_PHY_IND, (ke_msg_func_t)GAPC_LePhyInd);
     BDK_TaskAddMsgHandler(GAPC_PARAM_UPDATE_REQ_IND, (ke_msg_func_t)GAPC_ParamUpdateReqInd);
 
     /* Initialize Bluetooth stack */
@@ -189,7 +220,7 @@ void BDK_BLE_Initialize(void)
     bdk_gapm_conf_cmd->sugg_max_tx_time = BDK_BLE_TX_TIME_MAX;
     bdk_gapm_conf_cmd->tx_pref_rates = GAP_RATE_ANY;
     bdk_gapm_conf_cmd->rx_pref_rates = GAP_RATE_ANY;
-    bdk_gapm_conf_cmd->max_nb_lecb = 0x0;
+    bdk_gapm_conf_cmd->max_nb_lecb = BDK_BLE_LECB_MAX;
     bdk_gapm_conf_cmd->audio_cfg = 0;
 
     struct gapm_reset_cmd *cmd;
@@ -246,8 +277,23 @@ void BDK_BLE_SetAdvertisementInterval(uint16_t interval_min, uint16_t interval_m
         BDK_BLE_Initialize();
     }
 
+    if (interval_min == ble_env.adv_int_min
+            && interval_max == ble_env.adv_int_max)
+    {
+        return;
+    }
+
     ble_env.adv_int_min = interval_min;
     ble_env.adv_int_max = interval_max;
+
+    /* Advertising parameters can not be changed on the fly, cancel running
+     * advertising and start it again once GAPM confirms the cancel.
+     * Directed advertising does not use the interval. */
+    if (ble_env.state == BLE_STATE_ADVERTISING && ble_env.adv_directed == false)
+    {
+        BDK_BLE_AdvertisingStop();
+        ble_env.adv_restart = true;
+    }
 }
 
 void BDK_BLE_AddService(void (*svc_add_func)(void), void (*svc_enable_func)(uint8_t))
@@ -384,12 +430,38 @@ static int GAPM_CmpEvt(ke_msg_id_t const msg_id, struct gapm_cmp_evt const *para
         }
         break;
 
+        /* LE_PSM was registered -> continue with next service */
+        case GAPM_LEPSM_REG:
+        {
+            ASSERT_DEBUG(param->status == GAP_ERR_NO_ERROR);
+            BDK_BLE_ProfileAddedInd();
+        }
+        break;
+
         /* Device started/stoped advertising */
         case GAPM_ADV_UNDIRECT:
+        case GAPM_ADV_DIRECT:
             TRACE_PRINTF("operation=%d, status=%d\r\n", param->operation,
                     param->status);
             ASSERT_DEBUG(param->status == GAP_ERR_NO_ERROR
-                            || param->status == GAP_ERR_CANCELED);
+                            || param->status == GAP_ERR_CANCELED
+                            || param->status == GAP_ERR_TIMEOUT);
+
+            /* Bonded device did not answer directed advertising */
+            if (param->status == GAP_ERR_TIMEOUT
+                    && ble_env.state == BLE_STATE_ADVERTISING)
+            {
+                ble_env.reconnect_pending = false;
+                ble_env.state = (ble_env.con_count > 0) ? BLE_STATE_CONNECTED : BLE_STATE_READY;
+                BDK_BLE_AdvertisingStart();
+            }
+
+            /* Advertising was cancelled to apply new interval */
+            if (ble_env.adv_restart == true)
+            {
+                ble_env.adv_restart = false;
+                BDK_BLE_AdvertisingStart();
+            }
             break;
 
         default:
@@ -496,19 +568,33 @@ static int GAPC_GetDevInfoReqInd(ke_msg_id_t const msg_id, struct gapc_get_dev_i
  * ------------------------------------------------------------------------- */
 static int GAPC_ConnectionReqInd(ke_msg_id_t const msg_id, struct gapc_connection_req_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
-    if (ble_env.state != BLE_STATE_CONNECTED)
-    {
-        ble_env.conidx = KE_IDX_GET(src_id);
-        if (ble_env.conidx != GAP_INVALID_CONIDX)
-        {
-            ble_env.state = BLE_STATE_CONNECTED;
-            ble_env.conhdl = param->conhdl;
+    uint8_t conidx = KE_IDX_GET(src_id);
+    signed int slot = BDK_BLE_GetConnectionSlot(GAP_INVALID_CONIDX);
 
-            BDK_BLE_SendConnectionConfirmation();
-            BDK_BLE_SetServiceState(true);
-
-            App_PeerDeviceConnected();
-        }
+    if (conidx != GAP_INVALID_CONIDX && slot != INVALID_DEV_IDX)
+    {
+        ble_env.con[slot].conidx = conidx;
+        ble_env.con[slot].conhdl = param->conhdl;
+        ble_env.con[slot].peer_addr.addr_type = param->peer_addr_type;
+        memcpy(ble_env.con[slot].peer_addr.addr.addr, param->peer_addr.addr,
+                BDK_BLE_BADDR_LENGTH);
+        ble_env.con[slot].bonded = false;
+        ble_env.con[slot].resume_pending = false;
+        ble_env.con[slot].param.interval = param->con_interval;
+        ble_env.con[slot].param.latency = param->con_latency;
+        ble_env.con[slot].param.sup_to = param->sup_to;
+        ble_env.con[slot].param.tx_phy = GAP_PHY_LE_1MBPS;
+        ble_env.con[slot].param.rx_phy = GAP_PHY_LE_1MBPS;
+        ble_env.con_count += 1;
+
+        /* Connectable advertising is stopped by the stack on connection. */
+        ble_env.state = BLE_STATE_CONNECTED;
+        ble_env.reconnect_pending = false;
+
+        BDK_BLE_SendConnectionConfirmation(conidx);
+        BDK_BLE_SetServiceState(true, conidx);
+
+        App_PeerDeviceConnected();
     }
 
     return KE_MSG_CONSUMED;
@@ -557,19 +643,43 @@ static int GAPC_CmpEvt(ke_msg_id_t const msg_id, struct gapc_cmp_evt const *para
  * ------------------------------------------------------------------------- */
 static int GAPC_DisconnectInd(ke_msg_id_t const msg_id, struct gapc_disconnect_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
-    if (ble_env.state != BLE_STATE_CONNECTED)
+    uint8_t conidx = KE_IDX_GET(src_id);
+    signed int slot = BDK_BLE_GetConnectionSlot(conidx);
+
+    if (slot == INVALID_DEV_IDX)
     {
         return (KE_MSG_CONSUMED);
     }
 
-    /* Go to the ready state */
-    ble_env.state = BLE_STATE_READY;
-    ble_env.conidx = INVALID_DEV_IDX;
+    /* Bonded device is invited back with reconnect advertising */
+    if (ble_env.con[slot].bonded == true
+            && ble_env.reconnect_mode != BDK_BLE_RECONNECT_NONE)
+    {
+        ble_env.reconnect_pending = true;
+    }
+
+    ble_env.con[slot].conidx = GAP_INVALID_CONIDX;
+    ble_env.con_count -= 1;
+
+    /* Go to the ready state once the last peer device is gone */
+    if (ble_env.con_count == 0 && ble_env.state == BLE_STATE_CONNECTED)
+    {
+        ble_env.state = BLE_STATE_READY;
+    }
 
     /* Disable services for this connection */
-    BDK_BLE_SetServiceState(false);
+    BDK_BLE_SetServiceState(false, conidx);
 
-    App_PeerDeviceDisconnected();
+    /* Application is notified only when the last peer device disconnects.
+     * Otherwise it is told that the freed slot is being advertised again. */
+    if (ble_env.con_count == 0)
+    {
+        App_PeerDeviceDisconnected();
+    }
+    else
+    {
+        App_PeerDeviceSlotReleased();
+    }
 
     return KE_MSG_CONSUMED;
 }
@@ -594,6 +704,44 @@ static int GAPC_DisconnectInd(ke_msg_id_t const msg_id, struct gapc_disconnect_i
  * ------------------------------------------------------------------------- */
 static int GAPC_ParamUpdatedInd(ke_msg_id_t const msg_id, struct gapc_param_updated_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    if (slot != INVALID_DEV_IDX)
+    {
+        ble_env.con[slot].param.interval = param->con_interval;
+        ble_env.con[slot].param.latency = param->con_latency;
+        ble_env.con[slot].param.sup_to = param->sup_to;
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : int GAPC_LePhyInd(ke_msg_id_t const msg_id,
+ *                                   struct gapc_le_phy_ind const *param,
+ *                                   ke_task_id_t const dest_id,
+ *                                   ke_task_id_t const src_id)
+ * ----------------------------------------------------------------------------
+ * Description   : Handle PHY change indication received from GAP controller
+ * Inputs        : - msg_id     - Kernel message ID number
+ *                 - param      - Message parameters in format of
+ *                                struct gapc_le_phy_ind
+ *                 - dest_id    - Destination task ID number
+ *                 - src_id     - Source task ID number
+ * Outputs       : return value - Indicate if the message was consumed;
+ *                                compare with KE_MSG_CONSUMED
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static int GAPC_LePhyInd(ke_msg_id_t const msg_id, struct gapc_le_phy_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    if (slot != INVALID_DEV_IDX)
+    {
+        ble_env.con[slot].param.tx_phy = param->tx_phy;
+        ble_env.con[slot].param.rx_phy = param->rx_phy;
+    }
+
     return KE_MSG_CONSUMED;
 }
 
@@ -608,13 +756,14 @@ static int GAPC_ParamUpdatedInd(ke_msg_id_t const msg_id, struct gapc_param_upda
 static int GAPC_ParamUpdateReqInd(ke_msg_id_t const msg_id, struct gapc_param_update_req_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
 {
     struct gapc_param_update_cfm *cfm;
+    uint8_t conidx = KE_IDX_GET(src_id);
 
-    if (ble_env.state != BLE_STATE_CONNECTED)
+    if (BDK_BLE_GetConnectionSlot(conidx) == INVALID_DEV_IDX)
     {
         return KE_MSG_CONSUMED;
     }
 
-    cfm = KE_MSG_ALLOC(GAPC_PARAM_UPDATE_CFM, KE_BUILD_ID(TASK_GAPC, ble_env.conidx), KE_BUILD_ID(TASK_APP, 0), gapc_param_update_cfm);
+    cfm = KE_MSG_ALLOC(GAPC_PARAM_UPDATE_CFM, KE_BUILD_ID(TASK_GAPC, conidx), KE_BUILD_ID(TASK_APP, 0), gapc_param_update_cfm);
     cfm->accept = 1;
     cfm->ce_len_max = 0xFFFF;
     cfm->ce_len_min = 0xFFFF;
@@ -625,6 +774,301 @@ static int GAPC_ParamUpdateReqInd(ke_msg_id_t const msg_id, struct gapc_param_up
     return (KE_MSG_CONSUMED);
 }
 
+/* ----------------------------------------------------------------------------
+ * Function      : int GAPC_BondReqInd(ke_msg_id_t const msg_id,
+ *                                     struct gapc_bond_req_ind
+ *                                     const *param,
+ *                                     ke_task_id_t const dest_id,
+ *                                     ke_task_id_t const src_id)
+ * ----------------------------------------------------------------------------
+ * Description   : Handle pairing requests of central device and provide keys
+ *                 generated by this device
+ * Inputs        : - msg_id     - Kernel message ID number
+ *                 - param      - Message parameters in format of
+ *                                struct gapc_bond_req_ind
+ *                 - dest_id    - Destination task ID number
+ *                 - src_id     - Source task ID number
+ * Outputs       : return value - Indicate if the message was consumed;
+ *                                compare with KE_MSG_CONSUMED
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static int GAPC_BondReqInd(ke_msg_id_t const msg_id, struct gapc_bond_req_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct gapc_bond_cfm *cfm;
+
+    cfm = KE_MSG_ALLOC(GAPC_BOND_CFM, src_id, TASK_APP, gapc_bond_cfm);
+    cfm->request = param->request;
+    cfm->accept = false;
+
+    switch (param->request)
+    {
+        case GAPC_PAIRING_REQ:
+        {
+            /* Just works pairing, central device distributes its identity. */
+            ble_env.bond_irk_valid = false;
+            cfm->request = GAPC_PAIRING_RSP;
+            cfm->accept = true;
+            cfm->data.pairing_feat.iocap = GAP_IO_CAP_NO_INPUT_NO_OUTPUT;
+            cfm->data.pairing_feat.oob = GAP_OOB_AUTH_DATA_NOT_PRESENT;
+            cfm->data.pairing_feat.auth = GAP_AUTH_REQ_NO_MITM_BOND;
+            cfm->data.pairing_feat.key_size = KEY_LEN;
+            cfm->data.pairing_feat.ikey_dist = GAP_KDIST_IDKEY;
+            cfm->data.pairing_feat.rkey_dist = GAP_KDIST_ENCKEY;
+            cfm->data.pairing_feat.sec_req = GAP_NO_SEC;
+        }
+        break;
+
+        case GAPC_LTK_EXCH:
+        {
+            /* Generate LTK, it becomes valid once pairing succeeds. */
+            for (uint8_t i = 0; i < KEY_LEN; ++i)
+            {
+                ble_env.bond_ltk.ltk.key[i] = (uint8_t)co_rand_word();
+            }
+            for (uint8_t i = 0; i < GAP_RAND_NB_LEN; ++i)
+            {
+                ble_env.bond_ltk.randnb.nb[i] = (uint8_t)co_rand_word();
+            }
+            ble_env.bond_ltk.ediv = (uint16_t)co_rand_word();
+            ble_env.bond_ltk.key_size = KEY_LEN;
+
+            cfm->accept = true;
+            cfm->data.ltk = ble_env.bond_ltk;
+        }
+        break;
+
+        case GAPC_CSRK_EXCH:
+        {
+            /* Signed writes are not used. */
+            cfm->accept = true;
+            memset(&cfm->data.csrk, 0, sizeof(struct gap_sec_key));
+        }
+        break;
+
+        default:
+        {
+            /* TK exchange is not used with just works pairing. */
+        }
+        break;
+    }
+
+    ke_msg_send(cfm);
+
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : int GAPC_BondInd(ke_msg_id_t const msg_id,
+ *                                  struct gapc_bond_ind
+ *                                  const *param,
+ *                                  ke_task_id_t const dest_id,
+ *                                  ke_task_id_t const src_id)
+ * ----------------------------------------------------------------------------
+ * Description   : Handle pairing result and keys received from central device
+ * Inputs        : - msg_id     - Kernel message ID number
+ *                 - param      - Message parameters in format of
+ *                                struct gapc_bond_ind
+ *                 - dest_id    - Destination task ID number
+ *                 - src_id     - Source task ID number
+ * Outputs       : return value - Indicate if the message was consumed;
+ *                                compare with KE_MSG_CONSUMED
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static int GAPC_BondInd(ke_msg_id_t const msg_id, struct gapc_bond_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    if (slot == INVALID_DEV_IDX)
+    {
+        return KE_MSG_CONSUMED;
+    }
+
+    switch (param->info)
+    {
+        case GAPC_PAIRING_SUCCEED:
+        {
+            /* Only the last bonded device is remembered. */
+            ble_env.bond.valid = true;
+            ble_env.bond.auth = param->data.auth.info;
+            ble_env.bond.peer_addr = ble_env.con[slot].peer_addr;
+            ble_env.bond.id_addr = ble_env.con[slot].peer_addr;
+            ble_env.bond.ltk = ble_env.bond_ltk;
+            memset(&ble_env.bond.irk, 0, sizeof(ble_env.bond.irk));
+            if (ble_env.bond_irk_valid == true)
+            {
+                ble_env.bond.id_addr = ble_env.bond_irk.addr;
+                ble_env.bond.irk = ble_env.bond_irk.irk;
+            }
+            ble_env.con[slot].bonded = true;
+
+            BDK_BLE_UpdateWhiteList();
+
+            TRACE_PRINTF("Bonded with peer device\r\n");
+        }
+        break;
+
+        case GAPC_IRK_EXCH:
+        {
+            /* Stored once pairing succeeds, it may still fail. */
+            ble_env.bond_irk = param->data.irk;
+            ble_env.bond_irk_valid = true;
+        }
+        break;
+
+        case GAPC_PAIRING_FAILED:
+        {
+            TRACE_PRINTF("Pairing failed, reason=%d\r\n", param->data.reason);
+        }
+        break;
+
+        default:
+        {
+            /* No action required for other keys */
+        }
+        break;
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : int GAPC_EncryptReqInd(ke_msg_id_t const msg_id,
+ *                                        struct gapc_encrypt_req_ind
+ *                                        const *param,
+ *                                        ke_task_id_t const dest_id,
+ *                                        ke_task_id_t const src_id)
+ * ----------------------------------------------------------------------------
+ * Description   : Provide LTK of bonded device when central device starts
+ *                 link encryption
+ * Inputs        : - msg_id     - Kernel message ID number
+ *                 - param      - Message parameters in format of
+ *                                struct gapc_encrypt_req_ind
+ *                 - dest_id    - Destination task ID number
+ *                 - src_id     - Source task ID number
+ * Outputs       : return value - Indicate if the message was consumed;
+ *                                compare with KE_MSG_CONSUMED
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static int GAPC_EncryptReqInd(ke_msg_id_t const msg_id, struct gapc_encrypt_req_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    struct gapc_encrypt_cfm *cfm;
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    cfm = KE_MSG_ALLOC(GAPC_ENCRYPT_CFM, src_id, TASK_APP, gapc_encrypt_cfm);
+    cfm->found = false;
+
+    /* EDIV and Rand identify the bond even if peer address has changed. */
+    if (slot != INVALID_DEV_IDX && ble_env.bond.valid == true
+            && param->ediv == ble_env.bond.ltk.ediv
+            && memcmp(param->rand_nb.nb, ble_env.bond.ltk.randnb.nb,
+                    GAP_RAND_NB_LEN) == 0)
+    {
+        cfm->found = true;
+        cfm->key_size = ble_env.bond.ltk.key_size;
+        cfm->ltk = ble_env.bond.ltk.ltk;
+
+        ble_env.con[slot].bonded = true;
+        ble_env.con[slot].resume_pending = true;
+    }
+
+    ke_msg_send(cfm);
+
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : int GAPC_EncryptInd(ke_msg_id_t const msg_id,
+ *                                     struct gapc_encrypt_ind
+ *                                     const *param,
+ *                                     ke_task_id_t const dest_id,
+ *                                     ke_task_id_t const src_id)
+ * ----------------------------------------------------------------------------
+ * Description   : Notify application once bonded device has encrypted link
+ * Inputs        : - msg_id     - Kernel message ID number
+ *                 - param      - Message parameters in format of
+ *                                struct gapc_encrypt_ind
+ *                 - dest_id    - Destination task ID number
+ *                 - src_id     - Source task ID number
+ * Outputs       : return value - Indicate if the message was consumed;
+ *                                compare with KE_MSG_CONSUMED
+ * Assumptions   : None
+ * ------------------------------------------------------------------------- */
+static int GAPC_EncryptInd(ke_msg_id_t const msg_id, struct gapc_encrypt_ind const *param, ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
+    signed int slot = BDK_BLE_GetConnectionSlot(KE_IDX_GET(src_id));
+
+    if (slot != INVALID_DEV_IDX && ble_env.con[slot].resume_pending == true)
+    {
+        ble_env.con[slot].resume_pending = false;
+
+        App_BondedPeerReconnected();
+    }
+
+    return KE_MSG_CONSUMED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : void BDK_BLE_UpdateWhiteList(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Replace content of white list with bonded device
+ * Inputs        : None
+ * Outputs       : None
+ * Assumptions   : White list is not used by running advertising.
+ * ------------------------------------------------------------------------- */
+static void BDK_BLE_UpdateWhiteList(void)
+{
+    struct gapm_white_list_mgt_cmd *cmd;
+
+    if (ble_env.reconnect_mode != BDK_BLE_RECONNECT_WHITELIST)
+    {
+        return;
+    }
+
+    cmd = KE_MSG_ALLOC_DYN(GAPM_WHITE_LIST_MGT_CMD, TASK_GAPM, TASK_APP,
+            gapm_white_list_mgt_cmd, 0);
+    cmd->operation = GAPM_CLEAR_WLIST;
+    cmd->nb = 0;
+    ke_msg_send(cmd);
+
+    if (BDK_BLE_IsBondAddrStable() == true)
+    {
+        cmd = KE_MSG_ALLOC_DYN(GAPM_WHITE_LIST_MGT_CMD, TASK_GAPM, TASK_APP,
+                gapm_white_list_mgt_cmd, sizeof(struct gap_bdaddr));
+        cmd->operation = GAPM_ADD_DEV_IN_WLIST;
+        cmd->nb = 1;
+        cmd->devices[0] = ble_env.bond.id_addr;
+        ke_msg_send(cmd);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+ * Function      : bool BDK_BLE_IsBondAddrStable(void)
+ * ----------------------------------------------------------------------------
+ * Description   : Check whether bonded device reconnects with its identity
+ *                 address, so that it can be white listed or used as target
+ *                 of directed advertising
+ * Inputs        : None
+ * Outputs       : return value - false if there is no bond or bonded device
+ *                                used resolvable private address
+ * Assumptions   : Controller address resolution is not enabled, rotating
+ *                 private addresses of the bonded device never match its
+ *                 identity address.
+ * ------------------------------------------------------------------------- */
+static bool BDK_BLE_IsBondAddrStable(void)
+{
+    const struct gap_bdaddr *addr = &ble_env.bond.peer_addr;
+
+    if (ble_env.bond.valid == false)
+    {
+        return false;
+    }
+
+    /* Two most significant address bits 0b01 mark resolvable private
+     * address. */
+    return !(addr->addr_type == ADDR_RAND
+            && (addr->addr.addr[BDK_BLE_BADDR_LENGTH - 1] & 0xC0) == 0x40);
+}
+
 /* ----------------------------------------------------------------------------
  * Function      : bool Service_Add(void)
  * ----------------------------------------------------------------------------
@@ -653,8 +1097,10 @@ static bool BDK_BLE_ServiceAdd(void)
 
 void BDK_BLE_AdvertisingStart(void)
 {
-    /* Change state to advertising */
-    if (ble_env.state == BLE_STATE_READY)
+    /* Change state to advertising, keep advertising while all masters are
+     * not connected */
+    if ((ble_env.state == BLE_STATE_READY || ble_env.state == BLE_STATE_CONNECTED)
+            && ble_env.con_count < BDK_BLE_MASTER_MAX)
     {
         ble_env.state = BLE_STATE_ADVERTISING;
 
@@ -669,12 +1115,34 @@ void BDK_BLE_AdvertisingStart(void)
 
         cmd->intv_min = ble_env.adv_int_min;
         cmd->intv_max = ble_env.adv_int_max;
+        cmd->op.state = 0;
+
+        ble_env.adv_directed = false;
+        if (ble_env.reconnect_pending == true
+                && BDK_BLE_IsBondAddrStable() == true
+                && ble_env.reconnect_mode == BDK_BLE_RECONNECT_DIRECTED)
+        {
+            /* High duty cycle directed advertising to bonded device */
+            ble_env.adv_directed = true;
+            cmd->op.code = GAPM_ADV_DIRECT;
+            cmd->info.direct = ble_env.bond.id_addr;
+
+            ke_msg_send(cmd);
+            return;
+        }
 
         cmd->op.code = GAPM_ADV_UNDIRECT;
-        cmd->op.state = 0;
         cmd->info.host.mode = GAP_GEN_DISCOVERABLE;
         cmd->info.host.adv_filt_policy = ADV_ALLOW_SCAN_ANY_CON_ANY;
 
+        /* Only bonded device may connect until reconnect window ends */
+        if (ble_env.reconnect_pending == true
+                && BDK_BLE_IsBondAddrStable() == true
+                && ble_env.reconnect_mode == BDK_BLE_RECONNECT_WHITELIST)
+        {
+            cmd->info.host.adv_filt_policy = ADV_ALLOW_SCAN_ANY_CON_WLST;
+        }
+
         /* Set advertisement packet data (Complete Local Name). */
         cmd->info.host.adv_data[0] = 1 + ble_env.local_name_len;
         cmd->info.host.adv_data[1] = GAP_AD_TYPE_COMPLETE_NAME;
@@ -707,9 +1175,11 @@ void BDK_BLE_AdvertisingStart(void)
 
 void BDK_BLE_AdvertisingStop(void)
 {
+    ble_env.adv_restart = false;
+
     if (ble_env.state == BLE_STATE_ADVERTISING)
     {
-        ble_env.state = BLE_STATE_READY;
+        ble_env.state = (ble_env.con_count > 0) ? BLE_STATE_CONNECTED : BLE_STATE_READY;
 
         struct gapm_cancel_cmd *cmd;
 
@@ -722,20 +1192,20 @@ void BDK_BLE_AdvertisingStop(void)
 }
 
 /* ----------------------------------------------------------------------------
- * Function      : void Send_Connection_Confirmation(uint8_t device_indx)
+ * Function      : void Send_Connection_Confirmation(uint8_t conidx)
  * ----------------------------------------------------------------------------
  * Description   : Send connection confirmation to peer device
- * Inputs        : - device_indx - Peer device index in the app env structure
+ * Inputs        : - conidx      - Connection index of peer device
  * Outputs       : None
  * Assumptions   : None
  * ------------------------------------------------------------------------- */
-static void BDK_BLE_SendConnectionConfirmation(void)
+static void BDK_BLE_SendConnectionConfirmation(uint8_t conidx)
 {
     struct gapc_connection_cfm *cfm;
 
     /* Allocate connection confirmation message */
     cfm = KE_MSG_ALLOC(GAPC_CONNECTION_CFM,
-                       KE_BUILD_ID(TASK_GAPC, ble_env.conidx),
+                       KE_BUILD_ID(TASK_GAPC, conidx),
                        KE_BUILD_ID(TASK_APP, 0), gapc_connection_cfm);
 
     cfm->ltk_present = false;
@@ -743,24 +1213,49 @@ static void BDK_BLE_SendConnectionConfirmation(void)
     cfm->svc_changed_ind_enable = 0;
     cfm->pairing_lvl = GAP_AUTH_REQ_NO_MITM_BOND;
 
+    /* Bonded device reconnecting with the same address */
+    signed int slot = BDK_BLE_GetConnectionSlot(conidx);
+    bool bonded_addr = (slot != INVALID_DEV_IDX && ble_env.bond.valid == true
+            && ble_env.con[slot].peer_addr.addr_type == ble_env.bond.peer_addr.addr_type
+            && memcmp(ble_env.con[slot].peer_addr.addr.addr,
+                    ble_env.bond.peer_addr.addr.addr, BDK_BLE_BADDR_LENGTH) == 0);
+    if (bonded_addr == true)
+    {
+        cfm->ltk_present = true;
+        cfm->pairing_lvl = ble_env.bond.auth;
+    }
+
     /* Send the message */
     ke_msg_send(cfm);
+
+    /* Ask central device to encrypt the link right away */
+    if (bonded_addr == true)
+    {
+        struct gapc_security_cmd *cmd;
+
+        cmd = KE_MSG_ALLOC(GAPC_SECURITY_CMD, KE_BUILD_ID(TASK_GAPC, conidx),
+                TASK_APP, gapc_security_cmd);
+        cmd->operation = GAPC_SECURITY_REQ;
+        cmd->auth = ble_env.bond.auth;
+
+        ke_msg_send(cmd);
+    }
 }
 
 /* ----------------------------------------------------------------------------
- * Function      : void BLE_SetServiceState(bool enable, uint8_t device_indx)
+ * Function      : void BLE_SetServiceState(bool enable, uint8_t conidx)
  * ----------------------------------------------------------------------------
  * Description   : Set Bluetooth application environment state to enabled
  * Inputs        : - enable      - Indicates that enable request should be sent
  *                                 for all services/profiles or their status
  *                                 should be set to disabled
  *                                 enabled or disabled
- *                 - device_indx - Peer device index in the app env structure
+ *                 - conidx      - Connection index of peer device
  * Outputs       : None
  * Assumptions   : Peer device must be connected. This function should
  *                  only be called after ConnectionConfirmation is sent.
  * ------------------------------------------------------------------------- */
-void BDK_BLE_SetServiceState(bool enable)
+void BDK_BLE_SetServiceState(bool enable, uint8_t conidx)
 {
     if (enable == true)
     {
@@ -768,62 +1263,135 @@ void BDK_BLE_SetServiceState(bool enable)
 
         for (i = 0; i < ble_env.svc_count; ++i)
         {
-            ble_env.svc_enable_func[i](ble_env.conidx);
+            ble_env.svc_enable_func[i](conidx);
         }
     }
 
-    if (ble_env.state < BLE_STATE_CONNECTED)
+    /* Keep advertising while all masters are not connected */
+    if (ble_env.con_count < BDK_BLE_MASTER_MAX)
     {
         BDK_BLE_AdvertisingStart();
     }
-//    if (device_indx != INVALID_DEV_IDX)
-//    {
-//        /* All standard services should be send enable request to the stack,
-//         * for custom services, application should decide if it would want
-//         * to do a specific action
-//         * all services should be disabled once the link is lost
-//         */
-//        if (enable == true)
-//        {
-//            /* To enable standard Bluetooth services, an enable request should
-//             * be sent to the stack (for related profile) and at receiving the
-//             * response the enable flag can be set. For custom service it is
-//             * application implementation dependent. Here, it starts service
-//             * discovery, and if the service UUID and characteristics UUID are
-//             * discovered, then it goes to an state that is equivalent to the
-//             * enable flag of standard profiles
-//             */
-//            ble_env[device_indx].next_svc_enable = 0;
-//            Service_Enable(ble_env[device_indx].conidx);
-//        }
-//        else
-//        {
-//            bass_support_env[device_indx].enable = false;
-//            cs_env[device_indx].state = CS_INIT;
-//        }
-//    }
-//
-//    /* Keep advertising while all masters are not connected */
-//    if (Connected_Peer_Num() < NUM_MASTERS)
-//    {
-//        Advertising_Start();
-//    }
 }
 
 signed int BDK_BLE_GetConIdx(void)
 {
-    /* Check connection index to set device index */
-    if (ble_env.state == BLE_STATE_CONNECTED)
+    /* Return the first active connection */
+    for (uint8_t i = 0; i < BDK_BLE_MASTER_MAX; ++i)
+    {
+        if (ble_env.con[i].conidx != GAP_INVALID_CONIDX)
+        {
+            return ble_env.con[i].conidx;
+        }
+    }
+
+    return INVALID_DEV_IDX;
+}
+
+signed int BDK_BLE_GetConIdxBySlot(uint8_t slot)
+{
+    if (slot < BDK_BLE_MASTER_MAX
+            && ble_env.con[slot].conidx != GAP_INVALID_CONIDX)
     {
-        return ble_env.conidx;
+        return ble_env.con[slot].conidx;
     }
 
     return INVALID_DEV_IDX;
 }
 
+signed int BDK_BLE_GetConnectionSlot(uint8_t conidx)
+{
+    for (uint8_t i = 0; i < BDK_BLE_MASTER_MAX; ++i)
+    {
+        if (ble_env.con[i].conidx == conidx)
+        {
+            return i;
+        }
+    }
+
+    return INVALID_DEV_IDX;
+}
+
+uint8_t BDK_BLE_GetConnectionCount(void)
+{
+    return ble_env.con_count;
+}
+
+const struct BDK_BLE_ConParam* BDK_BLE_GetConParam(uint8_t slot)
+{
+    if (slot < BDK_BLE_MASTER_MAX
+            && ble_env.con[slot].conidx != GAP_INVALID_CONIDX)
+    {
+        return &ble_env.con[slot].param;
+    }
+
+    return NULL;
+}
+
 bool BDK_BLE_IsConnected(void)
 {
-    return (ble_env.state == BLE_STATE_CONNECTED);
+    return (ble_env.con_count > 0);
+}
+
+void BDK_BLE_EnableBonding(enum BDK_BLE_ReconnectMode mode)
+{
+    if (ble_env.state == BLE_STATE_OFF)
+    {
+        BDK_BLE_Initialize();
+    }
+
+    /* Pairing mode is applied when stack is configured after reset. */
+    if (bdk_gapm_conf_cmd != NULL)
+    {
+        bdk_gapm_conf_cmd->pairing_mode = GAPM_PAIRING_LEGACY;
+    }
+
+    ble_env.reconnect_mode = mode;
+
+    BDK_TaskAddMsgHandler(GAPC_BOND_REQ_IND, (ke_msg_func_t)GAPC_BondReqInd);
+    BDK_TaskAddMsgHandler(GAPC_BOND_IND, (ke_msg_func_t)GAPC_BondInd);
+    BDK_TaskAddMsgHandler(GAPC_ENCRYPT_REQ_IND, (ke_msg_func_t)GAPC_EncryptReqInd);
+    BDK_TaskAddMsgHandler(GAPC_ENCRYPT_IND, (ke_msg_func_t)GAPC_EncryptInd);
+}
+
+bool BDK_BLE_IsBonded(void)
+{
+    return ble_env.bond.valid;
+}
+
+const struct BDK_BLE_Bond* BDK_BLE_GetBond(void)
+{
+    return &ble_env.bond;
+}
+
+void BDK_BLE_ClearBond(void)
+{
+    memset(&ble_env.bond, 0, sizeof(ble_env.bond));
+    for (uint8_t i = 0; i < BDK_BLE_MASTER_MAX; ++i)
+    {
+        ble_env.con[i].bonded = false;
+        ble_env.con[i].resume_pending = false;
+    }
+
+    BDK_BLE_EndReconnect();
+    BDK_BLE_UpdateWhiteList();
+}
+
+void BDK_BLE_EndReconnect(void)
+{
+    if (ble_env.reconnect_pending == false)
+    {
+        return;
+    }
+
+    ble_env.reconnect_pending = false;
+
+    /* Restart running advertising without directed or filtered mode. */
+    if (ble_env.state == BLE_STATE_ADVERTISING)
+    {
+        BDK_BLE_AdvertisingStop();
+        ble_env.adv_restart = true;
+    }
 }
 
 //! \}
@@ -46,6 +46,11 @@
 
 static int CSP_SYS_RequestHandler(const struct CS_Request_Struct* request);
 
+static void CS_UpdateActiveMask(const struct CS_Provider_Struct* provider);
+
+static uint8_t CS_ApplyConfig(const struct CS_Config_Struct* config,
+		CS_Provider target, bool apply);
+
 
 //-----------------------------------------------------------------------------
 // INTERNAL VARIABLES
@@ -57,6 +62,9 @@ static char cs_tx_buffer[CS_MAX_RESPONSE_LENGTH];
 
 static uint16_t cs_prov_response[MAX_DATA_LEN_HW];
 
+/** Provider IDs signalled from interrupts, waiting for poll handler. */
+static volatile uint32_t cs_ready_mask = 0;
+
 static struct CS_Provider_Struct cs_sys_prov = {
 		CSP_SYS_ID,
 		CSP_SYS_AVAIL_BIT,
@@ -77,6 +85,12 @@ int CS_Init()
 	{
 		cs.provider[i] = NULL;
 	}
+	for (i = 0; i < CS_PROVIDER_ID_BITS; ++i)
+	{
+		cs.provider_by_bit[i] = NULL;
+	}
+	cs.provider_mask = 0;
+	cs.active_mask = 0;
 	cs.conf_content = NULL;
 	cs.conf_content_len = 0;
 	cs.conf_page_cnt = 0;
@@ -105,13 +119,17 @@ int CS_RegisterProvider(struct CS_Provider_Struct* provider)
 		return CS_ERROR;
 	}
 
-	for (int i = 0; i < cs.provider_cnt; ++i)
+	// Provider is dispatched by the bit position of its ID.
+	if (provider->id == 0 || (provider->id & (provider->id - 1)) != 0)
 	{
-		if(cs.provider[i]->id == provider->id)
-		{
-			CS_SYS_Error("Non unique provider ID.");
-			return CS_ERROR;
-		}
+		CS_SYS_Error("Provider ID has to be a single bit.");
+		return CS_ERROR;
+	}
+
+	if (cs.provider_mask & provider->id)
+	{
+		CS_SYS_Error("Non unique provider ID.");
+		return CS_ERROR;
 	}
 
 	if (cs.provider_cnt == CS_MAX_PROVIDER_COUNT)
@@ -122,6 +140,8 @@ int CS_RegisterProvider(struct CS_Provider_Struct* provider)
 
 	cs.provider[cs.provider_cnt] = provider;
 	cs.provider_cnt += 1;
+	cs.provider_by_bit[__builtin_ctz(provider->id)] = provider;
+	cs.provider_mask |= provider->id;
 
 	CS_SYS_Info("Registered provider '%u'", cs.provider[cs.provider_cnt - 1]->id);
 
@@ -130,9 +150,11 @@ int CS_RegisterProvider(struct CS_Provider_Struct* provider)
 
 int CS_ProcessRequest(const struct CS_Request_Struct *request)
 {
-	int errcode, i;
+	int errcode;
 	uint32_t timestamp;
-	bool providers_found;
+	bool providers_found = false;
+	unsigned int mask;
+	struct CS_Provider_Struct* provider;
 
 	if (request == NULL)
 	{
@@ -148,68 +170,72 @@ int CS_ProcessRequest(const struct CS_Request_Struct *request)
 	CS_SYS_Info("Received request packet: '%u'", request);
 #endif
 
-	// Iterate all available providers to find matches.
-	for (i = 0; i < cs.provider_cnt; ++i)
+	// Look up providers addressed by bits of the request.
+	mask = request->provider_id & cs.provider_mask;
+	while (mask != 0)
 	{
-		if (request->provider_id & cs.provider[i]->id)
+		provider = cs.provider_by_bit[__builtin_ctz(mask)];
+		mask &= mask - 1;
+
+		// Matching provider was found -> pass request
+		errcode = provider->request_handler(request);
+		CS_UpdateActiveMask(provider);
+
+		if (errcode == CS_OK)
 		{
-			// Matching provider was found -> pass request
-			errcode = cs.provider[i]->request_handler(request);
+			providers_found = true;
 
-			if (errcode == CS_OK)
-			{
 #if CS_LOG_WITH_ANSI_COLORS != 0 && defined RTE_DEVICE_BDK_OUTPUT_REDIRECTION
                 CS_SYS_Info(
                         "Response packet: '");
 #else
-				CS_SYS_Info("Response packet: '");
+			CS_SYS_Info("Response packet: '");
 #endif
-				for(int j = 0; j < MAX_DATA_LEN_HW; ++j)
-				{
+			for(int j = 0; j < MAX_DATA_LEN_HW; ++j)
+			{
 #if CS_LOG_WITH_ANSI_COLORS != 0 && defined RTE_DEVICE_BDK_OUTPUT_REDIRECTION
                 CS_SYS_Info(COLORIZE("%u", MAGENTA, BOLD) " ", cs_prov_response[j]);
 #else
-				CS_SYS_Info(" %u ", cs_prov_response[j]);
+			CS_SYS_Info(" %u ", cs_prov_response[j]);
 #endif
-				}
+			}
 #if CS_LOG_WITH_ANSI_COLORS != 0 && defined RTE_DEVICE_BDK_OUTPUT_REDIRECTION
                 CS_SYS_Info(" '");
 #else
-				CS_SYS_Info(" '");
+			CS_SYS_Info(" '");
 #endif
 
 
-				// Send response to platform
-				int res_len = sizeof(cs_prov_response);
-				if (CS_PlatformWriteBytes(cs_prov_response, res_len, cs.provider[i]->id) == CS_OK)
-				{
-					timestamp = CS_PlatformTime() - timestamp;
-					CS_SYS_Verbose("Request completed in %lu ms.", timestamp);
-				}
-				else
-				{
-					CS_SYS_Error("Platform send failed. (errcode=%d)", errcode);
-					return CS_ERROR;
-				}
-			}
-			else if (errcode == CS_NO_RESPONSE)
+			// Send response to platform
+			int res_len = sizeof(cs_prov_response);
+			if (CS_PlatformWriteBytes(cs_prov_response, res_len, provider->id) == CS_OK)
 			{
-				providers_found = true;
+				timestamp = CS_PlatformTime() - timestamp;
+				CS_SYS_Verbose("Request completed in %lu ms.", timestamp);
 			}
 			else
 			{
-				CS_SYS_Error("Provider request processing error. (errcode=%d)", errcode);
-				sprintf(cs_tx_buffer, "%u/e/UNK_ERROR", cs.provider[i]->id);
-				errcode = CS_PlatformWriteString(cs_tx_buffer, strlen(cs_tx_buffer), cs.provider[i]->id);
-				if (errcode != CS_OK)
-				{
-					CS_SYS_Error("Platform send failed. (errcode=%d)", errcode);
-					return CS_ERROR;
-				}
-				// Provider failed to process request
+				CS_SYS_Error("Platform send failed. (errcode=%d)", errcode);
 				return CS_ERROR;
 			}
 		}
+		else if (errcode == CS_NO_RESPONSE)
+		{
+			providers_found = true;
+		}
+		else
+		{
+			CS_SYS_Error("Provider request processing error. (errcode=%d)", errcode);
+			sprintf(cs_tx_buffer, "%u/e/UNK_ERROR", provider->id);
+			errcode = CS_PlatformWriteString(cs_tx_buffer, strlen(cs_tx_buffer), provider->id);
+			if (errcode != CS_OK)
+			{
+				CS_SYS_Error("Platform send failed. (errcode=%d)", errcode);
+				return CS_ERROR;
+			}
+			// Provider failed to process request
+			return CS_ERROR;
+		}
 	}
 
 	if(providers_found) return CS_OK;
@@ -227,20 +253,128 @@ int CS_ProcessRequest(const struct CS_Request_Struct *request)
 	return CS_ERROR;
 }
 
+int CS_ProcessExtRequest(const uint8_t *data, uint8_t data_len)
+{
+    struct CS_Config_Struct config[CS_EXT_MAX_TLV_COUNT];
+    CS_Provider target[CS_EXT_MAX_TLV_COUNT];
+    uint8_t response[CS_EXT_RESPONSE_LENGTH];
+    uint8_t status = CS_EXT_OK;
+    uint8_t tlv_cnt = 0;
+    uint8_t tlv_idx = 0;
+    uint8_t pos = CS_EXT_HEADER_LENGTH;
+
+    if (data == NULL || data_len < CS_EXT_HEADER_LENGTH)
+    {
+        return CS_ERROR;
+    }
+
+    CS_SYS_Info("Received extended request '%u', %u bytes", data[1], data_len);
+
+    if ((data[0] & ~CS_EXT_FLAG) != CS_EXT_VERSION)
+    {
+        status = CS_EXT_ERR_VERSION;
+    }
+
+    // Split message into TLVs, LEN has to cover at least provider ID.
+    while (status == CS_EXT_OK && pos < data_len)
+    {
+        if (tlv_cnt == CS_EXT_MAX_TLV_COUNT
+                || pos + CS_EXT_TLV_HEADER_LENGTH > data_len
+                || data[pos + 1] == 0
+                || pos + 2 + data[pos + 1] > data_len)
+        {
+            status = CS_EXT_ERR_FORMAT;
+            tlv_idx = tlv_cnt;
+            break;
+        }
+
+        config[tlv_cnt].type = data[pos];
+        config[tlv_cnt].length = data[pos + 1] - 1;
+        config[tlv_cnt].value = &data[pos + CS_EXT_TLV_HEADER_LENGTH];
+        target[tlv_cnt] = data[pos + 2];
+
+        pos += 2 + data[pos + 1];
+        tlv_cnt += 1;
+    }
+
+    // Nothing is applied unless every TLV is valid.
+    if (status == CS_EXT_OK)
+    {
+        for (tlv_idx = 0; tlv_idx < tlv_cnt; ++tlv_idx)
+        {
+            status = CS_ApplyConfig(&config[tlv_idx], target[tlv_idx], false);
+            if (status != CS_EXT_OK)
+            {
+                break;
+            }
+        }
+    }
+
+    if (status == CS_EXT_OK)
+    {
+        for (tlv_idx = 0; tlv_idx < tlv_cnt; ++tlv_idx)
+        {
+            status = CS_ApplyConfig(&config[tlv_idx], target[tlv_idx], true);
+            if (status != CS_EXT_OK)
+            {
+                break;
+            }
+        }
+    }
+
+    if (status != CS_EXT_OK)
+    {
+        CS_SYS_Error("Extended request '%u' failed at TLV %u. (status=%u)",
+                data[1], tlv_idx, status);
+    }
+
+    response[0] = CS_EXT_FLAG | CS_EXT_VERSION;
+    response[1] = data[1];
+    response[2] = status;
+    response[3] = tlv_idx;
+
+    if (CS_PlatformWriteString((const char*) response, CS_EXT_RESPONSE_LENGTH,
+            CSP_SYS_ID) != CS_OK)
+    {
+        CS_SYS_Error("Platform send failed.");
+        return CS_ERROR;
+    }
+
+    return (status == CS_EXT_OK) ? CS_OK : CS_ERROR;
+}
+
 int CS_PollProviders(void)
 {
-    for (int i = 0; i < cs.provider_cnt; ++i)
+    // Take over signals posted by interrupts, only streaming providers are
+    // visited.
+    unsigned int mask = __atomic_exchange_n(&cs_ready_mask, 0,
+            __ATOMIC_ACQUIRE) & cs.active_mask;
+
+    while (mask != 0)
     {
-        if ((cs.provider[i]->req_token & START) &&
-        		cs.provider[i]->poll_handler != NULL)
+        struct CS_Provider_Struct* provider =
+                cs.provider_by_bit[__builtin_ctz(mask)];
+
+        mask &= mask - 1;
+        if (provider->poll_handler != NULL)
         {
-            cs.provider[i]->poll_handler();
+            provider->poll_handler();
         }
     }
 
     return CS_OK;
 }
 
+void CS_SignalProvider(CS_Provider id)
+{
+    __atomic_fetch_or(&cs_ready_mask, id, __ATOMIC_RELEASE);
+}
+
+bool CS_IsPollPending(void)
+{
+    return (cs_ready_mask & cs.active_mask) != 0;
+}
+
 int CS_InjectResponse(uint16_t response[MAX_DATA_LEN_HW], uint8_t provider_id, \
 		uint8_t response_len)
 {
@@ -303,6 +437,42 @@ int CS_SetPowerMode(enum CS_PowerMode mode)
     return CS_OK;
 }
 
+int CS_SaveStreamState(void)
+{
+    for (int i = 0; i < cs.provider_cnt; ++i)
+    {
+        cs.resume_token[i] = (cs.provider[i]->req_token & START) ?
+                cs.provider[i]->req_token : STOP;
+    }
+
+    return CS_OK;
+}
+
+int CS_ResumeStreamState(void)
+{
+    for (int i = 0; i < cs.provider_cnt; ++i)
+    {
+        if (cs.resume_token[i] & START)
+        {
+            // Stream providers fit into 5 bit ID of the request.
+            const struct CS_Request_Struct request = {
+                    .provider_id = cs.provider[i]->id,
+                    .op_code = cs.resume_token[i],
+                    .reserved = DEFAULT
+            };
+
+            CS_SYS_Info("Resuming stream of provider '%u'", cs.provider[i]->id);
+
+            // Start is acknowledged by the stream itself, no response is sent.
+            cs.provider[i]->request_handler(&request);
+            CS_UpdateActiveMask(cs.provider[i]);
+            cs.resume_token[i] = STOP;
+        }
+    }
+
+    return CS_OK;
+}
+
 void CS_SetAppConfig(const char* content)
 {
 	if (content == NULL)
@@ -367,3 +537,86 @@ static int CSP_SYS_RequestHandler(const struct CS_Request_Struct* request)
 {
 	return CS_OK;
 }
+
+/** \brief Validates or applies configuration TLV for every addressed provider.
+ *
+ * \returns Status code from \ref CS_ExtStatus.
+ */
+static uint8_t CS_ApplyConfig(const struct CS_Config_Struct* config,
+		CS_Provider target, bool apply)
+{
+    unsigned int mask = target;
+
+    if (target == 0 || (target & ~cs.provider_mask) != 0)
+    {
+        return CS_EXT_ERR_PROVIDER;
+    }
+
+    while (mask != 0)
+    {
+        struct CS_Provider_Struct* provider =
+                cs.provider_by_bit[__builtin_ctz(mask)];
+
+        mask &= mask - 1;
+
+        if (config->type == CS_CFG_STREAM)
+        {
+            // Streams are controlled with the same request as legacy message.
+            if (config->length != 1
+                    || (config->value[0] != STOP_STREAMING
+                        && config->value[0] != START_STREAMING_RELEASE
+                        && config->value[0] != START_STREAMING_DEBUG))
+            {
+                return CS_EXT_ERR_VALUE;
+            }
+
+            if (apply)
+            {
+                const struct CS_Request_Struct request = {
+                        .provider_id = provider->id,
+                        .op_code = config->value[0],
+                        .reserved = DEFAULT
+                };
+                int errcode = provider->request_handler(&request);
+
+                CS_UpdateActiveMask(provider);
+                if (errcode != CS_OK && errcode != CS_NO_RESPONSE)
+                {
+                    return CS_EXT_ERR_APPLY;
+                }
+            }
+        }
+        else if (provider->config_handler == NULL)
+        {
+            return CS_EXT_ERR_UNSUPPORTED;
+        }
+        else
+        {
+            int errcode = provider->config_handler(config, apply);
+
+            if (errcode == CS_UNSUPPORTED)
+            {
+                return CS_EXT_ERR_UNSUPPORTED;
+            }
+            if (errcode != CS_OK)
+            {
+                return apply ? CS_EXT_ERR_APPLY : CS_EXT_ERR_VALUE;
+            }
+        }
+    }
+
+    return CS_EXT_OK;
+}
+
+/** \brief Marks provider as streaming according to its request token. */
+static void CS_UpdateActiveMask(const struct CS_Provider_Struct* provider)
+{
+	if (provider->req_token & START)
+	{
+		cs.active_mask |= provider->id;
+	}
+	else
+	{
+		cs.active_mask &= ~provider->id;
+	}
+}
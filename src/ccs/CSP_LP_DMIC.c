@@ -15,9 +15,11 @@
 #include <string.h>
 
 #include <ccs/providers/CSP_LP_DMIC.h>
-#include <BLE_CCS.h>
+#include <ccs/CS_Platform.h>
 #include <ccs/CS_Peripherals_Init.h>
 #include <HAL.h>
+#include <LedNames.h>
+#include <BDK_Prof.h>
 
 //-----------------------------------------------------------------------------
 // EXTERNAL / FORWARD DECLARATIONS
@@ -30,6 +32,8 @@ static int CSP_DMIC_PowerModeHandler(enum CS_PowerMode mode);
 
 static void CSP_DMIC_PollHandler(void);
 
+static int CSP_DMIC_ConfigHandler(const struct CS_Config_Struct* config, bool apply);
+
 static int16_t csp_dmic_tx[MAX_DATA_LEN_HW];
 //static uint16_t packet_cnt = 0;
 
@@ -43,7 +47,8 @@ static struct CS_Provider_Struct dmic_provider = {
 		CSP_DMIC_AVAIL_BIT,
 		&CSP_DMIC_RequestHandler,
 		&CSP_DMIC_PowerModeHandler,
-		&CSP_DMIC_PollHandler
+		&CSP_DMIC_PollHandler,
+		&CSP_DMIC_ConfigHandler
 };
 
 //-----------------------------------------------------------------------------
@@ -68,9 +73,7 @@ static int CSP_DMIC_RequestHandler(const struct CS_Request_Struct* request)
     	else  Configure_DMIC_Release();
 
     	/* Indication of request acknowledgment */
-    	DIO->CFG[1] =  DIO->CFG[1] | 0x1;
-    	HAL_Delay(250);
-    	DIO->CFG[1] =  DIO->CFG[1] & ~0x1;
+    	CS_PlatformIndicate(LED_GREEN, 250);
 
         /* Enable the DMIC */
         CSP_DMIC_PowerModeHandler(CS_POWER_MODE_NORMAL);
@@ -84,6 +87,7 @@ static int CSP_DMIC_RequestHandler(const struct CS_Request_Struct* request)
 
     // Stop streaming was requested
 	CSP_DMIC_PowerModeHandler(CS_POWER_MODE_SLEEP);
+	dmic_provider.req_token = STOP;
 
     return CS_OK;
 }
@@ -121,6 +125,8 @@ static inline void buffer_cast_uint32_to_int16(int16_t dest_data[], uint32_t src
 /* Packs elements from DMA output buffer into transmit packet */
 static inline void Pack_Audio_Packet(uint32_t src_buffer[])
 {
+	BDK_PROF_START(BDK_PROF_PACK_AUDIO);
+
 	if(dmic_provider.req_token & DEBUG)
 	{
 		// Insert timestamp packet header and add samples to transmit buffer
@@ -128,6 +134,8 @@ static inline void Pack_Audio_Packet(uint32_t src_buffer[])
 		buffer_cast_uint32_to_int16(&csp_dmic_tx[1], src_buffer, dmic_buffer_len);
 
 	} else buffer_cast_uint32_to_int16(csp_dmic_tx, src_buffer, dmic_buffer_len);
+
+	BDK_PROF_STOP(BDK_PROF_PACK_AUDIO);
 }
 
 static void CSP_DMIC_PollHandler(void)
@@ -136,8 +144,8 @@ static void CSP_DMIC_PollHandler(void)
 	{
 		Pack_Audio_Packet(dmic_buffer_1);
 		dmic_buffer_1_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_dmic_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_DMIC_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_dmic_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_DMIC_ID);
 
 	}
 
@@ -145,8 +153,37 @@ static void CSP_DMIC_PollHandler(void)
 	{
 		Pack_Audio_Packet(dmic_buffer_2);
 		dmic_buffer_2_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_dmic_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_DMIC_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_dmic_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_DMIC_ID);
 	}
 }
 
+
+static int CSP_DMIC_ConfigHandler(const struct CS_Config_Struct* config, bool apply)
+{
+	uint16_t gain;
+
+	// Only DMIC gain can be changed at run time.
+	if (config->type != CS_CFG_GAIN)
+	{
+		return CS_UNSUPPORTED;
+	}
+
+	if (config->length != 2)
+	{
+		return CS_ERROR;
+	}
+
+	gain = config->value[0] | (config->value[1] << 8);
+	if (gain > AUDIO_DMIC0_GAIN_MAX)
+	{
+		return CS_ERROR;
+	}
+
+	if (apply)
+	{
+		AUDIO->DMIC0_GAIN = gain;
+	}
+
+	return CS_OK;
+}
@@ -15,9 +15,11 @@
 #include <string.h>
 
 #include <ccs/providers/CSP_LP_LCA.h>
-#include <BLE_CCS.h>
+#include <ccs/CS_Platform.h>
 #include <ccs/CS_Peripherals_Init.h>
 #include <HAL.h>
+#include <LedNames.h>
+#include <BDK_Prof.h>
 
 //-----------------------------------------------------------------------------
 // EXTERNAL / FORWARD DECLARATIONS
@@ -67,9 +69,7 @@ static int CSP_LCA_RequestHandler(const struct CS_Request_Struct* request)
     	else  Configure_LCA_Release();
 
     	/* Indication of request acknowledgment */
-    	DIO->CFG[2] =  DIO->CFG[2] | 0x1;
-    	HAL_Delay(250);
-    	DIO->CFG[2] =  DIO->CFG[2] & ~0x1;
+    	CS_PlatformIndicate(LED_RED, 250);
 
         /* Enable the LCA */
         CSP_LCA_PowerModeHandler(CS_POWER_MODE_NORMAL);
@@ -83,6 +83,7 @@ static int CSP_LCA_RequestHandler(const struct CS_Request_Struct* request)
 
     // Stop streaming was requested
 	CSP_LCA_PowerModeHandler(CS_POWER_MODE_SLEEP);
+	lca_provider.req_token = STOP;
 
     return CS_OK;
 }
@@ -110,6 +111,8 @@ static int CSP_LCA_PowerModeHandler(enum CS_PowerMode mode)
 /* Packs elements from DMA output buffer into transmit packet */
 static inline void Pack_Audio_Packet(int16_t src_buffer[])
 {
+	BDK_PROF_START(BDK_PROF_PACK_AUDIO);
+
 	if(lca_provider.req_token & DEBUG)
 	{
 		// Insert timestamp packet header and add samples to transmit buffer
@@ -117,6 +120,8 @@ static inline void Pack_Audio_Packet(int16_t src_buffer[])
 		memcpy(&csp_lca_tx[1], src_buffer, lca_buffer_len*2);
 
 	} else memcpy(csp_lca_tx, src_buffer, lca_buffer_len*2);
+
+	BDK_PROF_STOP(BDK_PROF_PACK_AUDIO);
 }
 
 static void CSP_LCA_PollHandler(void)
@@ -125,16 +130,16 @@ static void CSP_LCA_PollHandler(void)
 	{
 		Pack_Audio_Packet(lca_buffer_1);
 		lca_buffer_1_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_lca_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_LCA_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_lca_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_LCA_ID);
 	}
 
 	if(lca_buffer_2_full)
 	{
 		Pack_Audio_Packet(lca_buffer_2);
 		lca_buffer_2_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_lca_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_LCA_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_lca_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_LCA_ID);
 
 	}
 }
@@ -15,9 +15,11 @@
 #include <string.h>
 
 #include <ccs/providers/CSP_LP_RCA.h>
-#include <BLE_CCS.h>
+#include <ccs/CS_Platform.h>
 #include <ccs/CS_Peripherals_Init.h>
 #include <HAL.h>
+#include <LedNames.h>
+#include <BDK_Prof.h>
 
 //-----------------------------------------------------------------------------
 // EXTERNAL / FORWARD DECLARATIONS
@@ -68,9 +70,7 @@ static int CSP_RCA_RequestHandler(const struct CS_Request_Struct* request)
     	else  Configure_RCA_Release();
 
     	/* Indication of request acknowledgment */
-    	DIO->CFG[2] =  DIO->CFG[2] | 0x1;
-    	HAL_Delay(250);
-    	DIO->CFG[2] =  DIO->CFG[2] & ~0x1;
+    	CS_PlatformIndicate(LED_RED, 250);
 
         /* Enable the RCA */
         CSP_RCA_PowerModeHandler(CS_POWER_MODE_NORMAL);
@@ -84,6 +84,7 @@ static int CSP_RCA_RequestHandler(const struct CS_Request_Struct* request)
 
     // Stop streaming was requested
 	CSP_RCA_PowerModeHandler(CS_POWER_MODE_SLEEP);
+	rca_provider.req_token = STOP;
 
     return CS_OK;
 }
@@ -111,6 +112,8 @@ static int CSP_RCA_PowerModeHandler(enum CS_PowerMode mode)
 /* Packs elements from DMA output buffer into transmit packet */
 static inline void Pack_Audio_Packet(int16_t src_buffer[])
 {
+	BDK_PROF_START(BDK_PROF_PACK_AUDIO);
+
 	if(rca_provider.req_token & DEBUG)
 	{
 		// Insert timestamp packet header and add samples to transmit buffer
@@ -118,6 +121,8 @@ static inline void Pack_Audio_Packet(int16_t src_buffer[])
 		memcpy(&csp_rca_tx[1], src_buffer, rca_buffer_len*2);
 
 	} else memcpy(csp_rca_tx, src_buffer, rca_buffer_len*2);
+
+	BDK_PROF_STOP(BDK_PROF_PACK_AUDIO);
 }
 
 static void CSP_RCA_PollHandler(void)
@@ -126,16 +131,16 @@ static void CSP_RCA_PollHandler(void)
 	{
 		Pack_Audio_Packet(rca_buffer_1);
 		rca_buffer_1_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_rca_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_RCA_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_rca_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_RCA_ID);
 	}
 
 	if(rca_buffer_2_full)
 	{
 		Pack_Audio_Packet(rca_buffer_2);
 		rca_buffer_2_full = false;
-		BLE_CCS_Notify((unsigned char *)csp_rca_tx, CS_MAX_RESPONSE_LENGTH,
-				CCS_IDX_RCA_VALUE_VAL);
+		CS_PlatformWriteStream((uint8_t *)csp_rca_tx, CS_MAX_RESPONSE_LENGTH,
+				CSP_RCA_ID);
 	}
 }
 
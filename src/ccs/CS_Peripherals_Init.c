@@ -7,6 +7,7 @@
 
 #include <ccs/CS_Peripherals_Init.h>
 #include <HAL.h>
+#include <BDK_Prof.h>
 
 /* Internal Variables */
 static uint8_t lca_buffer_idx;
@@ -110,12 +111,25 @@ void Configure_DMIC_Release()
  * ------------------------------------------------------------------------- */
 void DMA_IRQHandler(DMIC_DMA_CH)(void)
 {
+	BDK_PROF_START(BDK_PROF_DMIC_DMA_IRQ);
 	uint16_t status = Sys_DMA_Get_ChannelStatus(DMIC_DMA_CH);
 
-	if(status & DMA_COUNTER_INT_STATUS) dmic_buffer_1_full = true;
-	else if(status & DMA_COMPLETE_INT_STATUS) dmic_buffer_2_full = true;
+	if(status & DMA_COUNTER_INT_STATUS)
+	{
+		if(dmic_buffer_1_full) dmic_overruns++;
+		dmic_buffer_1_full = true;
+		dmic_buffers_captured++;
+	}
+	else if(status & DMA_COMPLETE_INT_STATUS)
+	{
+		if(dmic_buffer_2_full) dmic_overruns++;
+		dmic_buffer_2_full = true;
+		dmic_buffers_captured++;
+	}
+	CS_SignalProvider(CSP_DMIC_ID);
 
 	Sys_DMA_ClearChannelStatus(DMIC_DMA_CH);
+	BDK_PROF_STOP(BDK_PROF_DMIC_DMA_IRQ);
 }
 
 void LCA_Initialize(void)
@@ -162,8 +176,19 @@ static inline void LCA_ADC_IRQHandler(void)
 	// Increment circular buffer index
 	lca_buffer_idx = (lca_buffer_idx+1) % (2*lca_buffer_len);
 	// Update buffer status
-	if(lca_buffer_idx == lca_buffer_len) lca_buffer_1_full = true;
-	else if(lca_buffer_idx == 0) lca_buffer_2_full = true;
+	if(lca_buffer_idx == lca_buffer_len)
+	{
+		if(lca_buffer_1_full) lca_overruns++;
+		lca_buffer_1_full = true;
+	}
+	else if(lca_buffer_idx == 0)
+	{
+		if(lca_buffer_2_full) lca_overruns++;
+		lca_buffer_2_full = true;
+	}
+	else return;
+	lca_buffers_captured++;
+	CS_SignalProvider(CSP_LCA_ID);
 }
 
 static inline void RCA_ADC_IRQHandler(void)
@@ -173,12 +198,25 @@ static inline void RCA_ADC_IRQHandler(void)
 	// Increment circular buffer index
 	rca_buffer_idx = (rca_buffer_idx+1) % (2*rca_buffer_len);
 	// Update buffer status
-	if(rca_buffer_idx == rca_buffer_len) rca_buffer_1_full = true;
-	else if(rca_buffer_idx == 0) rca_buffer_2_full = true;
+	if(rca_buffer_idx == rca_buffer_len)
+	{
+		if(rca_buffer_1_full) rca_overruns++;
+		rca_buffer_1_full = true;
+	}
+	else if(rca_buffer_idx == 0)
+	{
+		if(rca_buffer_2_full) rca_overruns++;
+		rca_buffer_2_full = true;
+	}
+	else return;
+	rca_buffers_captured++;
+	CS_SignalProvider(CSP_RCA_ID);
 }
 
 void ADC_BATMON_IRQHandler(void)
 {
+	BDK_PROF_START(BDK_PROF_ADC_IRQ);
+
 	if(Sys_ADC_Get_BATMONStatus() & ADC_READY_TRUE)
 	{
 	#if STILL_DEBUGGING_THIS
@@ -188,6 +226,8 @@ void ADC_BATMON_IRQHandler(void)
 		if(rca_enabled) RCA_ADC_IRQHandler();
 	#endif
 	}
+
+	BDK_PROF_STOP(BDK_PROF_ADC_IRQ);
 }
 
 #if STILL_DEBUGGING_THIS
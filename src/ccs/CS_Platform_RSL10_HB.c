@@ -13,14 +13,22 @@
 // ----------------------------------------------------------------------------
 
 #include <BLE_CCS.h>
+#include <BLE_LECB.h>
 #include <ccs/CS.h>
+#include <ccs/CS_Platform.h>
 #include "BDK.h"
 
 #include <stdarg.h>
 
 #include "BLE_PeripheralServer.h"
+#include "RTE_app_config.h"
+#include "app_led.h"
 #include "aes.h"
 
+#if RTE_APP_CCS_RTT_ENABLED == 1
+#include "SEGGER_RTT.h"
+#endif
+
 
 #define AES_SALT  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x56, \
                     0xf7, 0xfc, 0x9c, 0x1b, 0x38, 0x44, 0xe2, 0x8b }
@@ -30,12 +38,93 @@
 
 #define AES_DATA_LENGTH 16
 
+/* RTT capture frame: [SYNC][provider ID][SEQ][LEN] followed by packet. */
+#define CS_RTT_SYNC 0xC5
+#define CS_RTT_HEADER_LENGTH 4
+
 uint32_t CS_GetHandleIndex(uint8_t provider_id);
 
+/* Stream transmit counters, indexed by provider ID bit. */
+static struct CS_PlatformStreamStats cs_stream_stats[CS_PROVIDER_ID_BITS];
+
+#if RTE_APP_CCS_RTT_ENABLED == 1
+static uint8_t cs_rtt_buffer[RTE_APP_CCS_RTT_BUFFER_SIZE];
+
+/* Per provider sequence numbers, indexed by provider ID bit. */
+static uint8_t cs_rtt_seq[CS_PROVIDER_ID_BITS];
+
+static uint32_t cs_rtt_dropped = 0;
+
+/** \brief Writes stream packet as one frame into RTT capture channel.
+ *
+ * Frame is either written whole or dropped if it does not fit into RTT buffer.
+ * Sequence number is incremented also for dropped frames so that host can
+ * detect the gap.
+ */
+static uint32_t CS_PlatformRttWrite(uint8_t provider_id, const uint8_t* data,
+        int len)
+{
+    uint8_t frame[CS_RTT_HEADER_LENGTH + UINT8_MAX];
+    uint32_t bit = __builtin_ctz(provider_id);
+
+    if (len > UINT8_MAX)
+    {
+        return BLE_CCS_STATUS_LENGTH;
+    }
+
+    frame[0] = CS_RTT_SYNC;
+    frame[1] = provider_id;
+    frame[2] = cs_rtt_seq[bit]++;
+    frame[3] = len;
+    memcpy(&frame[CS_RTT_HEADER_LENGTH], data, len);
+
+    if (SEGGER_RTT_Write(RTE_APP_CCS_RTT_CHANNEL, frame,
+            CS_RTT_HEADER_LENGTH + len) == 0)
+    {
+        cs_rtt_dropped += 1;
+        return BLE_CCS_STATUS_DROPPED;
+    }
+
+    return BLE_CCS_STATUS_OK;
+}
+#endif /* RTE_APP_CCS_RTT_ENABLED == 1 */
+
+/** \brief Counts result of stream packet transmission.
+ *
+ * All transports report status as \ref BLE_CCS_Status, BLE_LECB_Write uses
+ * the same code values.
+ */
+static int CS_PlatformStreamResult(uint8_t provider_id, uint32_t status)
+{
+    struct CS_PlatformStreamStats *stats =
+            &cs_stream_stats[__builtin_ctz(provider_id)];
+
+    switch (status)
+    {
+    case BLE_CCS_STATUS_OK:
+        stats->sent += 1;
+        return CS_OK;
+    case BLE_CCS_STATUS_DROPPED:
+        stats->dropped += 1;
+        return CS_ERROR;
+    default:
+        stats->failed += 1;
+        return CS_ERROR;
+    }
+}
+
 static void CS_PlatformReadHandler(struct BLE_CCS_RxIndData *ind)
 {
     uint8_t request_arr[CCS_CHARACTERISTIC_VALUE_LENGTH + 1];
 
+    /* Legacy request is always a single byte. */
+    if (ind->data_len >= CS_EXT_HEADER_LENGTH
+            && (ind->data[0] & CS_EXT_FLAG) != 0)
+    {
+        CS_ProcessExtRequest(ind->data, ind->data_len);
+        return;
+    }
+
     memcpy(request_arr, ind->data, ind->data_len);
     request_arr[ind->data_len] = 0;
 
@@ -60,13 +149,18 @@ int CS_PlatformInit(void)
     /* INitialize CCS Service Profile and assign our request handler. */
 	BLE_CCS_Initialize(&CS_PlatformReadHandler);
 
+#if RTE_APP_CCS_RTT_ENABLED == 1
+	SEGGER_RTT_ConfigUpBuffer(RTE_APP_CCS_RTT_CHANNEL, "CS_Stream",
+	        cs_rtt_buffer, sizeof(cs_rtt_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+#endif
+
 	return CS_OK;
 }
 
 int CS_PlatformWriteString(const char* tx_data, int tx_data_len, uint8_t provider_id)
 {
     if (BLE_CCS_Notify((unsigned char*)tx_data, tx_data_len, \
-    		CS_GetHandleIndex(provider_id)) == 0)
+    		CS_GetHandleIndex(provider_id)) == BLE_CCS_STATUS_OK)
     {
         return CS_OK;
     }
@@ -79,7 +173,7 @@ int CS_PlatformWriteString(const char* tx_data, int tx_data_len, uint8_t provide
 int CS_PlatformWriteBytes(const uint16_t* tx_data, int tx_data_len, uint8_t provider_id)
 {
     if (BLE_CCS_Notify((unsigned char *)tx_data, tx_data_len, \
-    		CS_GetHandleIndex(provider_id)) == 0)
+    		CS_GetHandleIndex(provider_id)) == BLE_CCS_STATUS_OK)
     {
         return CS_OK;
     }
@@ -89,6 +183,51 @@ int CS_PlatformWriteBytes(const uint16_t* tx_data, int tx_data_len, uint8_t prov
     }
 }
 
+int CS_PlatformWriteStream(const uint8_t* tx_data, int tx_data_len, uint8_t provider_id)
+{
+    uint32_t status;
+
+#if RTE_APP_CCS_RTT_ENABLED == 1
+    status = CS_PlatformRttWrite(provider_id, tx_data, tx_data_len);
+#if RTE_APP_CCS_RTT_ONLY == 1
+    return CS_PlatformStreamResult(provider_id, status);
+#endif
+#endif
+
+    /* Prefer bulk LE CoC transport, CCS is kept for legacy central devices. */
+    if (BLE_LECB_IsOpen())
+    {
+        status = BLE_LECB_Write(provider_id, tx_data, tx_data_len);
+
+        /* Characteristic read returns the last packet on any transport. */
+        BLE_CCS_SetStreamValue(tx_data, tx_data_len,
+                CS_GetHandleIndex(provider_id));
+    }
+    else
+    {
+        uint32_t ntf_status;
+
+        /* Centrals subscribed to MUX receive data frames in one stream,
+         * other centrals on characteristic assigned to the provider. */
+        status = BLE_CCS_MuxWrite(provider_id, tx_data, tx_data_len);
+        ntf_status = BLE_CCS_NotifyStream(tx_data, tx_data_len,
+                CS_GetHandleIndex(provider_id));
+
+        /* Ignore MUX status if there is no MUX subscriber. */
+        if (status == BLE_CCS_STATUS_OK || status == BLE_CCS_STATUS_NO_CLIENT)
+        {
+            status = ntf_status;
+        }
+    }
+
+    return CS_PlatformStreamResult(provider_id, status);
+}
+
+const struct CS_PlatformStreamStats* CS_PlatformGetStreamStats(uint8_t provider_id)
+{
+    return &cs_stream_stats[__builtin_ctz(provider_id)];
+}
+
 uint32_t CS_GetHandleIndex(uint8_t provider_id)
 {
 	switch(provider_id)
@@ -114,6 +253,11 @@ uint32_t CS_PlatformTime()
 	return HAL_Time();
 }
 
+void CS_PlatformIndicate(uint8_t led, uint16_t duration_ms)
+{
+	App_LedBlink((LedName) led, duration_ms, 0, 1);
+}
+
 void CS_PlatformLogPrintf(const char* fmt, ...)
 {
 	va_list args;
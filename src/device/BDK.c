@@ -55,6 +55,7 @@ void BDK_Schedule(void)
     BDK_TaskStart();
 
     Kernel_Schedule();
+    BDK_TaskRunScheduled();
 
     Sys_Watchdog_Refresh();
 }
@@ -64,6 +65,7 @@ void BDK_ScheduleNoWdt(void)
     BDK_TaskStart();
 
     Kernel_Schedule();
+    BDK_TaskRunScheduled();
 }
 
 //! \}
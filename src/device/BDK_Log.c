@@ -0,0 +1,272 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BDK_Log.c
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup LOG_GRP
+//! \{
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// INCLUDES
+//-----------------------------------------------------------------------------
+
+#include "BDK_Log.h"
+
+#if RTE_BDK_LOG_OUTPUT == 0
+#include "SEGGER_RTT.h"
+#else
+#include "HAL_error.h"
+#include "HAL_UART.h"
+#endif
+
+//-----------------------------------------------------------------------------
+// DEFINES / CONSTANTS
+//-----------------------------------------------------------------------------
+
+#define BDK_LOG_BUFFER_MASK            (RTE_BDK_LOG_BUFFER_WORDS - 1)
+
+#if (RTE_BDK_LOG_BUFFER_WORDS & BDK_LOG_BUFFER_MASK) != 0
+#error "RTE_BDK_LOG_BUFFER_WORDS must be power of two."
+#endif
+
+#if RTE_BDK_LOG_FLUSH_WORDS < BDK_LOG_MAX_ARGS + 1
+#error "RTE_BDK_LOG_FLUSH_WORDS must fit the longest log record."
+#endif
+
+//-----------------------------------------------------------------------------
+// EXTERNAL / FORWARD DECLARATIONS
+//-----------------------------------------------------------------------------
+
+/* Provided by linker for sections with C identifier names. */
+extern const char __start_bdk_log_fmt[];
+
+//-----------------------------------------------------------------------------
+// INTERNAL / STATIC VARIABLES
+//-----------------------------------------------------------------------------
+
+/** Ring buffer of log records.
+ *
+ * Header word of a record is written last and is zero until the record is
+ * committed.
+ */
+static uint32_t log_buf[RTE_BDK_LOG_BUFFER_WORDS];
+
+/** Free running index of next word to be reserved by producers. */
+static volatile uint32_t log_head = 0;
+
+/** Free running index of next word to be sent by BDK_LogFlush. */
+static volatile uint32_t log_tail = 0;
+
+static volatile uint32_t log_dropped = 0;
+
+/** Number of dropped records already reported to host. */
+static uint32_t log_dropped_reported = 0;
+
+/** Highest number of words found in ring buffer by BDK_LogFlush. */
+static uint32_t log_high_water = 0;
+
+/** Records taken from ring buffer by one BDK_LogFlush call. */
+static uint32_t log_out_buf[RTE_BDK_LOG_FLUSH_WORDS];
+
+#if RTE_BDK_LOG_OUTPUT == 0
+static uint8_t log_rtt_buf[RTE_BDK_LOG_RTT_BUFFER_SIZE];
+#else
+/** log_out_buf is owned by UART driver until the transfer completes. */
+static volatile bool log_tx_busy = false;
+#endif
+
+//-----------------------------------------------------------------------------
+// FUNCTION DEFINITIONS
+//-----------------------------------------------------------------------------
+
+#if RTE_BDK_LOG_OUTPUT == 1
+static void BDK_LogTxDone(char *data, uint32_t len)
+{
+    log_tx_busy = false;
+}
+#endif
+
+static void BDK_LogOutput(const uint32_t *words, uint32_t count,
+        uint32_t records)
+{
+#if RTE_BDK_LOG_OUTPUT == 0
+    SEGGER_RTT_Write(RTE_BDK_LOG_RTT_CHANNEL, words, count * sizeof(uint32_t));
+#else
+    /* Main loop carries on while the records are being sent. */
+    log_tx_busy = true;
+    if (HAL_UART_SendAsync((const char*)words, count * sizeof(uint32_t),
+            &BDK_LogTxDone) != HAL_OK)
+    {
+        log_tx_busy = false;
+        __atomic_fetch_add(&log_dropped, records, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+void BDK_LogInit(void)
+{
+#if RTE_BDK_LOG_OUTPUT == 0
+    SEGGER_RTT_ConfigUpBuffer(RTE_BDK_LOG_RTT_CHANNEL, "BDK_Log", log_rtt_buf,
+            sizeof(log_rtt_buf), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+#else
+    /* Transfer that was in progress ended with UART de-initialization. */
+    log_tx_busy = false;
+#endif
+}
+
+void BDK_LogWrite(const char *fmt, const uint32_t *args, uint32_t nargs)
+{
+    uint32_t head;
+    uint32_t i;
+
+    head = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+    do
+    {
+        if (head - log_tail + nargs + 1 > RTE_BDK_LOG_BUFFER_WORDS)
+        {
+            __atomic_fetch_add(&log_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (__atomic_compare_exchange_n(&log_head, &head, head + nargs + 1,
+            true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == false);
+
+    for (i = 0; i < nargs; ++i)
+    {
+        log_buf[(head + 1 + i) & BDK_LOG_BUFFER_MASK] = args[i];
+    }
+
+    /* Commit record. */
+    __atomic_store_n(&log_buf[head & BDK_LOG_BUFFER_MASK],
+            BDK_LOG_HDR_MARKER | (nargs << 16)
+            | (uint16_t)(fmt - __start_bdk_log_fmt),
+            __ATOMIC_RELEASE);
+}
+
+void BDK_LogFlush(void)
+{
+    uint32_t *out = log_out_buf;
+    uint32_t out_len = 0;
+    uint32_t records = 0;
+    uint32_t tail = log_tail;
+    uint32_t header;
+    uint32_t dropped;
+    uint32_t count;
+    uint32_t i;
+
+    /* Buffer only fills between flushes, so the peak is seen here. */
+    count = __atomic_load_n(&log_head, __ATOMIC_RELAXED) - tail;
+    if (count > log_high_water)
+    {
+        log_high_water = count;
+    }
+
+    /* Records stay in ring buffer until previous batch is sent. */
+    if (BDK_LogIsBusy() == true)
+    {
+        return;
+    }
+
+    while (tail != __atomic_load_n(&log_head, __ATOMIC_ACQUIRE))
+    {
+        header = __atomic_load_n(&log_buf[tail & BDK_LOG_BUFFER_MASK],
+                __ATOMIC_ACQUIRE);
+
+        /* Record is still being written by interrupted producer. */
+        if (header == 0)
+        {
+            break;
+        }
+
+        /* At most RTE_BDK_LOG_FLUSH_WORDS are sent per call, the rest is
+         * left for next pass of the main loop. */
+        count = ((header >> 16) & 0xFF) + 1;
+        if (out_len + count > RTE_BDK_LOG_FLUSH_WORDS)
+        {
+            break;
+        }
+
+        /* Whole record is cleared so that stale arguments are never taken
+         * for header of a record that is not committed yet. */
+        for (i = 0; i < count; ++i)
+        {
+            out[out_len + i] = log_buf[(tail + i) & BDK_LOG_BUFFER_MASK];
+            log_buf[(tail + i) & BDK_LOG_BUFFER_MASK] = 0;
+        }
+
+        tail += count;
+        __atomic_store_n(&log_tail, tail, __ATOMIC_RELEASE);
+
+        out_len += count;
+        records += 1;
+    }
+
+    dropped = log_dropped;
+    if (dropped != log_dropped_reported
+            && out_len + 2 <= RTE_BDK_LOG_FLUSH_WORDS)
+    {
+        out[out_len] = BDK_LOG_HDR_MARKER | (1 << 16) | BDK_LOG_ID_DROPPED;
+        out[out_len + 1] = dropped - log_dropped_reported;
+        log_dropped_reported = dropped;
+
+        out_len += 2;
+    }
+
+    if (out_len > 0)
+    {
+        BDK_LogOutput(out, out_len, records);
+    }
+}
+
+void BDK_LogFlushAll(void)
+{
+    uint32_t tail;
+
+    do
+    {
+        while (BDK_LogIsBusy() == true)
+        {
+        }
+
+        tail = log_tail;
+        BDK_LogFlush();
+    } while (tail != log_tail);
+
+    while (BDK_LogIsBusy() == true)
+    {
+    }
+}
+
+bool BDK_LogIsBusy(void)
+{
+#if RTE_BDK_LOG_OUTPUT == 0
+    return false;
+#else
+    return log_tx_busy;
+#endif
+}
+
+uint32_t BDK_LogGetDropped(void)
+{
+    return log_dropped;
+}
+
+uint32_t BDK_LogGetHighWater(void)
+{
+    return log_high_water;
+}
+
+//! \}
+//! \}
@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//! \file BDK_Prof.c
+//!
+//! \addtogroup BDK_GRP
+//! \{
+//! \addtogroup PROF_GRP
+//! \{
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// INCLUDES
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "BDK_Prof.h"
+
+//-----------------------------------------------------------------------------
+// DEFINES / CONSTANTS
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// EXTERNAL / FORWARD DECLARATIONS
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// INTERNAL / STATIC VARIABLES
+//-----------------------------------------------------------------------------
+
+static struct BDK_ProfStats prof_stats[BDK_PROF_PROBE_NB];
+
+static const char* const prof_names[BDK_PROF_PROBE_NB] = {
+    [BDK_PROF_ADC_IRQ] = "ADC_IRQ",
+    [BDK_PROF_DMIC_DMA_IRQ] = "DMIC_DMA_IRQ",
+    [BDK_PROF_PACK_AUDIO] = "PACK_AUDIO",
+    [BDK_PROF_CCS_NOTIFY] = "CCS_NOTIFY",
+    [BDK_PROF_KERNEL_SCHEDULE] = "KERNEL_SCHEDULE",
+    [BDK_PROF_TIMER_WAKEUP] = "TIMER_WAKEUP"
+};
+
+//-----------------------------------------------------------------------------
+// FUNCTION DEFINITIONS
+//-----------------------------------------------------------------------------
+
+void BDK_ProfInit(void)
+{
+#if RTE_BDK_PROF_ENABLED == 1
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+void BDK_ProfRecord(enum BDK_ProfProbe probe, uint32_t cycles)
+{
+    struct BDK_ProfStats *stats = &prof_stats[probe];
+    uint32_t bin;
+
+    /* Index of the most significant bit, zero is counted in bin 0. */
+    bin = 31 - __builtin_clz(cycles | 1);
+    if (bin >= BDK_PROF_HIST_BINS)
+    {
+        bin = BDK_PROF_HIST_BINS - 1;
+    }
+
+    if (stats->count == 0 || cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->count += 1;
+    stats->sum += cycles;
+    stats->hist[bin] += 1;
+}
+
+const struct BDK_ProfStats* BDK_ProfGetStats(enum BDK_ProfProbe probe)
+{
+    return &prof_stats[probe];
+}
+
+const char* BDK_ProfGetName(enum BDK_ProfProbe probe)
+{
+    return prof_names[probe];
+}
+
+void BDK_ProfReset(void)
+{
+    memset(prof_stats, 0, sizeof(prof_stats));
+}
+
+//! \}
+//! \}
@@ -25,11 +25,18 @@
 
 #include "BDK_Task.h"
 #include "HAL.h"
+#include "RTE_BDK.h"
 
 //-----------------------------------------------------------------------------
 // DEFINES / CONSTANTS
 //-----------------------------------------------------------------------------
 
+#define BDK_TASK_QUEUE_MASK            (RTE_BDK_TASK_QUEUE_SIZE - 1)
+
+#if (RTE_BDK_TASK_QUEUE_SIZE & BDK_TASK_QUEUE_MASK) != 0
+#error "RTE_BDK_TASK_QUEUE_SIZE must be power of two."
+#endif
+
 enum BDK_TaskRunState
 {
     BDK_TASK_STATE_RESET = 0,
@@ -61,15 +68,30 @@ struct BDK_Task_Resources
 static int BDK_DefaultMsgHandler(ke_msg_id_t const msg_id, void const *param,
         ke_task_id_t const dest_id, ke_task_id_t const src_id);
 
-static int BDK_TimerMsgHandler(ke_msg_id_t const msg_id, void const *param,
-        ke_task_id_t const dest_id, ke_task_id_t const src_id);
-
 //-----------------------------------------------------------------------------
 // INTERNAL / STATIC VARIABLES
 //-----------------------------------------------------------------------------
 
 struct BDK_Task_Resources task_res = { 0 };
 
+/** Ring buffer of scheduled callbacks.
+ *
+ * Callback pointer of an entry is written last and is NULL until the entry
+ * is committed.
+ */
+static struct BDK_TimerCmd task_queue[RTE_BDK_TASK_QUEUE_SIZE];
+
+/** Free running index of next entry to be reserved by producers. */
+static volatile uint32_t task_queue_head = 0;
+
+/** Free running index of next entry to be executed. */
+static volatile uint32_t task_queue_tail = 0;
+
+static volatile uint32_t task_queue_dropped = 0;
+
+/** Highest number of entries found in queue by BDK_TaskRunScheduled. */
+static uint32_t task_queue_high_water = 0;
+
 //-----------------------------------------------------------------------------
 // FUNCTION DEFINITIONS
 //-----------------------------------------------------------------------------
@@ -92,7 +114,6 @@ void BDK_TaskInit(void)
         task_res.run_state = BDK_TASK_STATE_INITIALIZED;
 
         BDK_TaskAddMsgHandler(KE_MSG_DEFAULT_HANDLER, &BDK_DefaultMsgHandler);
-        BDK_TaskAddMsgHandler(BDK_SCHEDULE_MSG, &BDK_TimerMsgHandler);
     }
 }
 
@@ -136,35 +157,91 @@ ke_msg_id_t BDK_TaskAllocateMsgId(void)
 
 void BDK_TaskSchedule(BDK_TaskCallback cb, void *arg)
 {
+    uint32_t head;
     struct BDK_TimerCmd *cmd;
 
-    if (task_res.run_state >= BDK_TASK_STATE_INITIALIZED)
+    if (task_res.run_state < BDK_TASK_STATE_INITIALIZED || cb == NULL)
+    {
+        return;
+    }
+
+    head = __atomic_load_n(&task_queue_head, __ATOMIC_RELAXED);
+    do
+    {
+        if (head - task_queue_tail >= RTE_BDK_TASK_QUEUE_SIZE)
+        {
+            __atomic_fetch_add(&task_queue_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (__atomic_compare_exchange_n(&task_queue_head, &head, head + 1,
+            true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == false);
+
+    cmd = &task_queue[head & BDK_TASK_QUEUE_MASK];
+    cmd->arg = arg;
+
+    /* Commit entry. */
+    __atomic_store_n(&cmd->cb, cb, __ATOMIC_RELEASE);
+}
+
+void BDK_TaskRunScheduled(void)
+{
+    uint32_t tail = task_queue_tail;
+    uint32_t head;
+    BDK_TaskCallback cb;
+    void *arg;
+
+    /* Callbacks scheduled by executed callbacks wait for the next run, so
+     * that a callback rescheduling itself cannot starve the main loop. */
+    head = __atomic_load_n(&task_queue_head, __ATOMIC_ACQUIRE);
+
+    /* Queue only fills between runs, so the peak is seen here. */
+    if (head - tail > task_queue_high_water)
     {
-        cmd = KE_MSG_ALLOC_DYN(BDK_SCHEDULE_MSG, TASK_APP, TASK_APP, BDK_TimerCmd, 0);
+        task_queue_high_water = head - tail;
+    }
+
+    while (tail != head)
+    {
+        struct BDK_TimerCmd *cmd = &task_queue[tail & BDK_TASK_QUEUE_MASK];
+
+        cb = __atomic_load_n(&cmd->cb, __ATOMIC_ACQUIRE);
 
-        cmd->cb = cb;
-        cmd->arg = arg;
+        /* Entry is still being written by interrupted producer. */
+        if (cb == NULL)
+        {
+            break;
+        }
 
-        ke_msg_send(cmd);
+        arg = cmd->arg;
+        cmd->cb = NULL;
+
+        /* Entry is released before the callback so that it can schedule
+         * again. */
+        tail += 1;
+        __atomic_store_n(&task_queue_tail, tail, __ATOMIC_RELEASE);
+
+        cb(arg);
     }
 }
 
-static int BDK_DefaultMsgHandler(ke_msg_id_t const msg_id, void const *param,
-        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+bool BDK_TaskIsSchedulePending(void)
 {
-    return KE_MSG_CONSUMED;
+    return task_queue_head != task_queue_tail;
 }
 
-static int BDK_TimerMsgHandler(ke_msg_id_t const msg_id, void const *param,
-        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+uint32_t BDK_TaskGetDropped(void)
 {
-    const struct BDK_TimerCmd *cmd = param;
+    return task_queue_dropped;
+}
 
-    if (cmd->cb != NULL)
-    {
-        cmd->cb(cmd->arg);
-    }
+uint32_t BDK_TaskGetHighWater(void)
+{
+    return task_queue_high_water;
+}
 
+static int BDK_DefaultMsgHandler(ke_msg_id_t const msg_id, void const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id)
+{
     return KE_MSG_CONSUMED;
 }
 
@@ -29,6 +29,14 @@
 // DEFINES / CONSTANTS
 //-----------------------------------------------------------------------------
 
+#if (RTE_BDK_EVENT_CALLBACK_BUCKETS & (RTE_BDK_EVENT_CALLBACK_BUCKETS - 1)) != 0
+#error RTE_BDK_EVENT_CALLBACK_BUCKETS must be power of two
+#endif
+
+/** Index of the list that holds handles with given event ID. */
+#define EVENT_CALLBACK_BUCKET(event_id) \
+    ((event_id) & (RTE_BDK_EVENT_CALLBACK_BUCKETS - 1))
+
 //-----------------------------------------------------------------------------
 // EXTERNAL / FORWARD DECLARATIONS
 //-----------------------------------------------------------------------------
@@ -37,7 +45,9 @@
 // INTERNAL / STATIC VARIABLES
 //-----------------------------------------------------------------------------
 
-static EventCallback_Type *head_handle = NULL;
+/** First and last registered handle of every bucket. */
+static EventCallback_Type *head_handle[RTE_BDK_EVENT_CALLBACK_BUCKETS];
+static EventCallback_Type *tail_handle[RTE_BDK_EVENT_CALLBACK_BUCKETS];
 
 //-----------------------------------------------------------------------------
 // FUNCTION DEFINITIONS
@@ -58,35 +68,41 @@ void EventCallback_Register(EventCallback_Type *handle)
 {
     ASSERT_DEBUG(handle != NULL);
 
-    if (head_handle == NULL)
+    const uint16_t bucket = EVENT_CALLBACK_BUCKET(handle->event_id);
+
+    handle->next = NULL;
+
+    if (head_handle[bucket] == NULL)
     {
-        head_handle = handle;
+        head_handle[bucket] = handle;
     }
     else
     {
-        EventCallback_Type *h = head_handle;
-        while (h->next != NULL)
-        {
-            h = h->next;
-        }
-        h->next = handle;
+        tail_handle[bucket]->next = handle;
     }
+    tail_handle[bucket] = handle;
 }
 
 void EventCallback_Remove(EventCallback_Type *handle)
 {
     ASSERT_DEBUG(handle != NULL);
 
-    if (handle == head_handle)
+    const uint16_t bucket = EVENT_CALLBACK_BUCKET(handle->event_id);
+
+    if (handle == head_handle[bucket])
     {
         // Remove handle from list if it was first registered handle.
-        head_handle = head_handle->next;
+        head_handle[bucket] = handle->next;
+        if (handle == tail_handle[bucket])
+        {
+            tail_handle[bucket] = NULL;
+        }
     }
     else
     {
-        if (head_handle != NULL)
+        if (head_handle[bucket] != NULL)
         {
-            EventCallback_Type *h = head_handle;
+            EventCallback_Type *h = head_handle[bucket];
 
             // Find handle taht is before the handle to be removed.
             while (h->next != handle)
@@ -102,6 +118,10 @@ void EventCallback_Remove(EventCallback_Type *handle)
 
             // Remove handle from list.
             h->next = handle->next;
+            if (handle == tail_handle[bucket])
+            {
+                tail_handle[bucket] = h;
+            }
 
             // Erase any pointer to other handlers from removed handle.
             handle->next = NULL;
@@ -113,8 +133,9 @@ void EventCallback_Call(uint16_t event_id)
 {
     EventCallback_Type *h;
 
-    // Iterate over all registered event handles.
-    for (h = head_handle; h != NULL; h = h->next)
+    // Iterate over handles that share the bucket of this event id.
+    for (h = head_handle[EVENT_CALLBACK_BUCKET(event_id)]; h != NULL;
+            h = h->next)
     {
         if (h->event_id == event_id && h->callback != NULL)
         {
@@ -24,6 +24,7 @@
 //-----------------------------------------------------------------------------
 
 #include <HAL.h>
+#include <HAL_RTC.h>
 #include <calibration.h>
 
 //-----------------------------------------------------------------------------
@@ -34,7 +35,7 @@
 // EXTERNAL / FORWARD DECLARATIONS
 //-----------------------------------------------------------------------------
 
-/** \brief HAL uses TIMER0 to keep track of time with 1 ms precision. */
+/** \brief HAL uses TIMER0 as 1 ms wake up tick for time based waits. */
 void TIMER0_IRQHandler(void);
 
 //-----------------------------------------------------------------------------
@@ -43,11 +44,20 @@ void TIMER0_IRQHandler(void);
 
 /** \brief Internal variable for keeping time.
  *
- * It is 32-bit unsigned type incremented every milli second and therefore will
- * overflow every ~49 days.
+ * It is 32-bit unsigned type advanced by RTC time in milli seconds and
+ * therefore will overflow every ~49 days.
  */
 volatile uint32_t hal_time_counter = 0;
 
+/** \brief Sub-millisecond remainder in 1/HAL_RTC_XTAL_FREQ ms units. */
+static uint32_t hal_time_frac = 0;
+
+/** \brief RTC time at which hal_time_counter was last advanced. */
+static uint32_t hal_time_checkpoint = 0;
+
+/** \brief Number of callers waiting for the 1 ms tick. */
+static uint32_t hal_tick_requests = 0;
+
 //-----------------------------------------------------------------------------
 // FUNCTION DEFINITIONS
 //-----------------------------------------------------------------------------
@@ -155,6 +165,22 @@ void HAL_Init(enum HAL_ClockConfiguration clk_conf)
 
 uint32_t HAL_Time(void)
 {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t now;
+    uint64_t frac;
+
+    __disable_irq();
+
+    now = HAL_RTC_GetTime(NULL);
+
+    /* Unsigned difference stays valid across RTC counter overflow. */
+    frac = (uint64_t)(now - hal_time_checkpoint) * 1000 + hal_time_frac;
+    hal_time_counter += (uint32_t)(frac / HAL_RTC_XTAL_FREQ);
+    hal_time_frac = (uint32_t)(frac % HAL_RTC_XTAL_FREQ);
+    hal_time_checkpoint = now;
+
+    __set_PRIMASK(primask);
+
     return hal_time_counter;
 }
 
@@ -162,11 +188,15 @@ void HAL_Delay(const uint32_t ms)
 {
     ASSERT_DEBUG(HAL_IsInterrupt() == false);
 
+    HAL_TICK_Request();
+
     uint32_t time_start = HAL_Time();
     while (HAL_Time() - time_start < ms)
     {
         SYS_WAIT_FOR_INTERRUPT;
     }
+
+    HAL_TICK_Release();
 }
 
 bool HAL_IsInterrupt(void)
@@ -188,12 +218,49 @@ void HAL_TICK_Init(void)
     NVIC_ClearPendingIRQ(TIMER0_IRQn);
     NVIC_EnableIRQ(TIMER0_IRQn);
 
-    Sys_Timers_Start(SELECT_TIMER0);
+    /* Timer state is not retained in deep sleep, restore running tick. */
+    if (hal_tick_requests > 0)
+    {
+        Sys_Timers_Start(SELECT_TIMER0);
+    }
+}
+
+void HAL_TICK_Request(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    hal_tick_requests += 1;
+    if (hal_tick_requests == 1)
+    {
+        Sys_Timers_Start(SELECT_TIMER0);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void HAL_TICK_Release(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    ASSERT_DEBUG(hal_tick_requests > 0);
+
+    hal_tick_requests -= 1;
+    if (hal_tick_requests == 0)
+    {
+        Sys_Timers_Stop(SELECT_TIMER0);
+        NVIC_ClearPendingIRQ(TIMER0_IRQn);
+    }
+
+    __set_PRIMASK(primask);
 }
 
 void TIMER0_IRQHandler(void)
 {
-    hal_time_counter += 1;
+    /* Tick only wakes up the core, time is read from RTC. */
 }
 
 //! \}
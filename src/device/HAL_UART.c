@@ -81,6 +81,12 @@ extern ARM_DRIVER_USART Driver_USART0;
  */
 static void HAL_UART_DriverCallback(uint32_t event);
 
+/** \brief Blocking receive with timeout, see \ref HAL_UART_Receive.
+ *
+ *  \private
+ */
+static int32_t HAL_UART_ReceiveWait(char *data, uint32_t num, uint32_t timeout);
+
 //-----------------------------------------------------------------------------
 // INTERNAL / STATIC VARIABLES
 //-----------------------------------------------------------------------------
@@ -183,6 +189,27 @@ extern bool HAL_UART_IsBusy(void)
 }
 
 int32_t HAL_UART_Receive(char *data, uint32_t num, uint32_t timeout)
+{
+    int32_t retval;
+
+    /* Platform time has no periodic interrupt, request wake up tick to
+     * check the timeout. */
+    if (timeout != HAL_UART_WAIT_FOREVER)
+    {
+        HAL_TICK_Request();
+    }
+
+    retval = HAL_UART_ReceiveWait(data, num, timeout);
+
+    if (timeout != HAL_UART_WAIT_FOREVER)
+    {
+        HAL_TICK_Release();
+    }
+
+    return retval;
+}
+
+static int32_t HAL_UART_ReceiveWait(char *data, uint32_t num, uint32_t timeout)
 {
     int32_t retval = 0;
     ARM_USART_STATUS status;
@@ -61,9 +61,12 @@
 //-----------------------------------------------------------------------------
 
 void SW_TIMER_IRQ_HANDLER_NAME(void);
-static inline void HW_TIMER_Initialize(const uint32_t timeout_val);
+static inline void HW_TIMER_Initialize(void);
 static inline void HW_TIMER_Pause(void);
 static inline void HW_TIMER_Resume(void);
+static inline uint32_t HW_TIMER_GetElapsed(void);
+static void HW_TIMER_Schedule(void);
+static void HW_TIMER_Update(void);
 static uint32_t SwTimer_GetTime(void *hint);
 
 //-----------------------------------------------------------------------------
@@ -71,7 +74,22 @@ static uint32_t SwTimer_GetTime(void *hint);
 //-----------------------------------------------------------------------------
 
 struct stimer_ctx sw_timer_ctx = { 0 };
-volatile uint16_t sw_timer_counter = 0;
+
+/** Timer ticks elapsed before the running shot. */
+volatile uint32_t sw_timer_base = 0;
+
+/** Length of the running shot in timer ticks, 0 while the timer is stopped. */
+static uint32_t sw_timer_shot = 0;
+
+/** Context time at which the running shot ends. */
+static uint64_t sw_timer_deadline = 0;
+
+/** Shortest shot in timer ticks, given by the timer resolution. */
+static uint32_t sw_timer_min_shot = 1;
+
+/** Set while the IRQ handler executes callbacks of expired timers. */
+static bool sw_timer_in_irq = false;
+
 bool sw_timer_initialized = false;
 
 //-----------------------------------------------------------------------------
@@ -84,14 +102,13 @@ void SwTimer_CTX_Initialize(uint32_t resolution_us)
 
     if (sw_timer_initialized == false)
     {
-        uint32_t tim1_timeout_val = (resolution_us >> 1)
-                & TIMER_VAL_TIMER_VALUE_Mask;
+        sw_timer_min_shot = (resolution_us >> 1) & TIMER_VAL_TIMER_VALUE_Mask;
 
         stimer_init_context(&sw_timer_ctx,
-                NULL, &SwTimer_GetTime, UINT16_MAX,
-                (tim1_timeout_val << 1) * 1000);
+                NULL, &SwTimer_GetTime, UINT32_MAX,
+                SW_TIMER_TIM1_US_PER_TICK * 1000);
 
-        HW_TIMER_Initialize(tim1_timeout_val);
+        HW_TIMER_Initialize();
 
         sw_timer_initialized = true;
     }
@@ -161,6 +178,9 @@ void SwTimer_Attach(struct SwTimer *tim, SwTimer_Callback callback,
     tim->scheduled = false;
     tim->pending = false;
 
+    stimer_arm(&tim->timer);
+    HW_TIMER_Update();
+
     SW_TIMER_EXIT_CRITICAL();
 }
 
@@ -173,6 +193,9 @@ extern void SwTimer_AttachInt(struct SwTimer *tim, SwTimer_Callback callback,
     tim->event_arg = arg;
     tim->scheduled = false;
 
+    stimer_arm(&tim->timer);
+    HW_TIMER_Update();
+
     SW_TIMER_EXIT_CRITICAL();
 }
 
@@ -185,6 +208,9 @@ extern void SwTimer_AttachScheduled(struct SwTimer *tim,
 	tim->event_arg = arg;
 	tim->scheduled = true;
 
+	stimer_arm(&tim->timer);
+	HW_TIMER_Update();
+
 	SW_TIMER_EXIT_CRITICAL();
 }
 
@@ -194,6 +220,7 @@ void SwTimer_ExpireInS(struct SwTimer *tim, uint32_t sec)
 
     stimer_expire_from_now_s(&tim->timer, sec);
     tim->pending = false;
+    HW_TIMER_Update();
 
     SW_TIMER_EXIT_CRITICAL();
 }
@@ -204,6 +231,7 @@ void SwTimer_ExpireInMs(struct SwTimer *tim, uint32_t ms)
 
     stimer_expire_from_now_ms(&tim->timer, ms);
     tim->pending = false;
+    HW_TIMER_Update();
 
     SW_TIMER_EXIT_CRITICAL();
 }
@@ -214,6 +242,7 @@ void SwTimer_ExpireInUs(struct SwTimer *tim, uint32_t us)
 
     stimer_expire_from_now_us(&tim->timer, us);
     tim->pending = false;
+    HW_TIMER_Update();
 
     SW_TIMER_EXIT_CRITICAL();
 }
@@ -237,6 +266,7 @@ void SwTimer_Advance(struct SwTimer *tim)
 
     stimer_advance(&tim->timer);
     tim->pending = false;
+    HW_TIMER_Update();
 
     SW_TIMER_EXIT_CRITICAL();
 }
@@ -246,6 +276,7 @@ void SwTimer_Start(struct SwTimer *tim)
 	SW_TIMER_ENTER_CRITICAL();
 
     stimer_start(&tim->timer);
+    HW_TIMER_Update();
 
     SW_TIMER_EXIT_CRITICAL();
 }
@@ -267,84 +298,178 @@ void SwTimer_GetElapsed(struct SwTimer *tim, struct SwTimer_Duration *t)
 
 void SwTimer_Restart(struct SwTimer *tim)
 {
+    SW_TIMER_ENTER_CRITICAL();
+
     stimer_restart_from_now(&tim->timer);
+    HW_TIMER_Update();
+
+    SW_TIMER_EXIT_CRITICAL();
 }
 
 void SW_TIMER_IRQ_HANDLER_NAME(void)
 {
-    /* Increment timebase. */
-    sw_timer_counter += 1;
-
-    /* Check all linked timers for expiration. */
     struct stimer *ts;
     struct SwTimer *tim;
+    uint64_t counts;
+
+    /* Shot has finished, its ticks are part of the time base now. */
+    sw_timer_base += sw_timer_shot;
+    sw_timer_shot = 0;
 
-    for (ts = sw_timer_ctx.root; ts != NULL; ts = ts->next)
+    sw_timer_in_irq = true;
+
+    /* Only timers that are due are visited, earliest first. */
+    while ((ts = stimer_get_next_expiry(&sw_timer_ctx, &counts)) != NULL
+            && counts == 0)
     {
         tim = (struct SwTimer*) ts;
 
-        /* * Only check timers that have attached callbacks.
-         *   Timers without callbacks either do not have expiration period or
-         *   are checked by application using SwTimer_IsExpired.
+        /* Expired timer is reported just once, it is armed again when its
+         * expiration time is set.
+         */
+        stimer_disarm(ts);
+
+        /* * Timers without callbacks are checked by application using
+         *   SwTimer_IsExpired.
          * * Check if this is the first time this timer is deemed as expired.
          *   This check is necessary for Event Kernel scheduled callbacks
-         *   which may not be executed by the time this interrupt is generated
-         *   again.
+         *   which may not be executed by the time this timer expires again.
          */
         if (tim->event_callback != NULL && tim->pending == false)
         {
-            if (ts->is_running == true && stimer_is_expired(ts) == true)
+            tim->pending = true;
+
+            if (tim->scheduled == true)
+            {
+                BDK_TaskSchedule(tim->event_callback, tim->event_arg);
+            }
+            else
             {
-                tim->pending = true;
-
-                if (tim->scheduled == true)
-                {
-                    BDK_TaskSchedule(tim->event_callback, tim->event_arg);
-                }
-                else
-                {
-                    tim->event_callback(tim->event_arg);
-                }
+                tim->event_callback(tim->event_arg);
             }
         }
     }
+
+    sw_timer_in_irq = false;
+
+    HW_TIMER_Schedule();
 }
 
-static inline void HW_TIMER_Initialize(const uint32_t timeout_val)
+static inline void HW_TIMER_Initialize(void)
 {
     /* Make sure SLOWCLK is running at 1MHz. */
     ASSERT_DEBUG(SystemCoreClock / ((CLK->DIV_CFG0 & CLK_DIV_CFG0_SLOWCLK_PRESCALE_Mask) + 1) == 1000000);
 
-    /* Schedule timeout every (timeout_val * 2) microseconds. */
-    Sys_Timer_Set_Control(RTE_SW_TIMER_INSTANCE,
-            TIMER_FREE_RUN | TIMER_SLOWCLK_DIV2 | TIMER_PRESCALE_1
-                    | timeout_val);
-
     /* Enable Timer1 interrupts */
     NVIC_ClearPendingIRQ(SW_TIMER_TIMER_IRQN);
     NVIC_EnableIRQ(SW_TIMER_TIMER_IRQN);
 
-    /* Start timer. */
-    Sys_Timers_Start(SW_TIMER_TIMER_SELECT);
+    /* Start first shot. */
+    HW_TIMER_Schedule();
 }
 
 static inline void HW_TIMER_Pause(void)
 {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    /* Time base keeps ticks of the interrupted shot and stops. */
     Sys_Timers_Stop(SW_TIMER_TIMER_SELECT);
+    sw_timer_base += HW_TIMER_GetElapsed();
+    sw_timer_shot = 0;
+
     NVIC_DisableIRQ(SW_TIMER_TIMER_IRQN);
     NVIC_ClearPendingIRQ(SW_TIMER_TIMER_IRQN);
+
+    __set_PRIMASK(primask);
 }
 
 static inline void HW_TIMER_Resume(void)
 {
     NVIC_ClearPendingIRQ(SW_TIMER_TIMER_IRQN);
     NVIC_EnableIRQ(SW_TIMER_TIMER_IRQN);
+    HW_TIMER_Schedule();
+}
+
+static inline uint32_t HW_TIMER_GetElapsed(void)
+{
+    uint32_t remaining;
+
+    if (sw_timer_shot == 0)
+    {
+        return 0;
+    }
+
+    /* Finished shot waits for its interrupt. */
+    if (NVIC_GetPendingIRQ(SW_TIMER_TIMER_IRQN) != 0)
+    {
+        return sw_timer_shot;
+    }
+
+    /* Timer counts down from the shot length. */
+    remaining = TIMER->VAL[RTE_SW_TIMER_INSTANCE] & TIMER_VAL_TIMER_VALUE_Mask;
+
+    return (remaining < sw_timer_shot) ? (sw_timer_shot - remaining) : 0;
+}
+
+/** Programs the timer to interrupt at the earliest armed deadline. */
+static void HW_TIMER_Schedule(void)
+{
+    uint64_t counts = SW_TIMER_TIM1_MAX_TICKS;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    /* Account ticks of the running shot before the counter is reloaded. */
+    Sys_Timers_Stop(SW_TIMER_TIMER_SELECT);
+    sw_timer_base += HW_TIMER_GetElapsed();
+    sw_timer_shot = 0;
+    NVIC_ClearPendingIRQ(SW_TIMER_TIMER_IRQN);
+
+    /* Without any deadline the longest shot keeps the time base running. */
+    stimer_get_next_expiry(&sw_timer_ctx, &counts);
+    if (counts > SW_TIMER_TIM1_MAX_TICKS)
+    {
+        counts = SW_TIMER_TIM1_MAX_TICKS;
+    }
+    if (counts < sw_timer_min_shot)
+    {
+        counts = sw_timer_min_shot;
+    }
+
+    sw_timer_shot = (uint32_t) counts;
+    sw_timer_deadline = sw_timer_ctx.now + counts;
+
+    Sys_Timer_Set_Control(RTE_SW_TIMER_INSTANCE,
+            TIMER_SHOT_MODE | TIMER_SLOWCLK_DIV2 | TIMER_PRESCALE_1
+                    | sw_timer_shot);
     Sys_Timers_Start(SW_TIMER_TIMER_SELECT);
+
+    __set_PRIMASK(primask);
+}
+
+/** Shortens the running shot if a timer was armed to expire before it ends. */
+static void HW_TIMER_Update(void)
+{
+    struct stimer *next;
+
+    /* IRQ handler programs the next shot once all callbacks are done and
+     * paused timer is not started.
+     */
+    if (sw_timer_in_irq == false && sw_timer_shot != 0)
+    {
+        next = stimer_get_next_expiry(&sw_timer_ctx, NULL);
+        if (next != NULL && next->deadline < sw_timer_deadline)
+        {
+            HW_TIMER_Schedule();
+        }
+    }
 }
 
 static uint32_t SwTimer_GetTime(void *hint)
 {
-    return sw_timer_counter;
+    return sw_timer_base + HW_TIMER_GetElapsed();
 }
 
 //! \}
@@ -34,73 +34,166 @@
 
 // ------------ Time duration functions
 
-// NOTE: had to change ns_advance to 64 bit integer to accommodate for longer
-// delays between timer updates.
+// Durations are kept as 64 bit counts of get_time_fn ticks. Seconds and
+// nanoseconds are converted only when a timer is set or its elapsed time read.
+
+static inline uint64_t
+ns_to_counts(struct stimer_ctx * ctx, uint64_t ns)
+{
+    // Rounded up, so that the timer does not expire early
+    return (ns + ctx->ns_per_count - 1) / ctx->ns_per_count;
+}
+
+
 static inline void
-advance_duration_ns(struct stimer_duration * td, uint64_t ns_advance)
+counts_to_duration(struct stimer_ctx * ctx, uint64_t counts,
+                   struct stimer_duration * td)
 {
-    // Need to be really careful about overflows in here, hence strange math
-    uint32_t headroom = 1000000000U - td->nanoseconds;
+    uint64_t ns = counts * ctx->ns_per_count;
 
-    while (ns_advance >= 1000000000U)
-    {
-        td->seconds += 1;
-        ns_advance -= 1000000000U;
-    }
+    td->seconds = (uint32_t)(ns / 1000000000U);
+    td->nanoseconds = (uint32_t)(ns % 1000000000U);
+}
 
-    if (ns_advance < headroom) {
-        td->nanoseconds += ns_advance;
-    } else {
-        td->seconds += 1;
-        td->nanoseconds = ns_advance - headroom;
+
+static inline uint64_t
+duration_to_counts(struct stimer_ctx * ctx, struct stimer_duration * td)
+{
+    return ns_to_counts(ctx,
+            ((uint64_t)td->seconds * 1000000000U) + td->nanoseconds);
+}
+
+
+// ------------------- Deadline heap functions
+
+static inline void
+heap_set(struct stimer_ctx * ctx, uint16_t index, struct stimer * ts)
+{
+    ctx->heap[index] = ts;
+    ts->heap_index = (int16_t)index;
+}
+
+
+static void
+heap_sift_up(struct stimer_ctx * ctx, uint16_t index)
+{
+    struct stimer * ts = ctx->heap[index];
+
+    while (index > 0) {
+        uint16_t parent = (index - 1) / 2;
+        if (ctx->heap[parent]->deadline <= ts->deadline) {
+            break;
+        }
+        heap_set(ctx, index, ctx->heap[parent]);
+        index = parent;
     }
+
+    heap_set(ctx, index, ts);
 }
 
 
-static inline bool
-is_duration_ge(struct stimer_duration * lhs, struct stimer_duration * rhs)
+static void
+heap_sift_down(struct stimer_ctx * ctx, uint16_t index)
 {
-    bool is_ge = false;
-    if (lhs->seconds > rhs->seconds) {
-        is_ge = true;
-    } else if (lhs->seconds == rhs->seconds) {
-        if (lhs->nanoseconds >= rhs->nanoseconds) {
-            is_ge = true;
+    struct stimer * ts = ctx->heap[index];
+
+    for (;;) {
+        uint16_t child = (2 * index) + 1;
+        if (child >= ctx->heap_size) {
+            break;
+        }
+        if (((child + 1) < ctx->heap_size)
+                && (ctx->heap[child + 1]->deadline < ctx->heap[child]->deadline)) {
+            child += 1;
+        }
+        if (ts->deadline <= ctx->heap[child]->deadline) {
+            break;
         }
+        heap_set(ctx, index, ctx->heap[child]);
+        index = child;
     }
-    return is_ge;
+
+    heap_set(ctx, index, ts);
 }
 
 
-static inline void
-set_duration_s(struct stimer_duration * td, uint32_t s)
+static void
+heap_insert(struct stimer_ctx * ctx, struct stimer * ts)
 {
-    td->seconds = s;
-    td->nanoseconds = 0;
+    if (ctx->heap_size < STIMER_HEAP_SIZE) {
+        uint16_t index = ctx->heap_size;
+        ctx->heap_size += 1;
+        heap_set(ctx, index, ts);
+        heap_sift_up(ctx, index);
+    } else {
+        ts->heap_index = STIMER_HEAP_OVERFLOW;
+        ctx->heap_overflow += 1;
+    }
 }
 
 
-static inline void
-set_duration_ms(struct stimer_duration * td, uint32_t ms)
+static void
+heap_remove(struct stimer_ctx * ctx, struct stimer * ts)
 {
-    td->seconds = ms / 1000;
-    td->nanoseconds = (ms % 1000) * 1000000;
+    if (STIMER_HEAP_OVERFLOW == ts->heap_index) {
+        ctx->heap_overflow -= 1;
+    } else if (STIMER_HEAP_NONE != ts->heap_index) {
+        uint16_t index = (uint16_t)ts->heap_index;
+
+        ctx->heap_size -= 1;
+        if (index < ctx->heap_size) {
+            // Move the last timer into the hole and restore ordering
+            struct stimer * last = ctx->heap[ctx->heap_size];
+            heap_set(ctx, index, last);
+            heap_sift_up(ctx, index);
+            heap_sift_down(ctx, (uint16_t)last->heap_index);
+        }
+    }
+
+    ts->heap_index = STIMER_HEAP_NONE;
 }
 
 
-static inline void
-set_duration_us(struct stimer_duration * td, uint32_t us)
+static void
+heap_update(struct stimer_ctx * ctx, struct stimer * ts)
 {
-    td->seconds = us / 1000000;
-    td->nanoseconds = (us % 1000000) * 1000;
+    if (ts->heap_index >= 0) {
+        heap_sift_up(ctx, (uint16_t)ts->heap_index);
+        heap_sift_down(ctx, (uint16_t)ts->heap_index);
+    } else if (STIMER_HEAP_NONE == ts->heap_index) {
+        heap_insert(ctx, ts);
+    }
 }
 
 
-static inline void
-set_duration_ns(struct stimer_duration * td, uint32_t ns)
+static void
+heap_coalesce(struct stimer_ctx * ctx, uint16_t index, uint64_t * wakeup)
 {
-    td->seconds = ns / 1000000000;
-    td->nanoseconds = ns % 1000000000;
+    // Children expire later, prune subtrees past the wake up
+    if ((index < ctx->heap_size) && (ctx->heap[index]->deadline <= *wakeup)) {
+        struct stimer * ts = ctx->heap[index];
+
+        if ((ts->deadline + ts->slack) < *wakeup) {
+            *wakeup = ts->deadline + ts->slack;
+        }
+
+        heap_coalesce(ctx, (2 * index) + 1, wakeup);
+        heap_coalesce(ctx, (2 * index) + 2, wakeup);
+    }
+}
+
+
+static uint16_t
+heap_count_until(struct stimer_ctx * ctx, uint16_t index, uint64_t wakeup)
+{
+    uint16_t count = 0;
+
+    if ((index < ctx->heap_size) && (ctx->heap[index]->deadline <= wakeup)) {
+        count = 1 + heap_count_until(ctx, (2 * index) + 1, wakeup)
+                + heap_count_until(ctx, (2 * index) + 2, wakeup);
+    }
+
+    return count;
 }
 
 
@@ -126,6 +219,11 @@ unlink_timer(struct stimer * ts)
 {
     struct stimer * next = ts->next;
     struct stimer_ctx * ctx = ts->ctx;
+
+    if (NULL != ctx) {
+        heap_remove(ctx, ts);
+    }
+
     ts->next = NULL;
     ts->ctx = NULL;
 
@@ -145,16 +243,25 @@ unlink_timer(struct stimer * ts)
 }
 
 
+static void
+update_context_time(struct stimer_ctx * ctx)
+{
+    uint32_t now = ctx->get_time_fn(ctx->hint);
+    int32_t diff = tm_get_diff(&ctx->tm, now, ctx->last_time);
+
+    if (diff > 0) {
+        ctx->now += (uint64_t)diff;
+        ctx->last_time = now;
+    }
+}
+
+
 static inline void
-checkpoint_timer(struct stimer * ts, struct tm_math * tm, uint32_t now)
+checkpoint_timer(struct stimer * ts)
 {
     if (ts->is_running) {
-        int32_t diff = tm_get_diff(tm, now, ts->checkpoint);
-        if (diff > 0) {
-            uint64_t ns_advance = (uint64_t)diff * (uint64_t)ts->ctx->ns_per_count;
-            advance_duration_ns(&ts->elapsed, ns_advance);
-            ts->checkpoint = now;
-        }
+        ts->elapsed += ts->ctx->now - ts->checkpoint;
+        ts->checkpoint = ts->ctx->now;
     }
 }
 
@@ -163,9 +270,29 @@ static inline void
 checkpoint_timer_2(struct stimer * ts)
 {
     if (ts->is_running) {
-        struct stimer_ctx * ctx = ts->ctx;
-        uint32_t now = ctx->get_time_fn(ctx->hint);
-        checkpoint_timer(ts, &ctx->tm, now);
+        update_context_time(ts->ctx);
+        checkpoint_timer(ts);
+    }
+}
+
+
+static void
+schedule_timer(struct stimer * ts)
+{
+    struct stimer_ctx * ctx = ts->ctx;
+
+    if (ts->is_running && (0 != ts->expire_interval)) {
+        // Deadline is fixed until the timer is set again, checkpoints do not
+        // move it.
+        if (ts->elapsed >= ts->expire_interval) {
+            ts->deadline = ts->checkpoint;
+        } else {
+            ts->deadline = ts->checkpoint + (ts->expire_interval - ts->elapsed);
+        }
+
+        heap_update(ctx, ts);
+    } else {
+        heap_remove(ctx, ts);
     }
 }
 
@@ -173,29 +300,21 @@ checkpoint_timer_2(struct stimer * ts)
 static inline void
 start_and_checkpoint_timer(struct stimer * ts)
 {
-    ts->checkpoint = ts->ctx->get_time_fn(ts->ctx->hint);
+    update_context_time(ts->ctx);
+
+    ts->checkpoint = ts->ctx->now;
     ts->is_running = true;
 
-    ts->elapsed.seconds = 0;
-    ts->elapsed.nanoseconds = 0;
+    ts->elapsed = 0;
 }
 
 
 static inline void
-timer_subtract_from_elapsed(struct stimer * ts, struct stimer_duration * td)
+expire_timer_from_now(struct stimer * ts, uint64_t counts)
 {
-    if (is_duration_ge(&ts->elapsed, td)) {
-        ts->elapsed.seconds -= td->seconds;
-        if (ts->elapsed.nanoseconds >= td->nanoseconds) {
-            ts->elapsed.nanoseconds -= td->nanoseconds;
-        } else {
-            ts->elapsed.seconds -= 1;
-            ts->elapsed.nanoseconds += (1000000000 - td->nanoseconds);
-        }
-    } else {
-        ts->elapsed.seconds = 0;
-        ts->elapsed.nanoseconds = 0;
-    }
+    start_and_checkpoint_timer(ts);
+    ts->expire_interval = counts;
+    schedule_timer(ts);
 }
 
 
@@ -219,6 +338,12 @@ stimer_alloc_context(void * hint,
         ctx->ns_per_count = ns_per_count;
         ctx->get_time_fn = get_time_fn;
         ctx->hint = hint;
+
+        ctx->now = 0;
+        ctx->last_time = get_time_fn(hint);
+
+        ctx->heap_size = 0;
+        ctx->heap_overflow = 0;
     }
 
     return ctx;
@@ -239,6 +364,12 @@ stimer_init_context(struct stimer_ctx *ctx,
         ctx->ns_per_count = ns_per_count;
         ctx->get_time_fn = get_time_fn;
         ctx->hint = hint;
+
+        ctx->now = 0;
+        ctx->last_time = get_time_fn(hint);
+
+        ctx->heap_size = 0;
+        ctx->heap_overflow = 0;
     }
 }
 
@@ -260,13 +391,79 @@ void
 stimer_execute_context(struct stimer_ctx * ctx)
 {
     if (NULL != ctx) {
-        uint32_t now = ctx->get_time_fn(ctx->hint);
+        update_context_time(ctx);
+    }
+}
+
+
+struct stimer *
+stimer_get_next_expiry(struct stimer_ctx * ctx, uint64_t * counts)
+{
+    struct stimer * next = NULL;
+
+    if (NULL != ctx) {
+        update_context_time(ctx);
+
+        if (ctx->heap_size > 0) {
+            next = ctx->heap[0];
+        }
+
+        if (ctx->heap_overflow > 0) {
+            struct stimer * ts;
+            for (ts = ctx->root; NULL != ts; ts = ts->next) {
+                if ((STIMER_HEAP_OVERFLOW == ts->heap_index)
+                        && ((NULL == next) || (ts->deadline < next->deadline))) {
+                    next = ts;
+                }
+            }
+        }
+
+        if ((NULL != next) && (NULL != counts)) {
+            *counts = (next->deadline > ctx->now) ? (next->deadline - ctx->now) : 0;
+        }
+    }
 
+    return next;
+}
+
+
+bool
+stimer_get_coalesced_wakeup(struct stimer_ctx * ctx,
+                            uint64_t * counts,
+                            uint16_t * timers)
+{
+    struct stimer * first = stimer_get_next_expiry(ctx, NULL);
+
+    if (NULL != first) {
+        uint64_t wakeup = first->deadline + first->slack;
         struct stimer * ts;
-        for (ts = ctx->root; NULL != ts; ts = ts->next) {
-            checkpoint_timer(ts, &ctx->tm, now);
+
+        heap_coalesce(ctx, 0, &wakeup);
+        if (ctx->heap_overflow > 0) {
+            for (ts = ctx->root; NULL != ts; ts = ts->next) {
+                if ((STIMER_HEAP_OVERFLOW == ts->heap_index)
+                        && ((ts->deadline + ts->slack) < wakeup)) {
+                    wakeup = ts->deadline + ts->slack;
+                }
+            }
         }
+
+        if (NULL != timers) {
+            *timers = heap_count_until(ctx, 0, wakeup);
+            if (ctx->heap_overflow > 0) {
+                for (ts = ctx->root; NULL != ts; ts = ts->next) {
+                    if ((STIMER_HEAP_OVERFLOW == ts->heap_index)
+                            && (ts->deadline <= wakeup)) {
+                        *timers += 1;
+                    }
+                }
+            }
+        }
+
+        *counts = (wakeup > ctx->now) ? (wakeup - ctx->now) : 0;
     }
+
+    return (NULL != first);
 }
 
 
@@ -284,14 +481,14 @@ stimer_alloc(struct stimer_ctx * ctx)
             ts->next = NULL;
 
             ts->checkpoint = 0;
-
-            ts->expire_interval.seconds = 0;
-            ts->expire_interval.nanoseconds = 0;
-
-            ts->elapsed.seconds = 0;
-            ts->elapsed.nanoseconds = 0;
+            ts->expire_interval = 0;
+            ts->elapsed = 0;
             ts->is_running = false;
 
+            ts->deadline = 0;
+            ts->heap_index = STIMER_HEAP_NONE;
+            ts->slack = 0;
+
             link_timer(ctx, ts);
         }
     }
@@ -308,14 +505,14 @@ stimer_init(struct stimer *ts, struct stimer_ctx * ctx)
             ts->next = NULL;
 
             ts->checkpoint = 0;
-
-            ts->expire_interval.seconds = 0;
-            ts->expire_interval.nanoseconds = 0;
-
-            ts->elapsed.seconds = 0;
-            ts->elapsed.nanoseconds = 0;
+            ts->expire_interval = 0;
+            ts->elapsed = 0;
             ts->is_running = false;
 
+            ts->deadline = 0;
+            ts->heap_index = STIMER_HEAP_NONE;
+            ts->slack = 0;
+
             link_timer(ctx, ts);
         }
     }
@@ -340,6 +537,42 @@ stimer_remove(struct stimer * ts)
 }
 
 
+void
+stimer_set_slack(struct stimer * ts, struct stimer_duration * t)
+{
+    if ((NULL != ts) && (NULL != ts->ctx) && (NULL != t)) {
+        ts->slack = duration_to_counts(ts->ctx, t);
+    }
+}
+
+
+void
+stimer_set_slack_ms(struct stimer * ts, uint32_t ms)
+{
+    if ((NULL != ts) && (NULL != ts->ctx)) {
+        ts->slack = ns_to_counts(ts->ctx, (uint64_t)ms * 1000000U);
+    }
+}
+
+
+void
+stimer_disarm(struct stimer * ts)
+{
+    if ((NULL != ts) && (NULL != ts->ctx)) {
+        heap_remove(ts->ctx, ts);
+    }
+}
+
+
+void
+stimer_arm(struct stimer * ts)
+{
+    if ((NULL != ts) && (NULL != ts->ctx)) {
+        schedule_timer(ts);
+    }
+}
+
+
 // ------------ Elapsed timer functions
 
 void
@@ -347,6 +580,7 @@ stimer_start(struct stimer * ts)
 {
     if ((NULL != ts) && (NULL != ts->ctx)) {
         start_and_checkpoint_timer(ts);
+        schedule_timer(ts);
     }
 }
 
@@ -358,6 +592,7 @@ stimer_stop(struct stimer * ts)
         if (ts->is_running) {
             checkpoint_timer_2(ts);
             ts->is_running = false;
+            schedule_timer(ts);
         }
     }
 }
@@ -366,13 +601,24 @@ stimer_stop(struct stimer * ts)
 void
 stimer_get_elapsed_time(struct stimer * ts, struct stimer_duration * t)
 {
-    if ((NULL != ts) && (NULL != t)) {
+    if ((NULL != ts) && (NULL != t) && (NULL != ts->ctx)) {
+        checkpoint_timer_2(ts);
+        counts_to_duration(ts->ctx, ts->elapsed, t);
+    }
+}
+
+
+uint64_t
+stimer_get_elapsed_counts(struct stimer * ts)
+{
+    uint64_t counts = 0;
+    if (NULL != ts) {
         if (NULL != ts->ctx) {
             checkpoint_timer_2(ts);
         }
-
-        *t = ts->elapsed;
+        counts = ts->elapsed;
     }
+    return counts;
 }
 
 
@@ -382,8 +628,7 @@ void
 stimer_expire_from_now(struct stimer * ts, struct stimer_duration * t)
 {
     if ((NULL != ts) && (NULL != ts->ctx) && (NULL != t)) {
-        start_and_checkpoint_timer(ts);
-        ts->expire_interval = *t;
+        expire_timer_from_now(ts, duration_to_counts(ts->ctx, t));
     }
 }
 
@@ -392,8 +637,7 @@ void
 stimer_expire_from_now_s(struct stimer * ts, uint32_t s)
 {
     if ((NULL != ts) && (NULL != ts->ctx)) {
-        start_and_checkpoint_timer(ts);
-        set_duration_s(&ts->expire_interval, s);
+        expire_timer_from_now(ts, ns_to_counts(ts->ctx, (uint64_t)s * 1000000000U));
     }
 }
 
@@ -402,8 +646,7 @@ void
 stimer_expire_from_now_ms(struct stimer * ts, uint32_t ms)
 {
     if ((NULL != ts) && (NULL != ts->ctx)) {
-        start_and_checkpoint_timer(ts);
-        set_duration_ms(&ts->expire_interval, ms);
+        expire_timer_from_now(ts, ns_to_counts(ts->ctx, (uint64_t)ms * 1000000U));
     }
 }
 
@@ -412,8 +655,7 @@ void
 stimer_expire_from_now_us(struct stimer * ts, uint32_t us)
 {
     if ((NULL != ts) && (NULL != ts->ctx)) {
-        start_and_checkpoint_timer(ts);
-        set_duration_us(&ts->expire_interval, us);
+        expire_timer_from_now(ts, ns_to_counts(ts->ctx, (uint64_t)us * 1000U));
     }
 }
 
@@ -422,8 +664,16 @@ void
 stimer_expire_from_now_ns(struct stimer * ts, uint32_t ns)
 {
     if ((NULL != ts) && (NULL != ts->ctx)) {
-        start_and_checkpoint_timer(ts);
-        set_duration_ns(&ts->expire_interval, ns);
+        expire_timer_from_now(ts, ns_to_counts(ts->ctx, ns));
+    }
+}
+
+
+void
+stimer_expire_from_now_counts(struct stimer * ts, uint64_t counts)
+{
+    if ((NULL != ts) && (NULL != ts->ctx)) {
+        expire_timer_from_now(ts, counts);
     }
 }
 
@@ -436,7 +686,7 @@ stimer_is_expired(struct stimer * ts)
         if (NULL != ts->ctx) {
             checkpoint_timer_2(ts);
         }
-        expired = is_duration_ge(&ts->elapsed, &ts->expire_interval);
+        expired = (ts->elapsed >= ts->expire_interval);
     }
     return expired;
 }
@@ -447,6 +697,7 @@ stimer_restart_from_now(struct stimer * ts)
 {
     if ((NULL != ts) && (NULL != ts->ctx) && (ts->is_running)) {
         start_and_checkpoint_timer(ts);
+        schedule_timer(ts);
     }
 }
 
@@ -456,6 +707,8 @@ stimer_advance(struct stimer * ts)
 {
     if ((NULL != ts) && (NULL != ts->ctx) && (ts->is_running)) {
         checkpoint_timer_2(ts);
-        timer_subtract_from_elapsed(ts, &ts->expire_interval);
+        ts->elapsed = (ts->elapsed >= ts->expire_interval) ?
+                (ts->elapsed - ts->expire_interval) : 0;
+        schedule_timer(ts);
     }
 }
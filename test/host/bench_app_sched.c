@@ -0,0 +1,292 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Audio service latency of the main loop scheduler under synthetic background
+// load, against the fixed order of the main loop before app_sched.
+//
+// Time is simulated. Every task advances the simulated RTC by its run time,
+// audio buffers and BLE events arrive at random times of the simulated RTC.
+// Latency is the time from an audio buffer becoming ready to the start of
+// CS_PollProviders serving it.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "app.h"
+
+#include "sim_clock.h"
+
+#define BENCH_BUFFERS_DEFAULT          (100000U)
+
+/** Audio buffer half ready every 10 ms. */
+#define BENCH_AUDIO_PERIOD             (HAL_RTC_MS_TO_TICKS(10))
+
+/** Packing and notification of one audio buffer. */
+#define BENCH_AUDIO_RUN                (3)
+
+/** Number of latency histogram bins of one RTC tick. */
+#define BENCH_HIST_BINS                (1024)
+
+/** Synthetic background load. Run times are in RTC ticks. */
+struct BenchLoad
+{
+    const char *name;
+
+    /** Mean ticks between BLE kernel events. */
+    uint32_t ble_interval;
+
+    /** Longest kernel message handler. */
+    uint32_t ble_run_max;
+
+    /** One in control_long_odds state machine passes runs long, as an LED
+     * blink delay or a battery measurement does. */
+    uint32_t control_long_odds;
+    uint32_t control_long_run;
+
+    /** Longest log flush. */
+    uint32_t log_run_max;
+};
+
+static const struct BenchLoad bench_loads[] = {
+    { "idle", HAL_RTC_MS_TO_TICKS(50), 3, 0, 0, 1 },
+    { "connected", HAL_RTC_MS_TO_TICKS(8), 33, 100, 33, 10 },
+    { "heavy", HAL_RTC_MS_TO_TICKS(3), 100, 20, 66, 33 }
+};
+
+static const struct BenchLoad *bench_load;
+static uint64_t bench_seed;
+
+static uint64_t bench_audio_ready;
+static uint64_t bench_ble_ready;
+static bool bench_ble_pending;
+static bool bench_log_pending;
+
+static uint32_t bench_hist[BENCH_HIST_BINS];
+static uint64_t bench_latency_sum;
+static uint32_t bench_latency_max;
+static uint32_t bench_served;
+
+static uint32_t Bench_Random(uint32_t max)
+{
+    return (uint32_t)SimRand_Range(&bench_seed, 0, max);
+}
+
+/** Raises events that became due while a task ran or the device slept. */
+static void Bench_Update(void)
+{
+    if (bench_ble_ready <= sim_rtc.ticks)
+    {
+        bench_ble_pending = true;
+        bench_log_pending = true;
+        bench_ble_ready = sim_rtc.ticks + 1
+                + Bench_Random(2 * bench_load->ble_interval);
+    }
+}
+
+static void Bench_Run(uint32_t ticks)
+{
+    SimClock_Advance(&sim_rtc, ticks);
+    Bench_Update();
+}
+
+bool CS_IsPollPending(void)
+{
+    return bench_audio_ready <= sim_rtc.ticks;
+}
+
+void CS_PollProviders(void)
+{
+    if (CS_IsPollPending() == true)
+    {
+        uint64_t latency = sim_rtc.ticks - bench_audio_ready;
+
+        bench_hist[(latency < BENCH_HIST_BINS) ? latency
+                : BENCH_HIST_BINS - 1] += 1;
+        bench_latency_sum += latency;
+        if (latency > bench_latency_max)
+        {
+            bench_latency_max = (uint32_t)latency;
+        }
+        bench_served += 1;
+
+        /* Next half of the DMA buffer. */
+        bench_audio_ready += BENCH_AUDIO_PERIOD;
+        Bench_Run(BENCH_AUDIO_RUN);
+    }
+}
+
+void Kernel_Schedule(void)
+{
+    if (bench_ble_pending == true)
+    {
+        bench_ble_pending = false;
+        Bench_Run(1 + Bench_Random(bench_load->ble_run_max));
+    }
+}
+
+bool BDK_TaskIsSchedulePending(void)
+{
+    return bench_ble_pending;
+}
+
+void BDK_TaskRunScheduled(void)
+{
+}
+
+void App_StateMachine(void)
+{
+    if (bench_load->control_long_odds != 0
+        && Bench_Random(bench_load->control_long_odds - 1) == 0)
+    {
+        Bench_Run(bench_load->control_long_run);
+    }
+}
+
+void App_LedUpdate(void)
+{
+}
+
+void App_DiagUpdate(void)
+{
+}
+
+void App_LogFlush(void)
+{
+    if (bench_log_pending == true)
+    {
+        bench_log_pending = false;
+        Bench_Run(Bench_Random(bench_load->log_run_max));
+    }
+}
+
+/** Main loop pass before app_sched: every piece of work once, in fixed
+ * order. */
+static void Bench_FlatRun(void)
+{
+    CS_PollProviders();
+    Kernel_Schedule();
+    BDK_TaskRunScheduled();
+    App_StateMachine();
+    App_LedUpdate();
+    App_DiagUpdate();
+    TRACE_FLUSH();
+}
+
+static bool Bench_FlatIsPending(void)
+{
+    return CS_IsPollPending() || BDK_TaskIsSchedulePending();
+}
+
+static uint32_t Bench_Percentile(uint32_t permille)
+{
+    uint64_t limit = (uint64_t)bench_served * permille / 1000;
+    uint64_t count = 0;
+    uint32_t bin;
+
+    for (bin = 0; bin < BENCH_HIST_BINS - 1; ++bin)
+    {
+        count += bench_hist[bin];
+        if (count >= limit)
+        {
+            break;
+        }
+    }
+
+    return bin;
+}
+
+static uint32_t Bench_TicksToUs(uint64_t ticks)
+{
+    return (uint32_t)(ticks * 1000000U / HAL_RTC_XTAL_FREQ);
+}
+
+static void Bench_Main(const struct BenchLoad *load, bool sched,
+        uint32_t buffers)
+{
+    bench_load = load;
+    bench_seed = 0x50;
+    bench_latency_sum = 0;
+    bench_latency_max = 0;
+    bench_served = 0;
+    for (uint32_t bin = 0; bin < BENCH_HIST_BINS; ++bin)
+    {
+        bench_hist[bin] = 0;
+    }
+
+    SimClock_Initialize(&sim_rtc, HAL_RTC_MAX_TICK_VALUE, 0);
+    bench_audio_ready = BENCH_AUDIO_PERIOD;
+    bench_ble_ready = 1 + Bench_Random(2 * load->ble_interval);
+    bench_ble_pending = false;
+    bench_log_pending = false;
+
+    while (bench_served < buffers)
+    {
+        if (sched == true)
+        {
+            App_SchedRun();
+        }
+        else
+        {
+            Bench_FlatRun();
+        }
+
+        /* Sleep until the next audio buffer or BLE event. */
+        if ((sched == true) ? (App_SchedIsPending() == false)
+                : (Bench_FlatIsPending() == false))
+        {
+            uint64_t wakeup = (bench_audio_ready < bench_ble_ready)
+                    ? bench_audio_ready : bench_ble_ready;
+
+            SimClock_Advance(&sim_rtc, wakeup - sim_rtc.ticks);
+            Bench_Update();
+        }
+    }
+
+    printf("%-10s %-6s %10lu %10lu %10lu %10lu\n", load->name,
+            (sched == true) ? "sched" : "flat",
+            (unsigned long)Bench_TicksToUs(bench_latency_sum / bench_served),
+            (unsigned long)Bench_TicksToUs(Bench_Percentile(990)),
+            (unsigned long)Bench_TicksToUs(Bench_Percentile(999)),
+            (unsigned long)Bench_TicksToUs(bench_latency_max));
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t buffers = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_BUFFERS_DEFAULT;
+
+    printf("Audio service latency in us, %lu buffers\n",
+            (unsigned long)buffers);
+    printf("%-10s %-6s %10s %10s %10s %10s\n", "load", "loop", "mean",
+            "p99", "p99.9", "max");
+
+    for (uint32_t i = 0; i < sizeof(bench_loads) / sizeof(bench_loads[0]);
+            ++i)
+    {
+        Bench_Main(&bench_loads[i], false, buffers);
+        Bench_Main(&bench_loads[i], true, buffers);
+    }
+
+    printf("Overruns counted by app_sched in all runs: audio %lu, ble %lu, "
+            "control %lu, log %lu\n",
+            (unsigned long)App_SchedGetOverruns(APP_SCHED_AUDIO),
+            (unsigned long)App_SchedGetOverruns(APP_SCHED_BLE),
+            (unsigned long)App_SchedGetOverruns(APP_SCHED_CONTROL),
+            (unsigned long)App_SchedGetOverruns(APP_SCHED_LOG));
+
+    return EXIT_SUCCESS;
+}
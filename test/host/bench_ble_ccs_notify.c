@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Stream packet notified with and without a copy into the CCS read cache.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <BLE_CCS.h>
+
+#include "sim_ble.h"
+#include "sim_clock.h"
+
+#define BENCH_START_HDL                (0x20)
+
+#define BENCH_ITERATIONS_DEFAULT       (10000000U)
+
+/** Every result is the best of this many runs to filter host noise. */
+#define BENCH_RUNS                     (5)
+
+/** Stream packet buffer of a provider, reused for every packet. */
+static uint8_t bench_packet[CCS_CHARACTERISTIC_VALUE_LENGTH];
+static volatile uint32_t bench_sink;
+
+static void Bench_Connect(void)
+{
+    struct gattm_add_svc_rsp rsp = { BENCH_START_HDL, GAP_ERR_NO_ERROR };
+
+    BLE_CCS_Initialize(NULL);
+    sim_ble_svc_add();
+    SimBle_Dispatch(GATTM_ADD_SVC_RSP, &rsp);
+    sim_ble_svc_enable(SIM_BLE_CONIDX);
+}
+
+/** Enables or disables notifications of the LCA characteristic. */
+static void Bench_Subscribe(bool enable)
+{
+    struct
+    {
+        struct gattc_write_req_ind ind;
+        uint16_t cccd;
+    } req = { { BENCH_START_HDL + 1 + CCS_IDX_LCA_VALUE_CCC, 0, 2 },
+              enable ? ATT_CCC_START_NTF : 0 };
+
+    SimBle_Dispatch(GATTC_WRITE_REQ_IND, &req);
+}
+
+/** Average ns of one packet notified by BLE_CCS_Notify or
+ * BLE_CCS_NotifyStream, including completion of the notification. */
+static double Bench_Notify(uint32_t iterations, bool stream)
+{
+    struct gattc_cmp_evt evt = { GATTC_NOTIFY, GAP_ERR_NO_ERROR, 0 };
+    uint32_t status = 0;
+    uint64_t t0;
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        bench_packet[0] = (uint8_t)i;
+        if (stream == true)
+        {
+            status |= BLE_CCS_NotifyStream(bench_packet, sizeof(bench_packet),
+                    CCS_IDX_LCA_VALUE_VAL);
+        }
+        else
+        {
+            status |= BLE_CCS_Notify(bench_packet, sizeof(bench_packet),
+                    CCS_IDX_LCA_VALUE_VAL);
+        }
+        SimBle_Dispatch(GATTC_CMP_EVT, &evt);
+    }
+    t0 = SimHost_GetTimeNs() - t0;
+
+    bench_sink = status;
+
+    return (double)t0 / iterations;
+}
+
+/** Average ns of a read request of the LCA value. */
+static double Bench_Read(uint32_t iterations)
+{
+    struct gattc_read_req_ind ind = { BENCH_START_HDL + 1
+            + CCS_IDX_LCA_VALUE_VAL };
+    struct gattc_read_cfm *cfm;
+    uint32_t sum = 0;
+    uint64_t t0;
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        SimBle_Dispatch(GATTC_READ_REQ_IND, &ind);
+        cfm = (struct gattc_read_cfm *)sim_ble_sent->param;
+        sum += cfm->value[0];
+    }
+    t0 = SimHost_GetTimeNs() - t0;
+
+    bench_sink = sum;
+
+    return (double)t0 / iterations;
+}
+
+static void Bench_Row(const char *name, uint32_t iterations, bool subscribed)
+{
+    double copy = 1e12;
+    double ref = 1e12;
+
+    Bench_Subscribe(subscribed);
+    for (uint32_t run = 0; run < BENCH_RUNS; ++run)
+    {
+        double t = Bench_Notify(iterations, false);
+        copy = (t < copy) ? t : copy;
+        t = Bench_Notify(iterations, true);
+        ref = (t < ref) ? t : ref;
+    }
+
+    printf("%-24s %10.2f %10.2f\n", name, copy, ref);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_ITERATIONS_DEFAULT;
+    double copy = 1e12;
+    double ref = 1e12;
+
+    Bench_Connect();
+
+    printf("%u byte packets, ns per call\n",
+            (unsigned int)sizeof(bench_packet));
+    printf("%-24s %10s %10s\n", "", "copy", "reference");
+
+    Bench_Row("notify, subscribed", iterations, true);
+    Bench_Row("notify, not subscribed", iterations, false);
+
+    /* Read of the cache filled by the last call of each kind */
+    for (uint32_t run = 0; run < BENCH_RUNS; ++run)
+    {
+        double t;
+
+        Bench_Notify(1, false);
+        t = Bench_Read(iterations);
+        copy = (t < copy) ? t : copy;
+        Bench_Notify(1, true);
+        t = Bench_Read(iterations);
+        ref = (t < ref) ? t : ref;
+    }
+    printf("%-24s %10.2f %10.2f\n", "read request", copy, ref);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,288 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Main loop overhead of provider polling and request dispatch of CS.c with
+// all provider ID bits registered, against the linear scan of the provider
+// table CS.c used before.
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ccs/CS.h>
+#include <ccs/CS_Platform.h>
+
+#include "sim_clock.h"
+
+#define BENCH_ITERATIONS_DEFAULT       (10000000U)
+
+/** Every result is the best of this many runs to filter host noise. */
+#define BENCH_RUNS                     (5)
+
+/** Providers registered besides SYS, which owns the last ID bit. */
+#define BENCH_PROVIDERS                (CS_PROVIDER_ID_BITS - 1)
+
+/** Requests address only the low 5 bits of the provider ID. */
+#define BENCH_REQUEST_BITS             (5)
+
+static struct CS_Provider_Struct bench_providers[CS_MAX_PROVIDER_COUNT];
+static volatile uint32_t bench_polls;
+
+/** Provider table of the linear scan, CS_MAX_PROVIDER_COUNT entries. */
+static struct CS_Provider_Struct *bench_table[CS_MAX_PROVIDER_COUNT];
+
+int CS_PlatformInit(struct CS_Handle_Struct *handle)
+{
+    return CS_OK;
+}
+
+int CS_PlatformWriteBytes(const uint16_t *tx_data_buf, int tx_data_buf_len,
+        uint8_t provider_id)
+{
+    return CS_OK;
+}
+
+int CS_PlatformWriteString(const char *tx_data, int tx_data_len,
+        uint8_t provider_id)
+{
+    return CS_OK;
+}
+
+uint32_t CS_PlatformTime(void)
+{
+    return 0;
+}
+
+void CS_PlatformLogPrintf(const char *fmt, ...)
+{
+}
+
+void CS_PlatformLogVprintf(const char *fmt, va_list args)
+{
+}
+
+void CS_PlatformLogLock(void)
+{
+}
+
+void CS_PlatformLogUnlock(void)
+{
+}
+
+static int Bench_RequestHandler(const struct CS_Request_Struct *request)
+{
+    for (uint32_t i = 0; i < BENCH_PROVIDERS; ++i)
+    {
+        if (request->provider_id & bench_providers[i].id)
+        {
+            bench_providers[i].req_token = (request->op_code & START);
+        }
+    }
+
+    return CS_NO_RESPONSE;
+}
+
+static void Bench_PollHandler(void)
+{
+    bench_polls += 1;
+}
+
+/** Former CS_PollProviders, visits every registered provider. */
+static __attribute__((noinline)) void Bench_LinearPoll(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if ((bench_table[i]->req_token & START)
+            && bench_table[i]->poll_handler != NULL)
+        {
+            bench_table[i]->poll_handler();
+        }
+    }
+}
+
+/** Provider lookup of former CS_ProcessRequest. */
+static __attribute__((noinline)) void Bench_LinearDispatch(
+        const struct CS_Request_Struct *request, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (request->provider_id & bench_table[i]->id)
+        {
+            bench_table[i]->request_handler(request);
+        }
+    }
+}
+
+/** Starts first streaming providers and stops the others. */
+static void Bench_SetStreaming(uint32_t streaming)
+{
+    for (uint32_t i = 0; i < BENCH_REQUEST_BITS; ++i)
+    {
+        struct CS_Request_Struct request = {
+            .provider_id = 1U << i,
+            .op_code = (i < streaming) ? START_STREAMING_RELEASE
+                    : STOP_STREAMING,
+            .reserved = DEFAULT
+        };
+
+        CS_ProcessRequest(&request);
+    }
+}
+
+/** Average ns of one poll. Mode 0 polls bit masks of CS.c, modes 1 and 2
+ * scan a table of BENCH_PROVIDERS + 1 and of CS_MAX_PROVIDER_COUNT
+ * providers. Streams signal new data before every poll if signal is set,
+ * mode 3 only signals as interrupt handlers do. */
+static double Bench_Poll(uint32_t mode, bool signal, uint32_t iterations)
+{
+    uint64_t t0 = SimHost_GetTimeNs();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        switch (mode)
+        {
+            case 0:
+                if (signal == true)
+                {
+                    CS_SignalProvider((1U << BENCH_PROVIDERS) - 1);
+                }
+                CS_PollProviders();
+                break;
+            case 1:
+                Bench_LinearPoll(BENCH_PROVIDERS + 1);
+                break;
+            case 2:
+                Bench_LinearPoll(CS_MAX_PROVIDER_COUNT);
+                break;
+            default:
+                CS_SignalProvider((1U << BENCH_PROVIDERS) - 1);
+                break;
+        }
+    }
+
+    return (double)(SimHost_GetTimeNs() - t0) / iterations;
+}
+
+/** Average ns of dispatching a request to the last addressable provider. */
+static double Bench_Dispatch(uint32_t mode, uint32_t iterations)
+{
+    struct CS_Request_Struct request = {
+        .provider_id = 1U << (BENCH_REQUEST_BITS - 1),
+        .op_code = STOP_STREAMING,
+        .reserved = DEFAULT
+    };
+    uint64_t t0 = SimHost_GetTimeNs();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        switch (mode)
+        {
+            case 0:
+                CS_ProcessRequest(&request);
+                break;
+            case 1:
+                Bench_LinearDispatch(&request, BENCH_PROVIDERS + 1);
+                break;
+            default:
+                Bench_LinearDispatch(&request, CS_MAX_PROVIDER_COUNT);
+                break;
+        }
+    }
+
+    return (double)(SimHost_GetTimeNs() - t0) / iterations;
+}
+
+static double Bench_Best(double (*fn)(uint32_t, bool, uint32_t),
+        uint32_t mode, bool signal, uint32_t iterations)
+{
+    double best = 1e12;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; ++run)
+    {
+        double t = fn(mode, signal, iterations);
+        best = (t < best) ? t : best;
+    }
+
+    return best;
+}
+
+static double Bench_DispatchAdapter(uint32_t mode, bool signal,
+        uint32_t iterations)
+{
+    return Bench_Dispatch(mode, iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_ITERATIONS_DEFAULT;
+    static const uint32_t streaming[] = { 0, 1, 3, 5 };
+
+    CS_Init();
+
+    /* Every ID bit is taken. The linear table is filled up to
+     * CS_MAX_PROVIDER_COUNT with idle providers that no request
+     * addresses. */
+    for (uint32_t i = 0; i < CS_MAX_PROVIDER_COUNT; ++i)
+    {
+        bench_providers[i].id = (i < BENCH_PROVIDERS) ? (1U << i) : 0;
+        bench_providers[i].req_token = STOP;
+        bench_providers[i].request_handler = &Bench_RequestHandler;
+        bench_providers[i].poll_handler = &Bench_PollHandler;
+        bench_table[i] = &bench_providers[i];
+
+        if (i < BENCH_PROVIDERS)
+        {
+            CS_RegisterProvider(&bench_providers[i]);
+        }
+    }
+
+    printf("ns per main loop pass, %d providers registered\n",
+            (int)BENCH_PROVIDERS + 1);
+    printf("%-22s %12s %12s %12s\n", "", "mask", "linear 8",
+            "linear 16");
+
+    for (uint32_t i = 0; i < sizeof(streaming) / sizeof(streaming[0]); ++i)
+    {
+        char name[32];
+
+        Bench_SetStreaming(streaming[i]);
+
+        snprintf(name, sizeof(name), "signalled, %lu streaming",
+                (unsigned long)streaming[i]);
+        printf("%-22s %12.2f %12.2f %12.2f\n", name,
+                Bench_Best(&Bench_Poll, 0, true, iterations),
+                Bench_Best(&Bench_Poll, 1, true, iterations),
+                Bench_Best(&Bench_Poll, 2, true, iterations));
+
+        snprintf(name, sizeof(name), "idle, %lu streaming",
+                (unsigned long)streaming[i]);
+        printf("%-22s %12.2f %12.2f %12.2f\n", name,
+                Bench_Best(&Bench_Poll, 0, false, iterations),
+                Bench_Best(&Bench_Poll, 1, false, iterations),
+                Bench_Best(&Bench_Poll, 2, false, iterations));
+    }
+
+    printf("%-22s %12.2f\n", "CS_SignalProvider",
+            Bench_Best(&Bench_Poll, 3, false, iterations));
+
+    Bench_SetStreaming(0);
+    printf("%-22s %12.2f %12.2f %12.2f\n", "request dispatch",
+            Bench_Best(&Bench_DispatchAdapter, 0, false, iterations),
+            Bench_Best(&Bench_DispatchAdapter, 1, false, iterations),
+            Bench_Best(&Bench_DispatchAdapter, 2, false, iterations));
+
+    return (bench_polls > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
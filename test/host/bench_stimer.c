@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Throughput of stimer calls made on every pass of the main loop.
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stimer.h>
+#include <HAL_RTC.h>
+
+#include "sim_clock.h"
+
+#define BENCH_ITERATIONS_DEFAULT       (10000000U)
+
+static volatile uint32_t bench_sink;
+
+static void Bench_Report(const char *name, uint32_t iterations, uint64_t ns)
+{
+    printf("%-40s %10.2f ns/call %10.2f Mcalls/s\n", name,
+            (double)ns / iterations, iterations * 1000.0 / (double)ns);
+}
+
+/** Time source read and context time extension. */
+static void Bench_ExecuteContext(uint32_t iterations)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    uint64_t t0;
+
+    SimClock_Initialize(&clk, HAL_RTC_MAX_TICK_VALUE, 0);
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime,
+            HAL_RTC_MAX_TICK_VALUE, 1000000000U / HAL_RTC_XTAL_FREQ);
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        clk.ticks += 3;
+        stimer_execute_context(&ctx);
+    }
+    Bench_Report("stimer_execute_context", iterations,
+            SimHost_GetTimeNs() - t0);
+
+    bench_sink = (uint32_t)ctx.now;
+}
+
+/** Expiration check of a running timer, clock advancing or standing still. */
+static void Bench_IsExpired(uint32_t iterations, uint32_t step,
+        const char *name)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    struct stimer ts;
+    uint32_t expired = 0;
+    uint64_t t0;
+
+    SimClock_Initialize(&clk, HAL_RTC_MAX_TICK_VALUE, 0);
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime,
+            HAL_RTC_MAX_TICK_VALUE, 1000000000U / HAL_RTC_XTAL_FREQ);
+    stimer_init(&ts, &ctx);
+    stimer_expire_from_now_counts(&ts, UINT64_MAX / 2);
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        clk.ticks += step;
+        expired += stimer_is_expired(&ts);
+    }
+    Bench_Report(name, iterations, SimHost_GetTimeNs() - t0);
+
+    bench_sink = expired;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_ITERATIONS_DEFAULT;
+
+    Bench_ExecuteContext(iterations);
+    Bench_IsExpired(iterations, 3, "stimer_is_expired (clock running)");
+    Bench_IsExpired(iterations, 0, "stimer_is_expired (clock stopped)");
+
+    return EXIT_SUCCESS;
+}
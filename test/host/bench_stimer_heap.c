@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Next expiry lookup through the deadline heap against checkpointing and
+// scanning every timer, with 1 to 256 running timers.
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stimer.h>
+#include <HAL_RTC.h>
+
+#include "sim_clock.h"
+
+#define BENCH_TIMERS_MAX               (256)
+
+#define BENCH_ITERATIONS_DEFAULT       (1000000U)
+
+/** Every result is the best of this many runs to filter host noise. */
+#define BENCH_RUNS                     (5)
+
+static struct SimClock bench_clk;
+static struct stimer_ctx bench_ctx;
+static struct stimer bench_timers[BENCH_TIMERS_MAX];
+static volatile uint64_t bench_sink;
+
+/** Next expiry found the way Timer_SetWakeupAtNextEvent did before the heap:
+ * checkpoint every timer of the list and keep the smallest remaining time. */
+static struct stimer * Bench_LinearNextExpiry(struct stimer_ctx *ctx,
+        uint64_t *counts)
+{
+    struct stimer *next = NULL;
+    uint64_t next_counts = UINT64_MAX;
+
+    for (struct stimer *ts = ctx->root; ts != NULL; ts = ts->next)
+    {
+        if (ts->is_running == true && ts->expire_interval != 0)
+        {
+            uint64_t elapsed = stimer_get_elapsed_counts(ts);
+            uint64_t remaining = (elapsed >= ts->expire_interval) ? 0
+                    : ts->expire_interval - elapsed;
+
+            if (remaining < next_counts)
+            {
+                next = ts;
+                next_counts = remaining;
+            }
+        }
+    }
+
+    *counts = next_counts;
+
+    return next;
+}
+
+static void Bench_Setup(uint32_t timers, uint64_t *seed)
+{
+    SimClock_Initialize(&bench_clk, HAL_RTC_MAX_TICK_VALUE, 0);
+    stimer_init_context(&bench_ctx, &bench_clk, &SimClock_GetTime,
+            HAL_RTC_MAX_TICK_VALUE, 1000000000U / HAL_RTC_XTAL_FREQ);
+
+    for (uint32_t k = 0; k < timers; ++k)
+    {
+        stimer_init(&bench_timers[k], &bench_ctx);
+        stimer_expire_from_now_counts(&bench_timers[k],
+                SimRand_Range(seed, HAL_RTC_S_TO_TICKS(1),
+                        HAL_RTC_S_TO_TICKS(3600)));
+    }
+}
+
+/** Average ns of one main loop pass that only looks up the next expiry. */
+static double Bench_NextExpiry(uint32_t timers, uint32_t iterations,
+        uint64_t *seed, bool linear)
+{
+    uint64_t counts = 0;
+    uint64_t sum = 0;
+    uint64_t t0;
+
+    Bench_Setup(timers, seed);
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        bench_clk.ticks += 1;
+        if (linear == true)
+        {
+            Bench_LinearNextExpiry(&bench_ctx, &counts);
+        }
+        else
+        {
+            stimer_get_next_expiry(&bench_ctx, &counts);
+        }
+        sum += counts;
+    }
+    t0 = SimHost_GetTimeNs() - t0;
+
+    bench_sink = sum;
+
+    return (double)t0 / iterations;
+}
+
+/** Average ns of a pass that also sets a new expiration of one timer, as
+ * timer callbacks or state machine transitions do. */
+static double Bench_Reschedule(uint32_t timers, uint32_t iterations,
+        uint64_t *seed)
+{
+    uint64_t counts = 0;
+    uint64_t sum = 0;
+    uint64_t t0;
+
+    Bench_Setup(timers, seed);
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        struct stimer *ts = &bench_timers[(i * 2654435761U) % timers];
+
+        bench_clk.ticks += 1;
+        stimer_expire_from_now_counts(ts,
+                HAL_RTC_S_TO_TICKS(1) + (i & 0xFFFFF));
+        stimer_get_next_expiry(&bench_ctx, &counts);
+        sum += counts;
+    }
+    t0 = SimHost_GetTimeNs() - t0;
+
+    bench_sink = sum;
+
+    return (double)t0 / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_ITERATIONS_DEFAULT;
+    uint64_t seed = 0x41;
+
+    printf("STIMER_HEAP_SIZE %d, ns per main loop pass\n", STIMER_HEAP_SIZE);
+    printf("%7s %12s %12s %12s\n", "timers", "heap", "linear", "reschedule");
+
+    for (uint32_t timers = 1; timers <= BENCH_TIMERS_MAX; timers *= 2)
+    {
+        double heap = 1e12;
+        double linear = 1e12;
+        double resched = 1e12;
+
+        for (uint32_t run = 0; run < BENCH_RUNS; ++run)
+        {
+            double t = Bench_NextExpiry(timers, iterations, &seed, false);
+            heap = (t < heap) ? t : heap;
+            t = Bench_NextExpiry(timers, iterations, &seed, true);
+            linear = (t < linear) ? t : linear;
+            t = Bench_Reschedule(timers, iterations, &seed);
+            resched = (t < resched) ? t : resched;
+        }
+
+        printf("%7lu %12.2f %12.2f %12.2f\n", (unsigned long)timers, heap,
+                linear, resched);
+    }
+
+    return EXIT_SUCCESS;
+}
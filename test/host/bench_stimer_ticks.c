@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Checkpoint and expiration check of stimer durations kept in 64-bit ticks
+// against the seconds/nanoseconds durations stimer used before.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stimer.h>
+#include <HAL_RTC.h>
+
+#include "sim_clock.h"
+
+#define BENCH_ITERATIONS_DEFAULT       (10000000U)
+
+/** Every result is the best of this many runs to filter host noise. */
+#define BENCH_RUNS                     (5)
+
+/** Timer state as kept by stimer with seconds/nanoseconds durations. */
+struct BenchSnsTimer
+{
+    struct stimer_ctx *ctx;
+    uint32_t checkpoint;
+    struct stimer_duration elapsed;
+    struct stimer_duration expire_interval;
+};
+
+static volatile uint64_t bench_sink;
+
+/** Former advance_duration_ns of stimer.c. */
+static inline void Bench_SnsAdvance(struct stimer_duration *td,
+        uint64_t ns_advance)
+{
+    uint32_t headroom = 1000000000U - td->nanoseconds;
+
+    while (ns_advance >= 1000000000U)
+    {
+        td->seconds += 1;
+        ns_advance -= 1000000000U;
+    }
+
+    if (ns_advance < headroom)
+    {
+        td->nanoseconds += ns_advance;
+    }
+    else
+    {
+        td->seconds += 1;
+        td->nanoseconds = ns_advance - headroom;
+    }
+}
+
+/** Former checkpoint_timer_2 of stimer.c. Not inlined, as the library calls
+ * it is compared with. */
+static __attribute__((noinline)) void Bench_SnsCheckpoint(
+        struct BenchSnsTimer *ts)
+{
+    struct stimer_ctx *ctx = ts->ctx;
+    uint32_t now = ctx->get_time_fn(ctx->hint);
+    int32_t diff = tm_get_diff(&ctx->tm, now, ts->checkpoint);
+
+    if (diff > 0)
+    {
+        Bench_SnsAdvance(&ts->elapsed, (uint64_t)diff * ctx->ns_per_count);
+        ts->checkpoint = now;
+    }
+}
+
+/** Former stimer_is_expired with is_duration_ge of stimer.c. */
+static __attribute__((noinline)) bool Bench_SnsIsExpired(
+        struct BenchSnsTimer *ts)
+{
+    Bench_SnsCheckpoint(ts);
+
+    return (ts->elapsed.seconds > ts->expire_interval.seconds)
+            || ((ts->elapsed.seconds == ts->expire_interval.seconds)
+                && (ts->elapsed.nanoseconds
+                    >= ts->expire_interval.nanoseconds));
+}
+
+/** Average ns of one call, clock advanced by step ticks before each call.
+ * Mode 0 and 1 checkpoint, mode 2 and 3 check expiration. Even modes use
+ * 64-bit ticks, odd modes seconds/nanoseconds. */
+static double Bench_Run(uint32_t mode, uint32_t step, uint32_t iterations)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    struct stimer ts;
+    struct BenchSnsTimer sns;
+    uint64_t sum = 0;
+    uint64_t t0;
+
+    SimClock_Initialize(&clk, HAL_RTC_MAX_TICK_VALUE, 0);
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime,
+            HAL_RTC_MAX_TICK_VALUE, 1000000000U / HAL_RTC_XTAL_FREQ);
+
+    /* Never expires within the run, both sides do the full comparison. */
+    stimer_init(&ts, &ctx);
+    stimer_expire_from_now_counts(&ts, UINT64_MAX / 2);
+
+    sns.ctx = &ctx;
+    sns.checkpoint = SimClock_GetTime(&clk);
+    sns.elapsed.seconds = 0;
+    sns.elapsed.nanoseconds = 0;
+    sns.expire_interval.seconds = UINT32_MAX;
+    sns.expire_interval.nanoseconds = 0;
+
+    t0 = SimHost_GetTimeNs();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        clk.ticks += step;
+        switch (mode)
+        {
+            case 0:
+                sum += stimer_get_elapsed_counts(&ts);
+                break;
+            case 1:
+                Bench_SnsCheckpoint(&sns);
+                sum += sns.elapsed.nanoseconds;
+                break;
+            case 2:
+                sum += stimer_is_expired(&ts);
+                break;
+            default:
+                sum += Bench_SnsIsExpired(&sns);
+                break;
+        }
+    }
+    t0 = SimHost_GetTimeNs() - t0;
+
+    bench_sink = sum;
+
+    return (double)t0 / iterations;
+}
+
+static void Bench_Report(const char *name, uint32_t step,
+        uint32_t iterations)
+{
+    double ns[4];
+
+    for (uint32_t mode = 0; mode < 4; ++mode)
+    {
+        ns[mode] = 1e12;
+        for (uint32_t run = 0; run < BENCH_RUNS; ++run)
+        {
+            double t = Bench_Run(mode, step, iterations);
+            ns[mode] = (t < ns[mode]) ? t : ns[mode];
+        }
+    }
+
+    printf("%-12s %12.2f %12.2f %12.2f %12.2f\n", name, ns[0], ns[1], ns[2],
+            ns[3]);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0)
+            : BENCH_ITERATIONS_DEFAULT;
+
+    printf("ns per call, clock advanced before each call\n");
+    printf("%-12s %12s %12s %12s %12s\n", "step", "ckpt ticks", "ckpt s/ns",
+            "exp ticks", "exp s/ns");
+
+    /* Main loop pass, a wake up after 1 s and after a 60 s sleep. */
+    Bench_Report("3 ticks", 3, iterations);
+    Bench_Report("1 s", HAL_RTC_S_TO_TICKS(1), iterations);
+    Bench_Report("60 s", HAL_RTC_S_TO_TICKS(60), iterations);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Minimal check macros shared by host tests.
+//-----------------------------------------------------------------------------
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** \brief Number of failed checks, test exits with failure if not 0. */
+static unsigned int host_test_failures = 0;
+
+/** \brief Seed of the random sequence, reported with every failure. */
+static unsigned long long host_test_seed = 0;
+
+/** \brief Reports failed check, gives up after a few failures so that
+ * randomized tests do not flood the output.
+ */
+#define HOST_CHECK(cond)                                                \
+    do                                                                  \
+    {                                                                   \
+        if (!(cond))                                                    \
+        {                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s (seed %llu)\n",    \
+                    __FILE__, __LINE__, #cond, host_test_seed);         \
+            if (++host_test_failures >= 10)                             \
+            {                                                           \
+                exit(EXIT_FAILURE);                                     \
+            }                                                           \
+        }                                                               \
+    } while (0)
+
+/** \brief Reads random seed from first argument, default keeps runs of the
+ * test suite reproducible.
+ */
+#define HOST_TEST_SEED(argc, argv, dflt)                                \
+    ((host_test_seed = ((argc) > 1) ? strtoull((argv)[1], NULL, 0)      \
+            : (dflt)) != 0 ? host_test_seed : (host_test_seed = 1))
+
+/** \brief Result of the test executable. */
+#define HOST_TEST_RESULT()                                              \
+    ((host_test_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE)
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <BDK_Task.h>
+#include <BLE_PeripheralServer.h>
+#include <HAL_error.h>
+
+#include "sim_ble.h"
+
+#define SIM_BLE_HANDLERS_MAX           (16)
+
+/** \brief Message buffer of SIM_BLE_PARAM_MAX parameter bytes. */
+union SimBleMsgBuffer
+{
+    struct SimBleMsg msg;
+    uint8_t raw[sizeof(struct SimBleMsg) + SIM_BLE_PARAM_MAX];
+};
+
+struct SimBleHandler
+{
+    ke_msg_id_t id;
+    ke_msg_func_t func;
+};
+
+struct SimBleMsg *sim_ble_sent = NULL;
+uint32_t sim_ble_sent_count = 0;
+void (*sim_ble_svc_add)(void) = NULL;
+void (*sim_ble_svc_enable)(uint8_t conidx) = NULL;
+
+/* Allocation alternates between two buffers, so the last sent message stays
+ * valid while the next one is being filled. */
+static union SimBleMsgBuffer sim_ble_msg[2];
+static uint32_t sim_ble_alloc_count = 0;
+
+static struct SimBleHandler sim_ble_handlers[SIM_BLE_HANDLERS_MAX];
+static uint32_t sim_ble_handler_count = 0;
+
+void *ke_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id, uint16_t const param_len)
+{
+    struct SimBleMsg *msg = &sim_ble_msg[sim_ble_alloc_count++ & 1].msg;
+
+    if (param_len > SIM_BLE_PARAM_MAX)
+    {
+        HAL_Failed(__FILE__, __LINE__, "param_len > SIM_BLE_PARAM_MAX");
+    }
+
+    msg->id = id;
+    msg->dest_id = dest_id;
+    msg->param_len = param_len;
+
+    return msg->param;
+}
+
+void ke_msg_send(void const *param_ptr)
+{
+    sim_ble_sent = (struct SimBleMsg *)((uint8_t *)param_ptr
+            - offsetof(struct SimBleMsg, param));
+    sim_ble_sent_count += 1;
+}
+
+void ke_timer_set(ke_msg_id_t const timer_id, ke_task_id_t const task,
+        uint32_t const delay)
+{
+}
+
+void ke_timer_clear(ke_msg_id_t const timer_id, ke_task_id_t const task)
+{
+}
+
+void BDK_TaskAddMsgHandler(ke_msg_id_t id, ke_msg_func_t func)
+{
+    if (sim_ble_handler_count >= SIM_BLE_HANDLERS_MAX)
+    {
+        HAL_Failed(__FILE__, __LINE__, "too many message handlers");
+    }
+
+    sim_ble_handlers[sim_ble_handler_count].id = id;
+    sim_ble_handlers[sim_ble_handler_count].func = func;
+    sim_ble_handler_count += 1;
+}
+
+ke_msg_id_t BDK_TaskAllocateMsgId(void)
+{
+    static ke_msg_id_t next_id = TASK_FIRST_MSG(TASK_ID_APP) + 0x40;
+
+    return next_id++;
+}
+
+void BDK_BLE_Initialize(void)
+{
+}
+
+void BDK_BLE_AddService(void (*svc_add_func)(void),
+        void (*svc_enable_func)(uint8_t))
+{
+    sim_ble_svc_add = svc_add_func;
+    sim_ble_svc_enable = svc_enable_func;
+}
+
+void BDK_BLE_ProfileAddedInd(void)
+{
+}
+
+bool BDK_BLE_IsConnected(void)
+{
+    return true;
+}
+
+signed int BDK_BLE_GetConIdxBySlot(uint8_t slot)
+{
+    return (slot == 0) ? SIM_BLE_CONIDX : INVALID_DEV_IDX;
+}
+
+signed int BDK_BLE_GetConnectionSlot(uint8_t conidx)
+{
+    return (conidx == SIM_BLE_CONIDX) ? 0 : INVALID_DEV_IDX;
+}
+
+void HAL_Failed(const char* file, int line, const char* expr)
+{
+    fprintf(stderr, "%s:%d: assertion failed: %s\n", file, line, expr);
+    exit(EXIT_FAILURE);
+}
+
+int32_t SimBle_Dispatch(ke_msg_id_t id, void const *param)
+{
+    uint32_t sent = sim_ble_sent_count;
+
+    for (uint32_t i = 0; i < sim_ble_handler_count; ++i)
+    {
+        if (sim_ble_handlers[i].id == id)
+        {
+            sim_ble_handlers[i].func(id, param, TASK_APP, SIM_BLE_GATTC_ID);
+
+            return (int32_t)(sim_ble_sent_count - sent);
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Simulated BLE kernel and BDK BLE stack for host tests of BLE profiles. One
+// peer device is connected in slot 0. Messages sent by the profile are kept
+// until the next message is sent so that tests can inspect them.
+//-----------------------------------------------------------------------------
+#ifndef SIM_BLE_H_
+#define SIM_BLE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include <rsl10_ke.h>
+
+/** \brief Connection index of the connected peer device. */
+#define SIM_BLE_CONIDX                 (0)
+
+/** \brief Source task of messages from GATTC of the connected device. */
+#define SIM_BLE_GATTC_ID               KE_BUILD_ID(TASK_GATTC, SIM_BLE_CONIDX)
+
+/** \brief Longest parameters of a message. */
+#define SIM_BLE_PARAM_MAX              (1024)
+
+/** \brief Kernel message, parameters follow the header. */
+struct SimBleMsg
+{
+    ke_msg_id_t id;
+    ke_task_id_t dest_id;
+    uint16_t param_len;
+    uint64_t param[];
+};
+
+/** \brief Last message sent by ke_msg_send, NULL before the first one. */
+extern struct SimBleMsg *sim_ble_sent;
+
+/** \brief Number of messages sent by ke_msg_send. */
+extern uint32_t sim_ble_sent_count;
+
+/** \brief Service callbacks passed to BDK_BLE_AddService. */
+extern void (*sim_ble_svc_add)(void);
+extern void (*sim_ble_svc_enable)(uint8_t conidx);
+
+/** \brief Passes message from GATTC of the connected device to the handler
+ * registered with BDK_TaskAddMsgHandler.
+ *
+ * \returns Number of messages sent by the handler or -1 if no handler is
+ * registered for the message.
+ */
+extern int32_t SimBle_Dispatch(ke_msg_id_t id, void const *param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_BLE_H_ */
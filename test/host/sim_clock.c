@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+
+#include <time.h>
+
+#include <rsl10.h>
+#include <HAL_RTC.h>
+
+#include "sim_clock.h"
+
+struct SimClock sim_rtc = { 0, HAL_RTC_MAX_TICK_VALUE };
+
+struct SimAcsWakeupState sim_acs_wakeup_state = { 0 };
+
+static bool sim_rtc_alarm_armed = false;
+static uint64_t sim_rtc_alarm = 0;
+
+void SimClock_Initialize(struct SimClock *clk, uint32_t max_value,
+        uint32_t start)
+{
+    clk->ticks = start;
+    clk->max_value = max_value;
+}
+
+void SimClock_Advance(struct SimClock *clk, uint64_t ticks)
+{
+    clk->ticks += ticks;
+}
+
+uint32_t SimClock_GetTime(void *hint)
+{
+    const struct SimClock *clk = hint;
+
+    if (clk->max_value == UINT32_MAX)
+    {
+        return (uint32_t)clk->ticks;
+    }
+
+    return (uint32_t)(clk->ticks % ((uint64_t)clk->max_value + 1));
+}
+
+uint32_t SimRtc_GetTime(void *hint)
+{
+    return SimClock_GetTime(&sim_rtc);
+}
+
+bool SimRtc_IsAlarmArmed(void)
+{
+    return sim_rtc_alarm_armed;
+}
+
+uint64_t SimRtc_GetAlarm(void)
+{
+    return sim_rtc_alarm;
+}
+
+bool SimRtc_FireAlarm(uint32_t late)
+{
+    if (sim_rtc_alarm_armed == false)
+    {
+        return false;
+    }
+
+    if (sim_rtc.ticks < sim_rtc_alarm)
+    {
+        sim_rtc.ticks = sim_rtc_alarm;
+    }
+    sim_rtc.ticks += late;
+
+    sim_rtc_alarm_armed = false;
+    sim_acs_wakeup_state.WAKEUP_SRC_BYTE = WAKEUP_DUE_TO_RTC_ALARM_BYTE;
+
+    return true;
+}
+
+uint64_t SimRand_Next(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+
+    return x;
+}
+
+uint64_t SimRand_Range(uint64_t *state, uint64_t lo, uint64_t hi)
+{
+    uint64_t span = hi - lo + 1;
+
+    if (span == 0)
+    {
+        return SimRand_Next(state);
+    }
+
+    return lo + SimRand_Next(state) % span;
+}
+
+uint64_t SimHost_GetTimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+// ----------------------------------------------------------------------------
+// RTC HAL of the simulated RTC
+// ----------------------------------------------------------------------------
+
+void HAL_RTC_Initialize(void)
+{
+    sim_rtc_alarm_armed = false;
+    sim_acs_wakeup_state.WAKEUP_SRC_BYTE = 0;
+}
+
+void HAL_RTC_Wakeup(void)
+{
+}
+
+uint32_t HAL_RTC_GetTime(void *hint)
+{
+    return SimRtc_GetTime(hint);
+}
+
+void HAL_RTC_SetAlarmTicks(uint32_t ticks)
+{
+    sim_rtc_alarm = sim_rtc.ticks + ticks;
+    sim_rtc_alarm_armed = true;
+}
+
+void HAL_RTC_SetAlarmS(uint32_t sec)
+{
+    HAL_RTC_SetAlarmTicks(HAL_RTC_S_TO_TICKS(sec));
+}
+
+void HAL_RTC_SetAlarmMs(uint32_t ms)
+{
+    HAL_RTC_SetAlarmTicks(HAL_RTC_MS_TO_TICKS(ms));
+}
+
+void HAL_RTC_SetAlarmUs(uint32_t us)
+{
+    HAL_RTC_SetAlarmTicks(HAL_RTC_US_TO_TICKS((uint64_t)us));
+}
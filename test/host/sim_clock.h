@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Simulated time sources for host tests of stimer and application timers.
+//-----------------------------------------------------------------------------
+#ifndef SIM_CLOCK_H_
+#define SIM_CLOCK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief Counter that wraps around to 0 after max_value.
+ *
+ * Time is kept as 64-bit tick count so that tests can compare against the
+ * true time that passed, the counter value is derived from it.
+ */
+struct SimClock
+{
+    /** \brief Ticks elapsed since the counter was last 0 at start. */
+    uint64_t ticks;
+
+    /** \brief Last value of the counter before it wraps around. */
+    uint32_t max_value;
+};
+
+/** \brief Simulated RTC driving the application timer context. */
+extern struct SimClock sim_rtc;
+
+/** \brief Sets counter wrap around value and initial counter value. */
+extern void SimClock_Initialize(struct SimClock *clk, uint32_t max_value,
+        uint32_t start);
+
+/** \brief Advances the clock, jumps of any length are allowed. */
+extern void SimClock_Advance(struct SimClock *clk, uint64_t ticks);
+
+/** \brief stimer_get_time_fn reading the counter of clock given by hint. */
+extern uint32_t SimClock_GetTime(void *hint);
+
+/** \brief stimer_get_time_fn reading the counter of \ref sim_rtc. */
+extern uint32_t SimRtc_GetTime(void *hint);
+
+/** \brief Checks whether RTC alarm is armed. */
+extern bool SimRtc_IsAlarmArmed(void);
+
+/** \brief Returns ticks of \ref sim_rtc at which the armed alarm fires. */
+extern uint64_t SimRtc_GetAlarm(void);
+
+/** \brief Delivers armed RTC alarm as a deep sleep wake up.
+ *
+ * Clock jumps to the alarm time plus \p late ticks, emulating interrupt
+ * latency or an ISR that was held off by a critical section. Wake up source
+ * is set to RTC alarm and the alarm is disarmed. Clock is never moved back if
+ * it already passed the alarm.
+ *
+ * \returns false if no alarm was armed.
+ */
+extern bool SimRtc_FireAlarm(uint32_t late);
+
+/** \brief Returns next value of a xorshift64 generator, never 0. */
+extern uint64_t SimRand_Next(uint64_t *state);
+
+/** \brief Returns uniformly distributed value in range [lo, hi]. */
+extern uint64_t SimRand_Range(uint64_t *state, uint64_t lo, uint64_t hi);
+
+/** \brief Returns monotonic host time in nanoseconds for benchmarks. */
+extern uint64_t SimHost_GetTimeNs(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CLOCK_H_ */
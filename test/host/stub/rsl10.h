@@ -0,0 +1,36 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Host replacement of the RSL10 device header. Provides only registers used
+// by sources built into host tests.
+//-----------------------------------------------------------------------------
+#ifndef RSL10_H
+#define RSL10_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WAKEUP_DUE_TO_RTC_ALARM_BYTE   ((uint8_t)0x2)
+
+struct SimAcsWakeupState
+{
+    uint8_t WAKEUP_SRC_BYTE;
+};
+
+/** \brief Wake up source register, written by the simulated RTC. */
+extern struct SimAcsWakeupState sim_acs_wakeup_state;
+
+#define ACS_WAKEUP_STATE               (&sim_acs_wakeup_state)
+
+#endif /* RSL10_H */
@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Host replacement of the RSL10 BLE stack header. Provides only the GAP and
+// GATT definitions used by sources built into host tests.
+//-----------------------------------------------------------------------------
+#ifndef RSL10_BLE_H
+#define RSL10_BLE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rsl10_ke.h"
+
+#define BD_ADDR_LEN                    (6)
+#define GAP_KEY_LEN                    (16)
+#define GAP_RAND_NB_LEN                (8)
+#define ATT_UUID_128_LEN               (16)
+#define ATT_DEFAULT_MTU                (23)
+#define ATT_CCC_START_NTF              (0x0001)
+
+#define GAP_PHY_LE_1MBPS               (1)
+#define GAP_PHY_LE_2MBPS               (2)
+#define GAP_PHY_LE_CODED               (4)
+
+#define GAP_ERR_NO_ERROR               (0x00)
+
+enum
+{
+    ATT_ERR_INVALID_HANDLE = 0x01,
+    ATT_ERR_READ_NOT_PERMITTED = 0x02,
+    ATT_ERR_WRITE_NOT_PERMITTED = 0x03,
+    ATT_ERR_INVALID_OFFSET = 0x07,
+    ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN = 0x0D
+};
+
+/* Attribute permissions, see PERM() */
+enum
+{
+    PERM_POS_RD = 0,
+    PERM_POS_WRITE_COMMAND = 2,
+    PERM_POS_WRITE_REQ = 4,
+    PERM_POS_NTF = 8,
+    PERM_POS_RI = 15,
+    PERM_POS_UUID_LEN = 13,
+    PERM_POS_SVC_UUID_LEN = 5,
+
+    PERM_MASK_RD = 0x0003,
+    PERM_MASK_WRITE_COMMAND = 0x000C,
+    PERM_MASK_WRITE_REQ = 0x0030,
+    PERM_MASK_NTF = 0x0300,
+    PERM_MASK_RI = 0x8000,
+    PERM_MASK_UUID_LEN = 0x6000,
+    PERM_MASK_SVC_UUID_LEN = 0x0060,
+
+    PERM_RIGHT_ENABLE = 1,
+    PERM_RIGHT_UUID_128 = 2
+};
+
+#define PERM(access, right)                                                   \
+    (((PERM_RIGHT_ ## right) << (PERM_POS_ ## access)) & (PERM_MASK_ ## access))
+
+enum gattm_msg_id
+{
+    GATTM_ADD_SVC_REQ = TASK_FIRST_MSG(TASK_ID_GATTM),
+    GATTM_ADD_SVC_RSP
+};
+
+enum gattc_msg_id
+{
+    GATTC_CMP_EVT = TASK_FIRST_MSG(TASK_ID_GATTC),
+    GATTC_MTU_CHANGED_IND,
+    GATTC_SEND_EVT_CMD,
+    GATTC_READ_REQ_IND,
+    GATTC_READ_CFM,
+    GATTC_WRITE_REQ_IND,
+    GATTC_WRITE_CFM,
+    GATTC_ATT_INFO_REQ_IND,
+    GATTC_ATT_INFO_CFM
+};
+
+enum gattc_operation
+{
+    GATTC_NOTIFY = 0x12,
+    GATTC_INDICATE
+};
+
+enum gapc_msg_id
+{
+    GAPC_BOND_REQ_IND = TASK_FIRST_MSG(14),
+    GAPC_BOND_IND,
+    GAPC_ENCRYPT_REQ_IND,
+    GAPC_ENCRYPT_IND
+};
+
+typedef struct
+{
+    uint8_t addr[BD_ADDR_LEN];
+} bd_addr_t;
+
+struct gap_bdaddr
+{
+    bd_addr_t addr;
+    uint8_t addr_type;
+};
+
+struct gap_sec_key
+{
+    uint8_t key[GAP_KEY_LEN];
+};
+
+struct rand_nb
+{
+    uint8_t nb[GAP_RAND_NB_LEN];
+};
+
+struct gapc_ltk
+{
+    struct gap_sec_key ltk;
+    uint16_t ediv;
+    struct rand_nb randnb;
+    uint8_t key_size;
+};
+
+struct gapc_irk
+{
+    struct gap_sec_key irk;
+    struct gap_bdaddr addr;
+};
+
+struct gattm_att_desc
+{
+    uint8_t uuid[ATT_UUID_128_LEN];
+    uint16_t perm;
+    uint16_t max_len;
+    uint16_t ext_perm;
+};
+
+struct gattm_svc_desc
+{
+    uint16_t start_hdl;
+    uint16_t task_id;
+    uint8_t perm;
+    uint8_t nb_att;
+    uint8_t uuid[ATT_UUID_128_LEN];
+    struct gattm_att_desc atts[];
+};
+
+struct gattm_add_svc_req
+{
+    struct gattm_svc_desc svc_desc;
+};
+
+struct gattm_add_svc_rsp
+{
+    uint16_t start_hdl;
+    uint8_t status;
+};
+
+struct gattc_cmp_evt
+{
+    uint8_t operation;
+    uint8_t status;
+    uint16_t seq_num;
+};
+
+struct gattc_mtu_changed_ind
+{
+    uint16_t mtu;
+    uint16_t seq_num;
+};
+
+struct gattc_send_evt_cmd
+{
+    uint8_t operation;
+    uint16_t seq_num;
+    uint16_t handle;
+    uint16_t length;
+    uint8_t value[];
+};
+
+struct gattc_read_req_ind
+{
+    uint16_t handle;
+};
+
+struct gattc_read_cfm
+{
+    uint16_t handle;
+    uint16_t length;
+    uint8_t status;
+    uint8_t value[];
+};
+
+struct gattc_write_req_ind
+{
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t length;
+    uint8_t value[];
+};
+
+struct gattc_write_cfm
+{
+    uint16_t handle;
+    uint8_t status;
+};
+
+struct gattc_att_info_cfm
+{
+    uint16_t handle;
+    uint16_t length;
+    uint8_t status;
+};
+
+#endif /* RSL10_BLE_H */
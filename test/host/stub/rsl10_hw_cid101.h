@@ -0,0 +1,23 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Host replacement of the RSL10 SDK header, definitions used by host tests
+// are in rsl10_ble.h.
+//-----------------------------------------------------------------------------
+#ifndef RSL10_HW_CID101_H
+#define RSL10_HW_CID101_H
+
+#include "rsl10_ble.h"
+
+#endif /* RSL10_HW_CID101_H */
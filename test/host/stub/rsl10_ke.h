@@ -0,0 +1,66 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Host replacement of the RSL10 kernel header. Messages are handed to the
+// test through ke_msg_alloc and ke_msg_send implemented by the test.
+//-----------------------------------------------------------------------------
+#ifndef RSL10_KE_H
+#define RSL10_KE_H
+
+#include <stdint.h>
+
+typedef uint16_t ke_task_id_t;
+typedef uint16_t ke_msg_id_t;
+
+typedef int (*ke_msg_func_t)(ke_msg_id_t const msgid, void const *param,
+        ke_task_id_t const dest_id, ke_task_id_t const src_id);
+
+enum KE_MSG_STATUS_TAG
+{
+    KE_MSG_CONSUMED = 0,
+    KE_MSG_NO_FREE,
+    KE_MSG_SAVED
+};
+
+enum KE_TASK_TYPE
+{
+    TASK_ID_GATTM = 11,
+    TASK_ID_GATTC = 12,
+    TASK_ID_APP = 63
+};
+
+#define TASK_FIRST_MSG(task)           ((ke_msg_id_t)((task) << 8))
+#define KE_BUILD_ID(type, index)       ((ke_task_id_t)(((index) << 8) | (type)))
+#define KE_IDX_GET(ke_task_id)         (((ke_task_id) >> 8) & 0xFF)
+
+#define TASK_GATTM                     TASK_ID_GATTM
+#define TASK_GATTC                     TASK_ID_GATTC
+#define TASK_APP                       TASK_ID_APP
+
+extern void *ke_msg_alloc(ke_msg_id_t const id, ke_task_id_t const dest_id,
+        ke_task_id_t const src_id, uint16_t const param_len);
+extern void ke_msg_send(void const *param_ptr);
+extern void ke_timer_set(ke_msg_id_t const timer_id,
+        ke_task_id_t const task, uint32_t const delay);
+extern void ke_timer_clear(ke_msg_id_t const timer_id,
+        ke_task_id_t const task);
+
+#define KE_MSG_ALLOC(id, dest, src, param_str)                                \
+    (struct param_str *)ke_msg_alloc(id, dest, src, sizeof(struct param_str))
+
+#define KE_MSG_ALLOC_DYN(id, dest, src, param_str, length)                    \
+    (struct param_str *)ke_msg_alloc(id, dest, src,                           \
+            sizeof(struct param_str) + (length))
+
+#endif /* RSL10_KE_H */
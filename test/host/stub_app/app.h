@@ -0,0 +1,56 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Host replacement of the application header for app_sched.c. Task entry
+// points are provided by the scheduler benchmark.
+//-----------------------------------------------------------------------------
+#ifndef APP_H_
+#define APP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <HAL_RTC.h>
+
+#include "app_sched.h"
+
+#define BDK_PROF_START(probe)
+#define BDK_PROF_STOP(probe)
+
+#define TRACE_PRINTF(...)
+#define TRACE_FLUSH()                  App_LogFlush()
+
+extern bool CS_IsPollPending(void);
+extern void CS_PollProviders(void);
+extern void Kernel_Schedule(void);
+extern bool BDK_TaskIsSchedulePending(void);
+extern void BDK_TaskRunScheduled(void);
+extern void App_StateMachine(void);
+extern void App_LedUpdate(void);
+extern void App_DiagUpdate(void);
+
+/** \brief Log flush of the benchmark, stands in for BDK_LogFlush. */
+extern void App_LogFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_H_ */
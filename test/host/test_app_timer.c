@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Application timers woken up by late RTC alarms of the simulated RTC. Built
+// once for the RTC counter range and once with APP_TIMER_MAX_TICK_VALUE of
+// the 24-bit TIMER1 counter.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "app_timer.h"
+
+#include "host_test.h"
+#include "sim_clock.h"
+
+#define TEST_TIMERS                    (24)
+
+#define TEST_WAKEUPS                   (100000)
+
+/** Longest interrupt latency injected into RTC alarm wake ups. */
+#define TEST_LATE_MAX                  (HAL_RTC_MS_TO_TICKS(50))
+
+/** Longest slack of test timers. */
+#define TEST_SLACK_MAX_MS              (200)
+
+struct TestTimerModel
+{
+    uint64_t due; /**< True time of expiration */
+    uint64_t slack;
+};
+
+static struct stimer test_timers[TEST_TIMERS];
+static struct TestTimerModel test_model[TEST_TIMERS];
+static uint64_t test_start;
+
+static uint64_t Test_Now(void)
+{
+    return sim_rtc.ticks - test_start;
+}
+
+static void Test_StartTimer(uint64_t *seed, uint32_t k, bool long_only)
+{
+    uint32_t ms;
+    uint32_t slack_ms = (uint32_t)SimRand_Range(seed, 0, TEST_SLACK_MAX_MS);
+
+    /* Mostly short timers, some longer than a quarter of the counter range
+     * so that alarms are capped and the counter wraps between wake ups. */
+    if (long_only == false && SimRand_Range(seed, 0, 9) < 7)
+    {
+        ms = (uint32_t)SimRand_Range(seed, 1, 5000);
+    }
+    else
+    {
+        uint64_t range_ms = ((uint64_t)APP_TIMER_MAX_TICK_VALUE + 1) * 1000U
+                / HAL_RTC_XTAL_FREQ;
+        uint64_t limit = (range_ms > UINT32_MAX / 2) ? UINT32_MAX : 2 * range_ms;
+
+        ms = (uint32_t)SimRand_Range(seed, 1, limit);
+    }
+
+    stimer_set_slack_ms(&test_timers[k], slack_ms);
+    stimer_expire_from_now_ms(&test_timers[k], ms);
+
+    test_model[k].due = Test_Now()
+            + ((uint64_t)ms * 1000000U + APP_TIMER_NS_PER_RTC_TICK - 1)
+            / APP_TIMER_NS_PER_RTC_TICK;
+    test_model[k].slack = ((uint64_t)slack_ms * 1000000U
+            + APP_TIMER_NS_PER_RTC_TICK - 1) / APP_TIMER_NS_PER_RTC_TICK;
+}
+
+static uint32_t Test_RandomLate(uint64_t *seed)
+{
+    switch (SimRand_Range(seed, 0, 3))
+    {
+        case 0:
+            return 0;
+        case 1:
+            return (uint32_t)SimRand_Range(seed, 1, 8);
+        default:
+            return (uint32_t)SimRand_Range(seed, 0, TEST_LATE_MAX);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t seed = HOST_TEST_SEED(argc, argv, 0xa1a);
+    uint64_t max_late = 0;
+    uint32_t expired = 0;
+
+    /* Counter wraps shortly after start. */
+    SimClock_Initialize(&sim_rtc, APP_TIMER_MAX_TICK_VALUE,
+            APP_TIMER_MAX_TICK_VALUE - HAL_RTC_MS_TO_TICKS(100));
+    test_start = sim_rtc.ticks;
+
+    Timer_Initialize();
+    for (uint32_t k = 0; k < TEST_TIMERS; ++k)
+    {
+        stimer_init(&test_timers[k], Timer_GetContext());
+        Test_StartTimer(&seed, k, false);
+    }
+
+    for (uint32_t i = 0; i < TEST_WAKEUPS; ++i)
+    {
+        /* Second half lets the device sleep over several wrap arounds. */
+        bool long_only = (i >= TEST_WAKEUPS / 2);
+        int32_t status = Timer_SetWakeupAtNextEvent();
+
+        HOST_CHECK(status != APP_TIMER_NO_EVENT);
+
+        /* Sleep never spans more than a quarter of the counter range. */
+        if (SimRtc_IsAlarmArmed() == true)
+        {
+            HOST_CHECK(SimRtc_GetAlarm() - sim_rtc.ticks
+                    <= ((uint64_t)APP_TIMER_MAX_TICK_VALUE + 1) / 4);
+        }
+
+        /* Due timer is handled right away without an alarm. */
+        if (SimRtc_FireAlarm(Test_RandomLate(&seed)) == true)
+        {
+            Timer_Wakeup();
+        }
+
+        for (uint32_t k = 0; k < TEST_TIMERS; ++k)
+        {
+            uint64_t now = Test_Now();
+            bool is_expired = stimer_is_expired(&test_timers[k]);
+
+            /* Context time follows RTC across long sleeps. */
+            HOST_CHECK(is_expired == (now >= test_model[k].due));
+
+            if (is_expired == true)
+            {
+                /* Woken up late by at most slack, one tick of alarm rounding
+                 * and interrupt latency. */
+                HOST_CHECK(now - test_model[k].due
+                        <= test_model[k].slack + 1 + TEST_LATE_MAX);
+
+                if (now - test_model[k].due > max_late)
+                {
+                    max_late = now - test_model[k].due;
+                }
+                expired += 1;
+
+                Test_StartTimer(&seed, k, long_only);
+            }
+        }
+    }
+
+    HOST_CHECK(expired > TEST_WAKEUPS / 4);
+    HOST_CHECK(Timer_GetWakeupsAvoided() > 0);
+
+    printf("test_app_timer (max 0x%lX): %s, %lu expirations, "
+            "%lu wake ups avoided, max late %lu ticks (seed %llu)\n",
+            (unsigned long)APP_TIMER_MAX_TICK_VALUE,
+            host_test_failures == 0 ? "passed" : "FAILED",
+            (unsigned long)expired, (unsigned long)Timer_GetWakeupsAvoided(),
+            (unsigned long)max_late, host_test_seed);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,425 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Every attribute handle of the CESLA Custom Service read, written and
+// queried for attribute info through GATTC message handlers of BLE_CCS.c.
+// Expected characteristics are listed here in the order the service exposes
+// them, so that attribute database, user descriptions and handle to index
+// conversion are all checked against the same list.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <BLE_CCS.h>
+
+#include "host_test.h"
+#include "sim_ble.h"
+
+#define TEST_START_HDL                 (0x20)
+
+/** \brief Characteristic as seen by connected device. */
+struct TestChar
+{
+    uint8_t uuid[ATT_UUID_128_LEN];
+    const char *name;
+    bool readable;
+    bool writable;
+    uint16_t max_len;
+};
+
+static const struct TestChar test_chars[CCS_CHAR_NB] = {
+    { CCS_SCP_CHARACTERISTIC_UUID, CCS_SCP_CHARACTERISTIC_NAME,
+      true, true, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_DMIC_CHARACTERISTIC_UUID, CCS_DMIC_CHARACTERISTIC_NAME,
+      true, false, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_LCA_CHARACTERISTIC_UUID, CCS_LCA_CHARACTERISTIC_NAME,
+      true, false, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_RCA_CHARACTERISTIC_UUID, CCS_RCA_CHARACTERISTIC_NAME,
+      true, false, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_LCF_CHARACTERISTIC_UUID, CCS_LCF_CHARACTERISTIC_NAME,
+      true, false, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_RCF_CHARACTERISTIC_UUID, CCS_RCF_CHARACTERISTIC_NAME,
+      true, false, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_ASCP_CHARACTERISTIC_UUID, CCS_ASCP_CHARACTERISTIC_NAME,
+      true, true, CCS_CHARACTERISTIC_VALUE_LENGTH },
+    { CCS_MUX_CHARACTERISTIC_UUID, CCS_MUX_CHARACTERISTIC_NAME,
+      false, false, CCS_MUX_VALUE_MAX_LENGTH },
+    { CCS_DIAG_CHARACTERISTIC_UUID, CCS_DIAG_CHARACTERISTIC_NAME,
+      true, true, CCS_DIAG_VALUE_MAX_LENGTH },
+};
+
+static struct BLE_CCS_RxIndData test_rx;
+static uint32_t test_rx_count;
+
+//-----------------------------------------------------------------------------
+// Test helpers
+//-----------------------------------------------------------------------------
+
+static struct gattc_read_cfm *Test_Read(uint16_t handle)
+{
+    struct gattc_read_req_ind ind = { .handle = handle };
+
+    HOST_CHECK(SimBle_Dispatch(GATTC_READ_REQ_IND, &ind) == 1);
+    HOST_CHECK(sim_ble_sent->id == GATTC_READ_CFM);
+    HOST_CHECK(sim_ble_sent->dest_id == SIM_BLE_GATTC_ID);
+
+    return (struct gattc_read_cfm *)sim_ble_sent->param;
+}
+
+static uint8_t Test_Write(uint16_t handle, uint16_t offset,
+        const uint8_t *value, uint16_t length)
+{
+    struct gattc_write_req_ind *ind = malloc(sizeof(*ind) + length);
+    struct gattc_write_cfm *cfm;
+
+    ind->handle = handle;
+    ind->offset = offset;
+    ind->length = length;
+    memcpy(ind->value, value, length);
+
+    HOST_CHECK(SimBle_Dispatch(GATTC_WRITE_REQ_IND, ind) == 1);
+    HOST_CHECK(sim_ble_sent->id == GATTC_WRITE_CFM);
+    free(ind);
+
+    cfm = (struct gattc_write_cfm *)sim_ble_sent->param;
+    HOST_CHECK(cfm->handle == handle);
+
+    return cfm->status;
+}
+
+static bool Test_ReadEquals(uint16_t handle, const void *value,
+        uint16_t length)
+{
+    struct gattc_read_cfm *cfm = Test_Read(handle);
+
+    return cfm->handle == handle && cfm->status == GAP_ERR_NO_ERROR
+            && cfm->length == length && memcmp(cfm->value, value, length) == 0;
+}
+
+static void Test_RxInd(struct BLE_CCS_RxIndData *ind)
+{
+    test_rx = *ind;
+    test_rx_count += 1;
+}
+
+/** DIAG value of every page is the page number repeated page + 1 times. */
+static uint8_t Test_DiagRead(uint8_t page, uint8_t *value)
+{
+    memset(value, page, page + 1);
+
+    return page + 1;
+}
+
+//-----------------------------------------------------------------------------
+// Tests
+//-----------------------------------------------------------------------------
+
+static void Test_ServiceAdd(void)
+{
+    const uint8_t char_uuid[2] = { 0x03, 0x28 };
+    const uint8_t ccc_uuid[2] = { 0x02, 0x29 };
+    const uint8_t dscp_uuid[2] = { 0x01, 0x29 };
+    struct gattm_add_svc_req *req;
+    struct gattm_add_svc_rsp rsp = { TEST_START_HDL, GAP_ERR_NO_ERROR };
+
+    sim_ble_svc_add();
+
+    HOST_CHECK(sim_ble_sent->id == GATTM_ADD_SVC_REQ);
+    req = (struct gattm_add_svc_req *)sim_ble_sent->param;
+    HOST_CHECK(req->svc_desc.nb_att == CCS_IDX_NB);
+
+    for (uint32_t att = 0; att < CCS_IDX_NB; ++att)
+    {
+        const struct TestChar *ch = &test_chars[att / CCS_ATT_PER_CHAR];
+        const struct gattm_att_desc *desc = &req->svc_desc.atts[att];
+
+        switch (att % CCS_ATT_PER_CHAR)
+        {
+        case CCS_ATT_CHAR:
+            HOST_CHECK(memcmp(desc->uuid, char_uuid, 2) == 0);
+            break;
+
+        case CCS_ATT_VAL:
+            HOST_CHECK(memcmp(desc->uuid, ch->uuid, ATT_UUID_128_LEN) == 0);
+            HOST_CHECK(desc->max_len == ch->max_len);
+            HOST_CHECK(((desc->perm & PERM(RD, ENABLE)) != 0) == ch->readable);
+            HOST_CHECK(((desc->perm & PERM(WRITE_REQ, ENABLE)) != 0)
+                    == ch->writable);
+            break;
+
+        case CCS_ATT_CCC:
+            HOST_CHECK(memcmp(desc->uuid, ccc_uuid, 2) == 0);
+            break;
+
+        default:
+            HOST_CHECK(memcmp(desc->uuid, dscp_uuid, 2) == 0);
+            HOST_CHECK(desc->max_len == strlen(ch->name));
+            break;
+        }
+    }
+
+    HOST_CHECK(SimBle_Dispatch(GATTM_ADD_SVC_RSP, &rsp) == 0);
+    sim_ble_svc_enable(SIM_BLE_CONIDX);
+}
+
+/** Notifications leave on the value handle of the characteristic and are
+ * returned by later reads. */
+static void Test_Notify(void)
+{
+    uint8_t data[CCS_CHARACTERISTIC_VALUE_LENGTH];
+    static uint8_t stream[CCS_CHARACTERISTIC_VALUE_LENGTH];
+    uint32_t ntf_count;
+
+    for (uint32_t k = 0; k < CCS_CHAR_NB; ++k)
+    {
+        uint32_t idx = k * CCS_ATT_PER_CHAR + CCS_ATT_VAL;
+        uint32_t sent = sim_ble_sent_count;
+        struct gattc_send_evt_cmd *cmd;
+
+        memset(data, 0xA0 + k, sizeof(data));
+        BLE_CCS_Notify(data, k + 1, idx);
+
+        /* MUX is not subscribed by default. */
+        if (idx == CCS_IDX_MUX_VALUE_VAL)
+        {
+            HOST_CHECK(sim_ble_sent_count == sent);
+            continue;
+        }
+
+        HOST_CHECK(sim_ble_sent_count == sent + 1);
+        HOST_CHECK(sim_ble_sent->id == GATTC_SEND_EVT_CMD);
+        cmd = (struct gattc_send_evt_cmd *)sim_ble_sent->param;
+        HOST_CHECK(cmd->handle == TEST_START_HDL + 1 + idx);
+        HOST_CHECK(cmd->length == k + 1);
+        HOST_CHECK(memcmp(cmd->value, data, k + 1) == 0);
+    }
+
+    /* Stream packet is read from the buffer of its provider. */
+    memset(stream, 0x5A, sizeof(stream));
+    HOST_CHECK(BLE_CCS_NotifyStream(stream, 7, CCS_IDX_LCA_VALUE_VAL)
+            == BLE_CCS_STATUS_OK);
+    stream[0] = 0x5B;
+    HOST_CHECK(Test_ReadEquals(TEST_START_HDL + 1 + CCS_IDX_LCA_VALUE_VAL,
+            stream, 7));
+
+    /* Packet sent over LECB is read the same way. */
+    ntf_count = sim_ble_sent_count;
+    BLE_CCS_SetStreamValue(stream, 5, CCS_IDX_LCA_VALUE_VAL);
+    HOST_CHECK(sim_ble_sent_count == ntf_count);
+    HOST_CHECK(Test_ReadEquals(TEST_START_HDL + 1 + CCS_IDX_LCA_VALUE_VAL,
+            stream, 5));
+
+    HOST_CHECK(BLE_CCS_Notify(data, 0, CCS_IDX_LCA_VALUE_VAL)
+            == BLE_CCS_STATUS_LENGTH);
+    HOST_CHECK(BLE_CCS_MuxWrite(0x02, data, 7)
+            == BLE_CCS_STATUS_NO_CLIENT);
+}
+
+static void Test_ReadAll(void)
+{
+    static const uint16_t ntf = ATT_CCC_START_NTF;
+    static const uint16_t off = 0;
+
+    for (uint16_t h = TEST_START_HDL - 1; h <= TEST_START_HDL + CCS_IDX_NB + 1;
+            ++h)
+    {
+        uint32_t att = h - TEST_START_HDL - 1;
+        const struct TestChar *ch = &test_chars[att / CCS_ATT_PER_CHAR];
+        uint8_t expected[CCS_CHARACTERISTIC_VALUE_LENGTH];
+        struct gattc_read_cfm *cfm;
+
+        if (h <= TEST_START_HDL || h > TEST_START_HDL + CCS_IDX_NB)
+        {
+            cfm = Test_Read(h);
+            HOST_CHECK(cfm->status == ATT_ERR_INVALID_HANDLE);
+            HOST_CHECK(cfm->length == 0);
+            continue;
+        }
+
+        switch (att % CCS_ATT_PER_CHAR)
+        {
+        case CCS_ATT_VAL:
+            if (att == CCS_IDX_DIAG_VALUE_VAL)
+            {
+                memset(expected, 0, 1);
+                HOST_CHECK(Test_ReadEquals(h, expected, 1));
+            }
+            else if (att == CCS_IDX_LCA_VALUE_VAL)
+            {
+                /* Read from stream buffer by Test_Notify */
+            }
+            else if (ch->readable == true)
+            {
+                memset(expected, 0xA0 + att / CCS_ATT_PER_CHAR,
+                        sizeof(expected));
+                HOST_CHECK(Test_ReadEquals(h, expected,
+                        att / CCS_ATT_PER_CHAR + 1));
+            }
+            else
+            {
+                cfm = Test_Read(h);
+                HOST_CHECK(cfm->status == ATT_ERR_READ_NOT_PERMITTED);
+            }
+            break;
+
+        case CCS_ATT_CCC:
+            HOST_CHECK(Test_ReadEquals(h, (att == CCS_IDX_MUX_VALUE_CCC)
+                    ? &off : &ntf, 2));
+            break;
+
+        case CCS_ATT_USR_DSCP:
+            HOST_CHECK(Test_ReadEquals(h, ch->name, strlen(ch->name)));
+            break;
+
+        default:
+            cfm = Test_Read(h);
+            HOST_CHECK(cfm->status == ATT_ERR_READ_NOT_PERMITTED);
+            HOST_CHECK(cfm->length == 0);
+            break;
+        }
+    }
+}
+
+static void Test_WriteAll(void)
+{
+    uint8_t data[CCS_CHARACTERISTIC_VALUE_LENGTH + 1];
+
+    for (uint16_t h = TEST_START_HDL - 1; h <= TEST_START_HDL + CCS_IDX_NB + 1;
+            ++h)
+    {
+        uint32_t att = h - TEST_START_HDL - 1;
+        const struct TestChar *ch = &test_chars[att / CCS_ATT_PER_CHAR];
+        uint16_t cccd;
+
+        memset(data, h, sizeof(data));
+
+        if (h <= TEST_START_HDL || h > TEST_START_HDL + CCS_IDX_NB)
+        {
+            HOST_CHECK(Test_Write(h, 0, data, 2) == ATT_ERR_INVALID_HANDLE);
+            continue;
+        }
+
+        HOST_CHECK(Test_Write(h, 1, data, 1) == ATT_ERR_INVALID_OFFSET);
+
+        switch (att % CCS_ATT_PER_CHAR)
+        {
+        case CCS_ATT_VAL:
+            if (ch->writable == false)
+            {
+                HOST_CHECK(Test_Write(h, 0, data, 1)
+                        == ATT_ERR_WRITE_NOT_PERMITTED);
+            }
+            else if (att == CCS_IDX_DIAG_VALUE_VAL)
+            {
+                HOST_CHECK(Test_Write(h, 0, data, 2)
+                        == ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN);
+                /* Page 3 is value 3, 3, 3, 3 */
+                data[0] = 3;
+                HOST_CHECK(Test_Write(h, 0, data, 1) == GAP_ERR_NO_ERROR);
+                memset(data, 3, 4);
+                HOST_CHECK(Test_ReadEquals(h, data, 4));
+            }
+            else
+            {
+                uint32_t rx_count = test_rx_count;
+
+                HOST_CHECK(Test_Write(h, 0, data, sizeof(data))
+                        == ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN);
+                HOST_CHECK(Test_Write(h, 0, data, sizeof(data) - 1)
+                        == GAP_ERR_NO_ERROR);
+                HOST_CHECK(Test_ReadEquals(h, data, sizeof(data) - 1));
+
+                /* Only writes of SCP are passed to application. */
+                if (att == CCS_IDX_SCP_VALUE_VAL)
+                {
+                    HOST_CHECK(test_rx_count == rx_count + 1);
+                    HOST_CHECK(test_rx.data_len == sizeof(data) - 1);
+                    HOST_CHECK(memcmp(test_rx.data, data, sizeof(data) - 1)
+                            == 0);
+                }
+                else
+                {
+                    HOST_CHECK(test_rx_count == rx_count);
+                }
+            }
+            break;
+
+        case CCS_ATT_CCC:
+            HOST_CHECK(Test_Write(h, 0, data, 1)
+                    == ATT_ERR_INVALID_ATTRIBUTE_VAL_LEN);
+            HOST_CHECK(Test_Write(h, 0, data, 2) == GAP_ERR_NO_ERROR);
+            HOST_CHECK(Test_ReadEquals(h, data, 2));
+            cccd = ATT_CCC_START_NTF;
+            HOST_CHECK(Test_Write(h, 0, (uint8_t *)&cccd, 2)
+                    == GAP_ERR_NO_ERROR);
+            break;
+
+        default:
+            HOST_CHECK(Test_Write(h, 0, data, 1)
+                    == ATT_ERR_WRITE_NOT_PERMITTED);
+            break;
+        }
+    }
+}
+
+static void Test_AttInfoAll(void)
+{
+    for (uint16_t h = TEST_START_HDL - 1; h <= TEST_START_HDL + CCS_IDX_NB + 1;
+            ++h)
+    {
+        uint32_t att = h - TEST_START_HDL - 1;
+        struct gattc_read_req_ind ind = { .handle = h };
+        struct gattc_att_info_cfm *cfm;
+        bool writable = h > TEST_START_HDL && h <= TEST_START_HDL + CCS_IDX_NB
+                && att % CCS_ATT_PER_CHAR == CCS_ATT_VAL
+                && test_chars[att / CCS_ATT_PER_CHAR].writable == true;
+
+        /* Info is only requested for values written by Prepare Write. */
+        if (writable == false)
+        {
+            HOST_CHECK(SimBle_Dispatch(GATTC_ATT_INFO_REQ_IND, &ind) == 0);
+            continue;
+        }
+
+        HOST_CHECK(SimBle_Dispatch(GATTC_ATT_INFO_REQ_IND, &ind) == 1);
+        HOST_CHECK(sim_ble_sent->id == GATTC_ATT_INFO_CFM);
+        cfm = (struct gattc_att_info_cfm *)sim_ble_sent->param;
+        HOST_CHECK(cfm->handle == h);
+        HOST_CHECK(cfm->length == CCS_CHARACTERISTIC_VALUE_LENGTH);
+        HOST_CHECK(cfm->status == GAP_ERR_NO_ERROR);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BLE_CCS_Initialize(&Test_RxInd);
+    BLE_CCS_SetDiagHandler(&Test_DiagRead);
+
+    HOST_CHECK(sim_ble_svc_add != NULL && sim_ble_svc_enable != NULL);
+
+    Test_ServiceAdd();
+    Test_Notify();
+    Test_ReadAll();
+    Test_WriteAll();
+    Test_AttInfoAll();
+
+    printf("test_ble_ccs: %s, %u attributes at handles 0x%X to 0x%X\n",
+            host_test_failures == 0 ? "passed" : "FAILED",
+            (unsigned int)CCS_IDX_NB, TEST_START_HDL + 1,
+            TEST_START_HDL + CCS_IDX_NB);
+
+    return HOST_TEST_RESULT();
+}
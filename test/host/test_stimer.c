@@ -0,0 +1,254 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Semiconductor Components Industries LLC
+// (d/b/a "ON Semiconductor").  All rights reserved.
+// This software and/or documentation is licensed by ON Semiconductor under
+// limited terms and conditions.  The terms and conditions pertaining to the
+// software and/or documentation are available at
+// http://www.onsemi.com/site/pdf/ONSEMI_T&C.pdf ("ON Semiconductor Standard
+// Terms and Conditions of Sale, Section 8 Software") and if applicable the
+// software license agreement.  Do not use this software and/or documentation
+// unless you have carefully read and you agree to the limited terms and
+// conditions.  By using this software and/or documentation, you agree to the
+// limited terms and conditions.
+//-----------------------------------------------------------------------------
+//
+// Randomized wrap around tests of stimer against a model kept in true time of
+// the simulated clock.
+//-----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <stimer.h>
+#include <HAL_RTC.h>
+#include <SoftwareTimer.h>
+
+#include "host_test.h"
+#include "sim_clock.h"
+
+/** More timers than the deadline heap holds, so overflow is exercised. */
+#define TEST_TIMERS                    (STIMER_HEAP_SIZE + 24)
+
+#define TEST_STEPS                     (200000)
+
+struct TestTimerModel
+{
+    uint64_t start; /**< True time the timer started measuring from */
+    uint64_t interval;
+    uint64_t elapsed; /**< Elapsed time frozen by stimer_stop */
+    bool running;
+};
+
+/** Counter ranges of time sources the firmware uses, plus one that is not a
+ * power of two and takes the slow path of timer math. */
+static const uint32_t test_max_values[] = {
+    HAL_RTC_MAX_TICK_VALUE,
+    SW_TIMER_TIM1_MAX_TICKS,
+    999999
+};
+
+/** Longest jump between two reads of the time source allowed by stimer. */
+static uint64_t Test_MaxJump(uint32_t max_value)
+{
+    return ((uint64_t)max_value + 1) / 4;
+}
+
+static uint64_t Test_RandomJump(uint64_t *seed, uint32_t max_value)
+{
+    switch (SimRand_Range(seed, 0, 3))
+    {
+        case 0:
+            return 0;
+        case 1:
+            return SimRand_Range(seed, 1, 16);
+        case 2:
+            return SimRand_Range(seed, 1, Test_MaxJump(max_value) / 1024);
+        default:
+            return SimRand_Range(seed, 1, Test_MaxJump(max_value));
+    }
+}
+
+/** Context time follows true time across wrap arounds of the counter. */
+static void Test_ContextTime(uint64_t *seed, uint32_t max_value)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    uint64_t start;
+
+    /* Counter wraps right after the context is initialized. */
+    SimClock_Initialize(&clk, max_value, max_value - 100);
+    start = clk.ticks;
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime, max_value, 1000);
+
+    for (uint32_t i = 0; i < TEST_STEPS; ++i)
+    {
+        SimClock_Advance(&clk, Test_RandomJump(seed, max_value));
+        stimer_execute_context(&ctx);
+
+        HOST_CHECK(ctx.now == clk.ticks - start);
+    }
+}
+
+static uint64_t Test_ModelElapsed(const struct TestTimerModel *m,
+        uint64_t now)
+{
+    return (m->running == true) ? now - m->start : m->elapsed;
+}
+
+/** Expiration and next expiry reported by stimer match the model while timers
+ * are randomly started, stopped and advanced. */
+static void Test_Expiry(uint64_t *seed, uint32_t max_value)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    struct stimer ts[TEST_TIMERS];
+    struct TestTimerModel model[TEST_TIMERS] = { { 0 } };
+    uint64_t start;
+
+    SimClock_Initialize(&clk, max_value,
+            (uint32_t)SimRand_Range(seed, 0, max_value));
+    start = clk.ticks;
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime, max_value, 1000);
+
+    for (uint32_t k = 0; k < TEST_TIMERS; ++k)
+    {
+        stimer_init(&ts[k], &ctx);
+    }
+
+    for (uint32_t i = 0; i < TEST_STEPS; ++i)
+    {
+        uint32_t k = (uint32_t)SimRand_Range(seed, 0, TEST_TIMERS - 1);
+        struct TestTimerModel *m = &model[k];
+        uint64_t now = clk.ticks - start;
+        uint64_t action = SimRand_Range(seed, 0, 99);
+
+        if (action < 30)
+        {
+            /* Intervals span several wrap arounds of the counter. */
+            m->interval = SimRand_Range(seed, 1, 8 * (uint64_t)max_value);
+            m->start = now;
+            m->running = true;
+            stimer_expire_from_now_counts(&ts[k], m->interval);
+        }
+        else if (action < 35)
+        {
+            if (m->running == true)
+            {
+                m->elapsed = now - m->start;
+                m->running = false;
+            }
+            stimer_stop(&ts[k]);
+        }
+        else if (action < 40)
+        {
+            if (m->running == true)
+            {
+                if (now - m->start >= m->interval)
+                {
+                    m->start += m->interval;
+                }
+                else
+                {
+                    m->start = now;
+                }
+            }
+            stimer_advance(&ts[k]);
+        }
+        else
+        {
+            SimClock_Advance(&clk, Test_RandomJump(seed, max_value));
+        }
+
+        /* Next expiry is the earliest deadline of running timers. */
+        uint64_t counts = 0;
+        struct stimer *next = stimer_get_next_expiry(&ctx, &counts);
+        bool any = false;
+        uint64_t min_remaining = UINT64_MAX;
+
+        now = clk.ticks - start;
+        for (uint32_t j = 0; j < TEST_TIMERS; ++j)
+        {
+            if (model[j].running == true && model[j].interval != 0)
+            {
+                uint64_t elapsed = now - model[j].start;
+                uint64_t remaining = (elapsed >= model[j].interval) ? 0
+                        : model[j].interval - elapsed;
+
+                any = true;
+                if (remaining < min_remaining)
+                {
+                    min_remaining = remaining;
+                }
+            }
+        }
+
+        HOST_CHECK((next != NULL) == any);
+        if (next != NULL && any == true)
+        {
+            const struct TestTimerModel *n = &model[next - ts];
+            uint64_t elapsed = now - n->start;
+
+            HOST_CHECK(counts == min_remaining);
+            HOST_CHECK(n->running == true);
+            HOST_CHECK((elapsed >= n->interval ? 0 : n->interval - elapsed)
+                    == min_remaining);
+        }
+
+        /* Timer expires exactly at its deadline, never early or late. */
+        for (uint32_t j = 0; j < TEST_TIMERS; ++j)
+        {
+            HOST_CHECK(stimer_is_expired(&ts[j])
+                    == (Test_ModelElapsed(&model[j], now) >= model[j].interval));
+        }
+    }
+
+    for (uint32_t k = 0; k < TEST_TIMERS; ++k)
+    {
+        stimer_remove(&ts[k]);
+    }
+    HOST_CHECK(ctx.root == NULL);
+    HOST_CHECK(ctx.heap_size == 0 && ctx.heap_overflow == 0);
+}
+
+/** Expiration set in time units is rounded up to whole ticks. */
+static void Test_Conversion(uint64_t *seed)
+{
+    struct SimClock clk;
+    struct stimer_ctx ctx;
+    struct stimer ts;
+
+    SimClock_Initialize(&clk, HAL_RTC_MAX_TICK_VALUE, UINT32_MAX - 5);
+    stimer_init_context(&ctx, &clk, &SimClock_GetTime,
+            HAL_RTC_MAX_TICK_VALUE, 1000000000U / HAL_RTC_XTAL_FREQ);
+    stimer_init(&ts, &ctx);
+
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        uint32_t us = (uint32_t)SimRand_Range(seed, 1, 10000000);
+        uint64_t ticks = ((uint64_t)us * 1000U + ctx.ns_per_count - 1)
+                / ctx.ns_per_count;
+
+        stimer_expire_from_now_us(&ts, us);
+        SimClock_Advance(&clk, ticks - 1);
+        HOST_CHECK(stimer_is_expired(&ts) == false);
+        SimClock_Advance(&clk, 1);
+        HOST_CHECK(stimer_is_expired(&ts) == true);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t seed = HOST_TEST_SEED(argc, argv, 0x5eed);
+
+    for (uint32_t i = 0; i < sizeof(test_max_values) / sizeof(uint32_t); ++i)
+    {
+        Test_ContextTime(&seed, test_max_values[i]);
+        Test_Expiry(&seed, test_max_values[i]);
+    }
+    Test_Conversion(&seed);
+
+    printf("test_stimer: %s (seed %llu)\n",
+            host_test_failures == 0 ? "passed" : "FAILED", host_test_seed);
+
+    return HOST_TEST_RESULT();
+}
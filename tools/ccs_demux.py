@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Demultiplexer for CESLA stream frames.
+
+Both the STREAM_MUX characteristic notifications and the L2CAP LE credit
+based channel SDUs use the same layout:
+
+    [SEQ (1 byte)] { [provider ID (1 byte)][length (1 byte)][packet] } ...
+
+The packet has the same format as the per-provider characteristic
+notifications.
+
+Usage as library:
+
+    demux = Demux(on_packet=lambda pid, packet: ...)
+    demux.feed(notification_value)
+
+Usage from command line:
+
+    ccs_demux.py decode HEX [HEX ...]   decode hex encoded notifications
+    ccs_demux.py efficiency [--mtu N]   estimate over the air efficiency
+"""
+
+import argparse
+import sys
+
+PROVIDER_NAMES = {
+    0x01: "DMIC",
+    0x02: "LCA",
+    0x04: "RCA",
+    0x08: "LCF",
+    0x10: "RCF",
+    0x80: "SYS",
+}
+
+HEADER_LENGTH = 1
+FRAME_HEADER_LENGTH = 2
+
+
+class FormatError(ValueError):
+    pass
+
+
+class Demux:
+    """Splits MUX notifications / LECB SDUs into provider packets."""
+
+    def __init__(self, on_packet=None):
+        self.on_packet = on_packet
+        self.expected_seq = None
+        self.lost_frames = 0
+        self.frames = 0
+        self.packets = {}
+
+    def feed(self, data):
+        """Processes one notification value or SDU.
+
+        Returns list of (provider_id, packet) tuples contained in it.
+        """
+        data = bytes(data)
+        if len(data) < HEADER_LENGTH:
+            raise FormatError("frame shorter than header")
+
+        seq = data[0]
+        if self.expected_seq is not None and seq != self.expected_seq:
+            self.lost_frames += (seq - self.expected_seq) & 0xFF
+        self.expected_seq = (seq + 1) & 0xFF
+        self.frames += 1
+
+        packets = []
+        pos = HEADER_LENGTH
+        while pos < len(data):
+            if pos + FRAME_HEADER_LENGTH > len(data):
+                raise FormatError("truncated frame header at %d" % pos)
+            pid = data[pos]
+            length = data[pos + 1]
+            start = pos + FRAME_HEADER_LENGTH
+            if start + length > len(data):
+                raise FormatError("truncated packet at %d" % pos)
+            packet = data[start:start + length]
+            packets.append((pid, packet))
+            self.packets[pid] = self.packets.get(pid, 0) + 1
+            if self.on_packet is not None:
+                self.on_packet(pid, packet)
+            pos = start + length
+        return packets
+
+
+def provider_name(pid):
+    return PROVIDER_NAMES.get(pid, "0x%02X" % pid)
+
+
+# Over the air overhead per LL data PDU: preamble 1, access address 4,
+# LL header 2, MIC 4 (encrypted link), CRC 3 -> 14 bytes.
+# L2CAP header 4 + ATT notification header 3 -> 7 bytes.
+LL_OVERHEAD = 14
+L2CAP_ATT_OVERHEAD = 7
+LL_MAX_PAYLOAD = 251
+
+
+def air_bytes(att_value_length):
+    """Bytes on air to send one notification with given value length."""
+    l2cap_length = att_value_length + L2CAP_ATT_OVERHEAD
+    pdus = -(-l2cap_length // LL_MAX_PAYLOAD)
+    return l2cap_length + pdus * LL_OVERHEAD
+
+
+def efficiency(mtu, packet_length=20):
+    """Returns (per-characteristic, MUX) payload efficiency."""
+    per_char = packet_length / air_bytes(packet_length)
+
+    value_max = min(mtu - 3, 244)
+    frames = (value_max - HEADER_LENGTH) // (FRAME_HEADER_LENGTH + packet_length)
+    mux_value = HEADER_LENGTH + frames * (FRAME_HEADER_LENGTH + packet_length)
+    mux = frames * packet_length / air_bytes(mux_value)
+    return per_char, mux, frames
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p_decode = sub.add_parser("decode", help="decode hex encoded frames")
+    p_decode.add_argument("frames", nargs="+")
+
+    p_eff = sub.add_parser("efficiency", help="estimate payload efficiency")
+    p_eff.add_argument("--mtu", type=int, default=247)
+    p_eff.add_argument("--packet", type=int, default=20)
+
+    args = parser.parse_args(argv)
+
+    if args.cmd == "decode":
+        demux = Demux()
+        for frame in args.frames:
+            for pid, packet in demux.feed(bytes.fromhex(frame)):
+                print("%-4s %s" % (provider_name(pid), packet.hex()))
+        print("frames: %d, lost: %d" % (demux.frames, demux.lost_frames))
+    else:
+        per_char, mux, frames = efficiency(args.mtu, args.packet)
+        print("per-characteristic: %.1f %%" % (per_char * 100))
+        print("MUX (MTU %d, %d packets per notification): %.1f %%"
+              % (args.mtu, frames, mux * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
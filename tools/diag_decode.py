@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""Decodes counter pages of the DIAG characteristic.
+
+Page is selected by writing its number into the characteristic, following
+reads return hex encoded value that is passed to this tool:
+
+* page 0x00 - system and link counters
+* page 0x01 - audio stream counters
+* page 0x02 - energy accounting
+* page 0x03 - main loop task overruns
+
+Profile pages 0x10 and above are rendered by prof_render.py.
+
+Usage:
+
+    diag_decode.py 0102...
+    diag_decode.py --page 1 --json 0102...
+    diag_decode.py --page 2 0106...
+    diag_decode.py --page 3 0204...
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# APP_DIAG_COUNTERS_VERSION
+VERSION = 2
+
+PROVIDER_NAMES = {
+    0x01: "DMIC",
+    0x02: "LCA",
+    0x04: "RCA",
+}
+
+PHY_NAMES = {
+    0x01: "1M",
+    0x02: "2M",
+    0x04: "Coded",
+}
+
+SYSTEM = struct.Struct("<BBIIIIIIHIBI")
+SYSTEM_FIELDS = (
+    "version", "connections", "uptime_s", "wdt_refreshes", "wakeups",
+    "sleep_entries", "sleep_refused", "sleep_ms", "log_high_water",
+    "log_dropped", "lecb_pending_max", "lecb_dropped")
+
+LINK = struct.Struct("<HHHBBHBI")
+LINK_FIELDS = (
+    "interval", "latency", "sup_to", "tx_phy", "rx_phy", "mtu",
+    "ccs_pending_max", "ccs_dropped")
+
+# Order of enum App_StateStruct in app.h.
+APP_STATE_NAMES = [
+    "INIT",
+    "START_ADVERTISING",
+    "ADVERTISING",
+    "SLEEP",
+    "START_CONNECTION",
+    "CONNECTED",
+]
+
+# Order of enum App_PowerState in app_energy.h.
+POWER_STATE_NAMES = ["run", "wfi", "sleep"]
+
+# Bits of ACS_WAKEUP_STATE WAKEUP_SRC_BYTE.
+WAKEUP_SRC_NAMES = [
+    "WAKEUP_PAD", "RTC_ALARM", "BB_TIMER", "DCDC_OVERLOAD",
+    "DIO0", "DIO1", "DIO2", "DIO3",
+]
+
+ENERGY = struct.Struct("<BBBI8II")
+
+# Order of enum App_SchedTask in app_sched.h.
+SCHED_TASK_NAMES = ["audio", "ble", "control", "log"]
+
+SCHED_TASK = struct.Struct("<II")
+
+# RTC ticks per second.
+RTC_FREQ = 32768
+
+STREAM = struct.Struct("<BIIIII")
+STREAM_FIELDS = ("provider", "samples", "overruns", "sent", "dropped",
+                 "failed")
+
+
+def decode_system(data):
+    page = dict(zip(SYSTEM_FIELDS, SYSTEM.unpack_from(data)))
+    page["links"] = []
+    for offset in range(SYSTEM.size, len(data) - LINK.size + 1, LINK.size):
+        link = dict(zip(LINK_FIELDS, LINK.unpack_from(data, offset)))
+        page["links"].append(link if link["interval"] else None)
+    return page
+
+
+def decode_streams(data):
+    page = {"version": data[0], "streams": []}
+    for i in range(data[1]):
+        page["streams"].append(dict(zip(
+            STREAM_FIELDS, STREAM.unpack_from(data, 2 + i * STREAM.size))))
+    return page
+
+
+def decode_energy(data):
+    fields = ENERGY.unpack_from(data)
+    page = {"version": fields[0], "average_current_na": fields[3],
+            "wakeups": dict(zip(WAKEUP_SRC_NAMES, fields[4:12])),
+            "wakeups_avoided": fields[12], "residency_ms": {}}
+    states, powers = fields[1], fields[2]
+    residency = struct.unpack_from("<%dI" % (states * powers), data,
+                                   ENERGY.size)
+    for state in range(states):
+        name = (APP_STATE_NAMES[state] if state < len(APP_STATE_NAMES)
+                else str(state))
+        page["residency_ms"][name] = dict(zip(
+            POWER_STATE_NAMES, residency[state * powers:(state + 1) * powers]))
+    return page
+
+
+def decode_sched(data):
+    page = {"version": data[0], "tasks": {}}
+    for task in range(data[1]):
+        name = (SCHED_TASK_NAMES[task] if task < len(SCHED_TASK_NAMES)
+                else str(task))
+        overruns, max_ticks = SCHED_TASK.unpack_from(
+            data, 2 + task * SCHED_TASK.size)
+        page["tasks"][name] = {"overruns": overruns, "max_ticks": max_ticks}
+    return page
+
+
+def sched_length(data):
+    return 2 + data[1] * SCHED_TASK.size if len(data) >= 2 else None
+
+
+def energy_length(data):
+    return ENERGY.size + 4 * data[1] * data[2] if len(data) >= 3 else None
+
+
+def print_system(page, out):
+    awake = page["uptime_s"] * 1000 - page["sleep_ms"]
+    sleep_pct = (100.0 * page["sleep_ms"] / (page["uptime_s"] * 1000)
+                 if page["uptime_s"] else 0)
+    out.write("uptime %d s, %d connection(s), watchdog refreshes %d\n"
+              % (page["uptime_s"], page["connections"],
+                 page["wdt_refreshes"]))
+    out.write("deep sleep: %d entries, %d refused, %d wakeups, %d ms"
+              " (%.1f %%), awake %d ms\n"
+              % (page["sleep_entries"], page["sleep_refused"],
+                 page["wakeups"], page["sleep_ms"], sleep_pct, awake))
+    out.write("log ring: high water %d words, %d records dropped\n"
+              % (page["log_high_water"], page["log_dropped"]))
+    out.write("LE CoC: pending max %d, frames dropped %d\n"
+              % (page["lecb_pending_max"], page["lecb_dropped"]))
+    for slot, link in enumerate(page["links"]):
+        if link is None:
+            out.write("slot %d: free\n" % slot)
+            continue
+        out.write("slot %d: interval %.2f ms, latency %d, timeout %d ms,"
+                  " PHY %s/%s, MTU %d, pending max %d, dropped %d\n"
+                  % (slot, link["interval"] * 1.25, link["latency"],
+                     link["sup_to"] * 10,
+                     PHY_NAMES.get(link["tx_phy"], link["tx_phy"]),
+                     PHY_NAMES.get(link["rx_phy"], link["rx_phy"]),
+                     link["mtu"], link["ccs_pending_max"],
+                     link["ccs_dropped"]))
+
+
+def print_streams(page, out):
+    for stream in page["streams"]:
+        out.write("%-4s samples %d, overruns %d, sent %d, dropped %d,"
+                  " failed %d\n"
+                  % (PROVIDER_NAMES.get(stream["provider"],
+                                        "0x%02X" % stream["provider"]),
+                     stream["samples"], stream["overruns"], stream["sent"],
+                     stream["dropped"], stream["failed"]))
+
+
+def print_energy(page, out):
+    out.write("average current %.2f uA\n" % (page["average_current_na"]
+                                              / 1000.0))
+    out.write("wake ups: %s\n" % ", ".join(
+        "%s %d" % item for item in page["wakeups"].items() if item[1]))
+    out.write("wake ups avoided by timer slack: %d\n"
+              % page["wakeups_avoided"])
+    total = sum(sum(p.values()) for p in page["residency_ms"].values())
+    out.write("%-18s %12s %12s %12s %7s\n"
+              % ("state", "run ms", "wfi ms", "sleep ms", "share"))
+    for name, power in page["residency_ms"].items():
+        state_total = sum(power.values())
+        out.write("%-18s %12d %12d %12d %6.1f%%\n"
+                  % (name, power.get("run", 0), power.get("wfi", 0),
+                     power.get("sleep", 0),
+                     100.0 * state_total / total if total else 0))
+
+
+def print_sched(page, out):
+    out.write("%-10s %10s %10s %10s\n"
+              % ("task", "overruns", "max ticks", "max us"))
+    for name, task in page["tasks"].items():
+        out.write("%-10s %10d %10d %10d\n"
+                  % (name, task["overruns"], task["max_ticks"],
+                     task["max_ticks"] * 1000000 // RTC_FREQ))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("value", help="hex encoded DIAG page value")
+    parser.add_argument("--page", type=lambda x: int(x, 0), choices=(0, 1, 2, 3),
+                        help="page number, guessed from length if omitted")
+    parser.add_argument("--json", action="store_true",
+                        help="print decoded counters as JSON")
+    args = parser.parse_args(argv)
+
+    data = bytes.fromhex(args.value)
+    if not data or data[0] != VERSION:
+        sys.stderr.write("unsupported page version\n")
+        return 1
+
+    page_number = args.page
+    if page_number is None:
+        # Lengths of stream and energy pages are given by their counts.
+        if len(data) == 2 + data[1] * STREAM.size:
+            page_number = 1
+        elif len(data) == energy_length(data):
+            page_number = 2
+        elif len(data) == sched_length(data):
+            page_number = 3
+        else:
+            page_number = 0
+
+    if page_number == 1 and len(data) >= 2 + data[1] * STREAM.size:
+        page, printer = decode_streams(data), print_streams
+    elif page_number == 2 and energy_length(data) is not None \
+            and len(data) >= energy_length(data):
+        page, printer = decode_energy(data), print_energy
+    elif page_number == 3 and len(data) >= sched_length(data):
+        page, printer = decode_sched(data), print_sched
+    elif page_number == 0 and len(data) >= SYSTEM.size:
+        page, printer = decode_system(data), print_system
+    else:
+        sys.stderr.write("value is too short\n")
+        return 1
+
+    if args.json:
+        json.dump(page, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+    else:
+        printer(page, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Renders BDK_Prof cycle histograms.
+
+Statistics can be taken from two sources:
+
+* Trace output decoded by tlog_decode.py. With RTE_BDK_PROF_ENABLED the
+  firmware periodically prints lines
+
+      PROF <probe> n=<count> min=<cycles> max=<cycles> mean=<cycles>
+      PROF <probe> h<first bin> <count> <count> <count> <count>
+
+  The last report of every probe is rendered.
+
+* Hex encoded values of DIAG characteristic pages 0x10 + probe index:
+
+      [probe][bins][count][min][max][mean][hist 0] ... [hist bins-1]
+
+Bin i counts durations in range <2^i, 2^(i+1)) cycles, the last bin also all
+longer durations.
+
+Usage:
+
+    tlog_decode.py fw.elf capture.bin | prof_render.py [--sysclk HZ]
+    prof_render.py --hex 001000... [--hex ...] [--sysclk HZ]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+# Order of enum BDK_ProfProbe in BDK_Prof.h.
+PROBE_NAMES = [
+    "ADC_IRQ",
+    "DMIC_DMA_IRQ",
+    "PACK_AUDIO",
+    "CCS_NOTIFY",
+    "KERNEL_SCHEDULE",
+    "TIMER_WAKEUP",
+]
+
+SUMMARY = re.compile(
+    r"PROF (\S+) n=(\d+) min=(\d+) max=(\d+) mean=(\d+)")
+HIST = re.compile(r"PROF (\S+) h(\d+)((?: \d+)+)")
+
+# BDK_PROF_HIST_BINS
+HIST_BINS = 16
+
+BAR_WIDTH = 40
+
+
+class Probe:
+    def __init__(self, name):
+        self.name = name
+        self.count = 0
+        self.min = 0
+        self.max = 0
+        self.mean = 0
+        self.hist = []
+
+    def set_bin(self, index, value):
+        if len(self.hist) <= index:
+            self.hist.extend([0] * (index + 1 - len(self.hist)))
+        self.hist[index] = value
+
+
+def parse_trace(lines):
+    """Returns probes of the last report found in trace output."""
+    probes = {}
+    for line in lines:
+        match = SUMMARY.search(line)
+        if match:
+            probe = Probe(match.group(1))
+            probe.hist = [0] * HIST_BINS
+            (probe.count, probe.min, probe.max,
+             probe.mean) = map(int, match.groups()[1:])
+            probes[probe.name] = probe
+            continue
+
+        match = HIST.search(line)
+        if match and match.group(1) in probes:
+            probe = probes[match.group(1)]
+            first = int(match.group(2))
+            for i, value in enumerate(match.group(3).split()):
+                probe.set_bin(first + i, int(value))
+    return list(probes.values())
+
+
+def parse_page(data):
+    """Decodes one DIAG profile page."""
+    index, bins = data[0], data[1]
+    name = PROBE_NAMES[index] if index < len(PROBE_NAMES) else str(index)
+    probe = Probe(name)
+    probe.count, probe.min, probe.max, probe.mean = struct.unpack_from(
+        "<4I", data, 2)
+    probe.hist = list(struct.unpack_from("<%dH" % bins, data, 18))
+    return probe
+
+
+def bin_range(index, last):
+    low = 0 if index == 0 else 1 << index
+    return "%6d+" % low if last else "%6d-%-6d" % (low, (2 << index) - 1)
+
+
+def render(probe, sysclk, out):
+    us = 1e6 / sysclk
+    out.write("%s: n=%d min=%d max=%d mean=%d cycles"
+              " (%.1f / %.1f / %.1f us)\n"
+              % (probe.name, probe.count, probe.min, probe.max, probe.mean,
+                 probe.min * us, probe.max * us, probe.mean * us))
+
+    peak = max(probe.hist) if probe.hist else 0
+    if peak == 0:
+        out.write("\n")
+        return
+
+    used = [i for i, v in enumerate(probe.hist) if v]
+    for i in range(used[0], used[-1] + 1):
+        value = probe.hist[i]
+        bar = "#" * int(round(BAR_WIDTH * value / peak))
+        out.write("  %-13s %-*s %d\n"
+                  % (bin_range(i, i == len(probe.hist) - 1), BAR_WIDTH, bar,
+                     value))
+    out.write("\n")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("trace", nargs="?", default="-",
+                        help="decoded trace output, '-' for stdin")
+    parser.add_argument("--hex", action="append", default=[],
+                        help="hex encoded DIAG profile page")
+    parser.add_argument("--sysclk", type=float, default=8e6,
+                        help="core clock in Hz used to convert cycles")
+    args = parser.parse_args(argv)
+
+    if args.hex:
+        probes = [parse_page(bytes.fromhex(h)) for h in args.hex]
+    elif args.trace == "-":
+        probes = parse_trace(sys.stdin)
+    else:
+        with open(args.trace) as f:
+            probes = parse_trace(f)
+
+    for probe in probes:
+        render(probe, args.sysclk, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
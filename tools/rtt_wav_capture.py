@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Converts RTT stream capture into WAV files.
+
+With RTE_APP_CCS_RTT_ENABLED the firmware writes every stream packet into
+SEGGER RTT up channel 2 (RTE_APP_CCS_RTT_CHANNEL) as frame:
+
+    [0xC5][provider ID][SEQ][LEN] [packet (LEN bytes)]
+
+SEQ is incremented per provider, also for frames dropped by the firmware when
+the RTT buffer was full. Packets contain little endian 16-bit samples.
+
+The channel can be recorded for example with:
+
+    JLinkRTTLogger -Device RSL10 -If SWD -Speed 4000 -RTTChannel 2 capture.bin
+
+Providers are grouped by sample rate and every group is written as one
+multichannel WAV file, channels ordered by provider ID. Lost packets are
+replaced by silence so that channels stay aligned.
+
+Usage:
+
+    rtt_wav_capture.py capture.bin --rate LCA=25000 --rate RCA=25000 \\
+        --rate DMIC=16000 [--debug] [--output prefix]
+    rtt_wav_capture.py capture.bin --stats
+"""
+
+import argparse
+import struct
+import sys
+import wave
+
+PROVIDER_NAMES = {
+    0x01: "DMIC",
+    0x02: "LCA",
+    0x04: "RCA",
+    0x08: "LCF",
+    0x10: "RCF",
+    0x80: "SYS",
+}
+PROVIDER_IDS = {name: pid for pid, name in PROVIDER_NAMES.items()}
+
+SYNC = 0xC5
+HEADER_LENGTH = 4
+SAMPLE_WIDTH = 2
+
+
+def provider_name(pid):
+    return PROVIDER_NAMES.get(pid, "0x%02X" % pid)
+
+
+class Stream:
+    """Samples and loss statistics of one provider."""
+
+    def __init__(self):
+        self.samples = []
+        self.packets = 0
+        self.lost = 0
+        self.last_seq = None
+
+    def add(self, seq, samples):
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) & 0xFF
+            if gap:
+                self.lost += gap
+                self.samples.extend([0] * (gap * len(samples)))
+        self.last_seq = seq
+        self.packets += 1
+        self.samples.extend(samples)
+
+
+def parse(data, debug=False):
+    """Splits capture into per provider streams.
+
+    Returns (streams, resyncs) tuple.
+    """
+    streams = {}
+    resyncs = 0
+    pos = 0
+
+    while pos + HEADER_LENGTH <= len(data):
+        sync, pid, seq, length = data[pos:pos + HEADER_LENGTH]
+        if (sync != SYNC or pid not in PROVIDER_NAMES or length % SAMPLE_WIDTH
+                or pos + HEADER_LENGTH + length > len(data)):
+            pos += 1
+            resyncs += 1
+            continue
+
+        packet = data[pos + HEADER_LENGTH:pos + HEADER_LENGTH + length]
+        pos += HEADER_LENGTH + length
+
+        samples = list(struct.unpack("<%dh" % (length // SAMPLE_WIDTH),
+                                     packet))
+        # Debug mode packets start with 16-bit time stamp.
+        if debug:
+            samples = samples[1:]
+        streams.setdefault(pid, Stream()).add(seq, samples)
+
+    return streams, resyncs
+
+
+def write_wav(path, rate, channels):
+    """Writes list of equally long sample lists as multichannel WAV."""
+    frames = min(len(c) for c in channels)
+    interleaved = [c[i] for i in range(frames) for c in channels]
+
+    with wave.open(path, "wb") as w:
+        w.setnchannels(len(channels))
+        w.setsampwidth(SAMPLE_WIDTH)
+        w.setframerate(rate)
+        w.writeframes(struct.pack("<%dh" % len(interleaved), *interleaved))
+    return frames
+
+
+def parse_rate(text):
+    name, _, rate = text.rpartition("=")
+    if name.upper() not in PROVIDER_IDS:
+        raise argparse.ArgumentTypeError("unknown provider %r" % name)
+    return PROVIDER_IDS[name.upper()], int(rate)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="binary RTT capture, '-' for stdin")
+    parser.add_argument("--rate", type=parse_rate, action="append",
+                        default=[], metavar="PROVIDER=HZ",
+                        help="sample rate of provider, e.g. LCA=25000")
+    parser.add_argument("--debug", action="store_true",
+                        help="packets contain time stamp (DEBUG op code)")
+    parser.add_argument("--output", default="capture",
+                        help="output file prefix")
+    parser.add_argument("--stats", action="store_true",
+                        help="only print per provider statistics")
+    args = parser.parse_args(argv)
+
+    if args.capture == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+
+    streams, resyncs = parse(data, args.debug)
+    for pid, stream in sorted(streams.items()):
+        print("%-4s packets: %d, lost: %d, samples: %d"
+              % (provider_name(pid), stream.packets, stream.lost,
+                 len(stream.samples)))
+    if resyncs:
+        print("skipped %d bytes while searching for frame start" % resyncs)
+    if args.stats:
+        return 0
+
+    rates = dict(args.rate)
+    groups = {}
+    for pid in sorted(streams):
+        if pid not in rates:
+            print("%s skipped, sample rate not given" % provider_name(pid))
+            continue
+        groups.setdefault(rates[pid], []).append(pid)
+
+    for rate, pids in sorted(groups.items()):
+        path = "%s_%s_%dHz.wav" % (
+            args.output, "_".join(provider_name(p) for p in pids), rate)
+        frames = write_wav(path, rate, [streams[p].samples for p in pids])
+        print("%s: %d channels, %.3f s" % (path, len(pids), frames / rate))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
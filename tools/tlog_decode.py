@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""Decoder for tokenized BDK_Log records.
+
+The firmware stores only format string ID and raw 32-bit arguments of each
+TRACE_PRINTF / CS log message. Records are little endian 32-bit words:
+
+    [0xA5][NARGS][ID (16 bit)] [ARG 0] ... [ARG NARGS-1]
+
+ID is the offset of the format string in the bdk_log_fmt section of the
+firmware ELF file. %s arguments are addresses of strings that are looked up
+in the loadable sections of the same ELF file.
+
+Floating point and 64-bit conversions cannot be carried in a single word and
+are rejected by the firmware build. Formats that still contain them are
+reported by --list and decoded as <unsupported ...> markers.
+
+Usage:
+
+    tlog_decode.py firmware.elf capture.bin     decode captured binary log
+    tlog_decode.py firmware.elf -               decode binary log from stdin
+    tlog_decode.py firmware.elf --list          list all format strings
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FMT_SECTION = "bdk_log_fmt"
+HDR_MARKER = 0xA5
+ID_DROPPED = 0xFFFF
+MAX_ARGS = 8
+
+# Conversion specification of printf format.
+CONVERSION = re.compile(
+    r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcspfeEgG%])")
+
+# Conversions that need more than one 32-bit argument word.
+UNSUPPORTED_CONVERSIONS = "feEgG"
+UNSUPPORTED_LENGTHS = ("ll", "j")
+
+
+def unsupported(match):
+    """Returns true if conversion cannot be carried in one 32-bit word."""
+    return (match.group(5) in UNSUPPORTED_CONVERSIONS
+            or match.group(4) in UNSUPPORTED_LENGTHS)
+
+
+def check_format(fmt):
+    """Returns list of conversions of format that cannot be decoded."""
+    return [m.group(0) for m in CONVERSION.finditer(fmt) if unsupported(m)]
+
+
+class Elf:
+    """Minimal 32-bit little endian ELF reader."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("%s is not 32-bit ELF file" % path)
+
+        (shoff,) = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data,
+                                                        0x2E)
+        headers = [struct.unpack_from("<IIIIIIIIII", self.data,
+                                      shoff + i * shentsize)
+                   for i in range(shnum)]
+        strtab = headers[shstrndx][4]
+
+        self.sections = {}
+        for name, type_, flags, addr, offset, size, *_ in headers:
+            name = self._cstring(strtab + name)
+            # SHT_NOBITS sections have no content in the file.
+            content = b"" if type_ == 8 else self.data[offset:offset + size]
+            self.sections[name] = (addr, flags, content)
+
+    def _cstring(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("latin-1")
+
+    def section(self, name):
+        return self.sections[name]
+
+    def string_at(self, address):
+        """Returns string located at given address in allocated section."""
+        for addr, flags, content in self.sections.values():
+            # SHF_ALLOC
+            if flags & 0x2 and addr <= address < addr + len(content):
+                start = address - addr
+                end = content.find(b"\0", start)
+                if end < 0:
+                    end = len(content)
+                return content[start:end].decode("latin-1")
+        return "<0x%08X>" % address
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_message(elf, fmt, args):
+    """Formats message the same way printf would on the target."""
+    args = list(args)
+
+    def replace(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if unsupported(match):
+            return "<unsupported %s>" % match.group(0)
+        if width == "*":
+            width = str(to_signed(args.pop(0))) if args else ""
+        if not args:
+            return match.group(0)
+        value = args.pop(0)
+
+        if conv == "s":
+            value = elf.string_at(value)
+        elif conv in "di":
+            value = to_signed(value)
+        elif conv == "c":
+            value = chr(value & 0xFF)
+            conv = "s"
+        elif conv == "p":
+            conv = "x"
+            flags += "#"
+        elif conv == "u":
+            conv = "d"
+
+        spec = "%" + flags + (width or "")
+        if precision is not None:
+            spec += "." + precision
+        return (spec + conv) % value
+
+    return CONVERSION.sub(replace, fmt)
+
+
+class Decoder:
+    """Splits binary stream into records and re-inflates messages."""
+
+    def __init__(self, elf):
+        self.elf = elf
+        _, _, self.formats = elf.section(FMT_SECTION)
+        self.buffer = b""
+        self.dropped = 0
+        self.resyncs = 0
+
+    def format_string(self, fmt_id):
+        end = self.formats.find(b"\0", fmt_id)
+        if fmt_id >= len(self.formats) or end < 0:
+            return None
+        return self.formats[fmt_id:end].decode("latin-1")
+
+    def feed(self, data):
+        """Returns list of decoded messages contained in data."""
+        self.buffer += data
+        messages = []
+
+        while len(self.buffer) >= 4:
+            (header,) = struct.unpack_from("<I", self.buffer)
+            nargs = (header >> 16) & 0xFF
+            fmt_id = header & 0xFFFF
+            fmt = self.format_string(fmt_id)
+
+            if (header >> 24 != HDR_MARKER or nargs > MAX_ARGS
+                    or (fmt is None and fmt_id != ID_DROPPED)):
+                # Capture started in the middle of a record.
+                self.buffer = self.buffer[1:]
+                self.resyncs += 1
+                continue
+
+            length = 4 * (nargs + 1)
+            if len(self.buffer) < length:
+                break
+            args = struct.unpack_from("<%dI" % nargs, self.buffer, 4)
+            self.buffer = self.buffer[length:]
+
+            if fmt_id == ID_DROPPED:
+                self.dropped += args[0]
+                messages.append("<%u log records dropped>\r\n" % args[0])
+            else:
+                messages.append(format_message(self.elf, fmt, args))
+
+        return messages
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF file")
+    parser.add_argument("capture", nargs="?", default="-",
+                        help="binary log capture, '-' for stdin")
+    parser.add_argument("--list", action="store_true",
+                        help="list format strings and their IDs")
+    args = parser.parse_args(argv)
+
+    decoder = Decoder(Elf(args.elf))
+
+    if args.list:
+        offset = 0
+        status = 0
+        while offset < len(decoder.formats):
+            fmt = decoder.format_string(offset)
+            # Empty strings are alignment padding between format strings.
+            if fmt:
+                print("%5d %r" % (offset, fmt))
+                bad = check_format(fmt)
+                if bad:
+                    sys.stderr.write("%d: unsupported conversion %s\n"
+                                     % (offset, ", ".join(bad)))
+                    status = 1
+            offset += len(fmt) + 1
+        return status
+
+    stream = (sys.stdin.buffer if args.capture == "-"
+              else open(args.capture, "rb"))
+    with stream:
+        while True:
+            data = stream.read1(4096) if hasattr(stream, "read1") \
+                else stream.read(4096)
+            if not data:
+                break
+            for message in decoder.feed(data):
+                sys.stdout.write(message)
+            sys.stdout.flush()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())